@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "encode.hpp"
+#include "decode.hpp"
+#include "encoder_context.hpp"
+#include "decoder_context.hpp"
+#include "octet_encoder.hpp"
+#include "octet_decoder.hpp"
+#include "thread_arena.hpp"
+#include "arena.hpp"
+#include "pmr.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+template <typename ...T> using O = med::optional<T...>;
+template <uint8_t TAG> using T = med::value<med::fixed<TAG, uint8_t>>;
+
+struct BYTE : med::value<uint8_t>{};
+struct WORD : med::value<uint16_t>{};
+
+//repeated IEs beyond inline storage are allocated
+struct MSG : med::sequence<
+	M< T<0xF1>, BYTE, med::inf >,
+	O< T<0xF2>, WORD, med::inf >
+>{};
+
+constexpr uint8_t encoded[] = {
+	0xF1, 0x01, 0xF1, 0x02, 0xF1, 0x03, 0xF1, 0x04,
+	0xF1, 0x05, 0xF1, 0x06, 0xF1, 0x07, 0xF1, 0x08,
+	0xF2, 0x12, 0x34, 0xF2, 0x56, 0x78, 0xF2, 0x9A, 0xBC,
+};
+
+//hand-managed buffer per thread
+void BM_decode_allocator(benchmark::State& state)
+{
+	uint8_t mem[1024];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> ctx{ encoded, &alloc };
+	std::size_t dummy = 0;
+
+	for (auto _ : state)
+	{
+		alloc.release();
+		ctx.reset(encoded, sizeof(encoded));
+		MSG msg;
+		decode(med::octet_decoder{ctx}, msg);
+		dummy += msg.count<BYTE>();
+		benchmark::DoNotOptimize(dummy);
+	}
+}
+BENCHMARK(BM_decode_allocator)->ThreadRange(1, 4)->UseRealTime();
+
+void BM_decode_thread_arena(benchmark::State& state)
+{
+	auto& arena = med::thread_arena::local();
+	med::decoder_context<med::thread_arena> ctx{ encoded, &arena };
+	std::size_t dummy = 0;
+
+	for (auto _ : state)
+	{
+		med::thread_arena::scope scope{arena};
+		ctx.reset(encoded, sizeof(encoded));
+		MSG msg;
+		decode(med::octet_decoder{ctx}, msg);
+		dummy += msg.count<BYTE>();
+		benchmark::DoNotOptimize(dummy);
+	}
+	state.counters["alloc_per_msg"] = benchmark::Counter(double(arena.high_water_mark()), benchmark::Counter::kAvgThreads);
+}
+BENCHMARK(BM_decode_thread_arena)->ThreadRange(1, 4)->UseRealTime();
+
+//growing from upstream when the initial buffer is exhausted
+void BM_decode_chained_arena(benchmark::State& state)
+{
+	uint8_t mem[1024];
+	med::arena arena{mem, std::size_t(state.range(0))};
+	med::decoder_context<med::arena> ctx{ encoded, &arena };
+	std::size_t dummy = 0;
+
+	for (auto _ : state)
+	{
+		arena.release();
+		ctx.reset(encoded, sizeof(encoded));
+		MSG msg;
+		decode(med::octet_decoder{ctx}, msg);
+		dummy += msg.count<BYTE>();
+		benchmark::DoNotOptimize(dummy);
+	}
+}
+//initial buffer fits all or the most of allocations are from upstream
+BENCHMARK(BM_decode_chained_arena)->Arg(1024)->Arg(32);
+
+template <class RESOURCE>
+void decode_pmr(benchmark::State& state, RESOURCE& res)
+{
+	med::pmr_allocator alloc{&res};
+	med::decoder_context<med::pmr_allocator> ctx{ encoded, &alloc };
+	std::size_t dummy = 0;
+
+	for (auto _ : state)
+	{
+		res.release();
+		ctx.reset(encoded, sizeof(encoded));
+		MSG msg;
+		decode(med::octet_decoder{ctx}, msg);
+		dummy += msg.count<BYTE>();
+		benchmark::DoNotOptimize(dummy);
+	}
+}
+
+void BM_decode_pmr_pool(benchmark::State& state)
+{
+	std::pmr::unsynchronized_pool_resource pool;
+	decode_pmr(state, pool);
+}
+BENCHMARK(BM_decode_pmr_pool);
+
+void BM_decode_pmr_monotonic(benchmark::State& state)
+{
+	uint8_t mem[1024];
+	std::pmr::monotonic_buffer_resource mono{mem, sizeof(mem)};
+	decode_pmr(state, mono);
+}
+BENCHMARK(BM_decode_pmr_monotonic);
+
+} //end: namespace
@@ -0,0 +1,110 @@
+#include <benchmark/benchmark.h>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "encode.hpp"
+#include "decode.hpp"
+#include "encoder_context.hpp"
+#include "decoder_context.hpp"
+#include "asn/asn.hpp"
+#include "asn/ber/ber_encoder.hpp"
+#include "asn/ber/ber_decoder.hpp"
+#include "asn/per/per_encoder.hpp"
+#include "asn/per/per_decoder.hpp"
+#include "asn/oer/oer_encoder.hpp"
+#include "asn/oer/oer_decoder.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+template <typename ...T> using O = med::optional<T...>;
+
+struct moct : med::asn::octet_string_t<med::asn::traits<0, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+struct ooct : med::asn::octet_string_t<med::asn::traits<1, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+struct mint : med::asn::value_t<int, med::asn::traits<2, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+struct oint : med::asn::value_t<int, med::asn::traits<3, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+struct cint : med::asn::ranged_t<0, 4095, med::asn::traits<4, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+
+struct SEQ : med::asn::sequence<
+	M<moct>,
+	O<ooct>,
+	M<mint>,
+	O<oint>,
+	M<cint>
+>
+{};
+
+void fill(SEQ& seq)
+{
+	static uint8_t const moct_val[] = {0x12, 0x34};
+	static uint8_t const ooct_val[] = {0x45, 0x67, 0x89};
+	seq.ref<moct>().set(sizeof(moct_val), moct_val);
+	seq.ref<ooct>().set(sizeof(ooct_val), ooct_val);
+	seq.ref<mint>().set(7);
+	seq.ref<oint>().set(987654321);
+	seq.ref<cint>().set(1234);
+}
+
+template <class ENCODER>
+void encode_seq(benchmark::State& state)
+{
+	SEQ seq;
+	fill(seq);
+	uint8_t buffer[128];
+	med::encoder_context<> ctx{ buffer };
+
+	while (state.KeepRunning())
+	{
+		ctx.reset();
+		encode(ENCODER{ctx}, seq);
+		benchmark::DoNotOptimize(buffer);
+	}
+	state.SetBytesProcessed(state.iterations() * ctx.buffer().get_offset());
+}
+
+template <class ENCODER, class DECODER>
+void decode_seq(benchmark::State& state)
+{
+	SEQ seq;
+	fill(seq);
+	uint8_t encoded[128];
+	med::encoder_context<> ectx{ encoded };
+	encode(ENCODER{ectx}, seq);
+	auto const len = ectx.buffer().get_offset();
+
+	med::decoder_context<> ctx;
+	std::size_t dummy = 0;
+	while (state.KeepRunning())
+	{
+		ctx.reset(encoded, len);
+		seq.clear();
+		decode(DECODER{ctx}, seq);
+		dummy += seq.get<mint>().get();
+		benchmark::DoNotOptimize(dummy);
+	}
+	state.SetBytesProcessed(state.iterations() * len);
+}
+
+using ber_enc = med::asn::ber::encoder<med::encoder_context<>>;
+using ber_dec = med::asn::ber::decoder<med::decoder_context<>>;
+using per_enc = med::asn::per::encoder<med::encoder_context<>>;
+using per_dec = med::asn::per::decoder<med::decoder_context<>>;
+using oer_enc = med::asn::oer::encoder<med::encoder_context<>>;
+using oer_dec = med::asn::oer::decoder<med::decoder_context<>>;
+
+void BM_asn_ber_encode(benchmark::State& state) { encode_seq<ber_enc>(state); }
+BENCHMARK(BM_asn_ber_encode);
+void BM_asn_per_encode(benchmark::State& state) { encode_seq<per_enc>(state); }
+BENCHMARK(BM_asn_per_encode);
+void BM_asn_oer_encode(benchmark::State& state) { encode_seq<oer_enc>(state); }
+BENCHMARK(BM_asn_oer_encode);
+
+void BM_asn_ber_decode(benchmark::State& state) { decode_seq<ber_enc, ber_dec>(state); }
+BENCHMARK(BM_asn_ber_decode);
+void BM_asn_per_decode(benchmark::State& state) { decode_seq<per_enc, per_dec>(state); }
+BENCHMARK(BM_asn_per_decode);
+void BM_asn_oer_decode(benchmark::State& state) { decode_seq<oer_enc, oer_dec>(state); }
+BENCHMARK(BM_asn_oer_decode);
+
+} //end: namespace
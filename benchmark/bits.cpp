@@ -0,0 +1,153 @@
+#include <benchmark/benchmark.h>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "encode.hpp"
+#include "decode.hpp"
+#include "encoder_context.hpp"
+#include "decoder_context.hpp"
+#include "octet_encoder.hpp"
+#include "octet_decoder.hpp"
+#include "bit_encoder.hpp"
+#include "bit_decoder.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+
+//12 sub-octet fields packed into 64 bits
+constexpr std::size_t WIDTHS[] = {3, 5, 4, 4, 6, 7, 3, 12, 2, 9, 5, 4};
+constexpr uint16_t VALUES[] = {5, 17, 9, 3, 42, 100, 6, 3000, 2, 300, 21, 11};
+
+//bit codec packs back to back
+template <std::size_t I>
+struct BF : med::value<med::bits<WIDTHS[I]>> {};
+
+//octet codec needs the offset within octet of each field
+template <std::size_t I, std::size_t OFS>
+struct OF : med::value<med::bits<WIDTHS[I], OFS>> {};
+
+template <template <std::size_t...> class, class> struct seq_of;
+template <template <std::size_t...> class F, std::size_t... I>
+struct seq_of<F, std::index_sequence<I...>> : med::sequence< M<F<I>>... > {};
+
+struct BIT_SEQ : seq_of<BF, std::make_index_sequence<std::size(WIDTHS)>> {};
+
+struct OCT_SEQ : med::sequence<
+	M<OF<0, 0>>, M<OF<1, 3>>,
+	M<OF<2, 0>>, M<OF<3, 4>>,
+	M<OF<4, 0>>, M<OF<5, 6>>, M<OF<6, 5>>,
+	M<OF<7, 0>>, M<OF<8, 4>>, M<OF<9, 6>>, M<OF<10, 7>>, M<OF<11, 4>>
+>
+{};
+
+struct filler
+{
+	template <class IE, class SEQ>
+	static void apply(SEQ& seq)
+	{
+		using ies = typename SEQ::ies_types;
+		seq.template ref<med::get_field_type_t<IE>>().set(VALUES[med::meta::list_index_of_v<IE, ies>]);
+	}
+};
+
+template <class SEQ>
+void fill(SEQ& seq)
+{
+	med::meta::foreach<typename SEQ::ies_types>(filler{}, seq);
+}
+
+template <class SEQ, class ENCODER>
+void encode_seq(benchmark::State& state)
+{
+	SEQ seq;
+	fill(seq);
+	uint8_t buffer[64];
+	med::encoder_context<> ctx{ buffer };
+
+	while (state.KeepRunning())
+	{
+		ctx.reset();
+		encode(ENCODER{ctx}, seq);
+		benchmark::DoNotOptimize(buffer);
+	}
+	state.SetBytesProcessed(state.iterations() * ctx.buffer().get_offset());
+}
+
+template <class SEQ, class ENCODER, class DECODER>
+void decode_seq(benchmark::State& state)
+{
+	SEQ seq;
+	fill(seq);
+	uint8_t encoded[64];
+	med::encoder_context<> ectx{ encoded };
+	encode(ENCODER{ectx}, seq);
+	auto const len = ectx.buffer().get_offset();
+
+	med::decoder_context<> ctx;
+	std::size_t dummy = 0;
+	while (state.KeepRunning())
+	{
+		ctx.reset(encoded, len);
+		decode(DECODER{ctx}, seq);
+		dummy += seq.template get<med::get_field_type_t<med::meta::list_first_t<typename SEQ::ies_types>>>().get();
+		benchmark::DoNotOptimize(dummy);
+	}
+	state.SetBytesProcessed(state.iterations() * len);
+}
+
+using bit_enc = med::bit_encoder<med::encoder_context<>>;
+using bit_dec = med::bit_decoder<med::decoder_context<>>;
+using oct_enc = med::octet_encoder<med::encoder_context<>>;
+using oct_dec = med::octet_decoder<med::decoder_context<>>;
+
+void BM_bits_codec_encode(benchmark::State& state)   { encode_seq<BIT_SEQ, bit_enc>(state); }
+BENCHMARK(BM_bits_codec_encode);
+void BM_bits_octet_encode(benchmark::State& state)   { encode_seq<OCT_SEQ, oct_enc>(state); }
+BENCHMARK(BM_bits_octet_encode);
+void BM_bits_codec_decode(benchmark::State& state)   { decode_seq<BIT_SEQ, bit_enc, bit_dec>(state); }
+BENCHMARK(BM_bits_codec_decode);
+void BM_bits_octet_decode(benchmark::State& state)   { decode_seq<OCT_SEQ, oct_enc, oct_dec>(state); }
+BENCHMARK(BM_bits_octet_decode);
+
+//raw cursor w/o codec
+void BM_bits_cursor_put(benchmark::State& state)
+{
+	uint8_t buffer[64];
+	med::buffer<uint8_t> buf;
+	while (state.KeepRunning())
+	{
+		buf.reset(buffer);
+		med::bit_writer writer{buf};
+		[&]<std::size_t... I>(std::index_sequence<I...>)
+		{
+			(writer.put<void>(VALUES[I], WIDTHS[I]), ...);
+		}(std::make_index_sequence<std::size(WIDTHS)>{});
+		writer.align();
+		benchmark::DoNotOptimize(buffer);
+	}
+	state.SetBytesProcessed(state.iterations() * buf.get_offset());
+}
+BENCHMARK(BM_bits_cursor_put);
+
+void BM_bits_cursor_get(benchmark::State& state)
+{
+	uint8_t buffer[64] = {0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55};
+	med::buffer<uint8_t const> buf;
+	std::size_t dummy = 0;
+	while (state.KeepRunning())
+	{
+		buf.reset(buffer, 8);
+		med::bit_reader reader{buf};
+		[&]<std::size_t... I>(std::index_sequence<I...>)
+		{
+			((dummy += reader.get<void>(WIDTHS[I])), ...);
+		}(std::make_index_sequence<std::size(WIDTHS)>{});
+		benchmark::DoNotOptimize(dummy);
+	}
+	state.SetBytesProcessed(state.iterations() * 8);
+}
+BENCHMARK(BM_bits_cursor_get);
+
+} //end: namespace
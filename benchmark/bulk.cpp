@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "encode.hpp"
+#include "decode.hpp"
+#include "encoder_context.hpp"
+#include "decoder_context.hpp"
+#include "octet_encoder.hpp"
+#include "octet_decoder.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+
+struct COUNT : med::value<uint16_t>{};
+struct TEID : med::value<uint32_t>{};
+
+template <std::size_t N>
+struct TEIDS : med::sequence<
+	M< med::counter_t<COUNT>, TEID, med::pmax<N> >
+>{};
+
+template <std::size_t N>
+std::vector<uint8_t> make_encoded()
+{
+	std::vector<uint8_t> buf(2 + 4*N);
+	buf[0] = uint8_t(N >> 8);
+	buf[1] = uint8_t(N);
+	for (std::size_t i = 0; i < N; ++i) { buf[2 + 4*i + 3] = uint8_t(i); }
+	return buf;
+}
+
+//bulk path: bounds are checked once for all values
+template <std::size_t N, bool BULK>
+void decode_teids(benchmark::State& state)
+{
+	auto const encoded = make_encoded<N>();
+	auto mem = std::make_unique<uint8_t[]>(N * 32);
+	med::allocator alloc{mem.get(), N * 32};
+	auto msg = std::make_unique<TEIDS<N>>();
+	std::size_t dummy = 0;
+
+	for (auto _ : state)
+	{
+		alloc.release();
+		msg->clear();
+		med::decoder_context<med::allocator> ctx{encoded.data(), encoded.size(), &alloc};
+		med::octet_decoder decoder{ctx};
+		if constexpr (BULK)
+		{
+			decode(decoder, *msg);
+		}
+		else //baseline: value by value as done w/o bulk decoder
+		{
+			COUNT count;
+			decode(decoder, count);
+			auto& teids = msg->template ref<TEID>();
+			teids.reserve(count.get(), decoder);
+			for (std::size_t i = count.get(); i; --i) { decode(decoder, *teids.push_back(decoder)); }
+		}
+		dummy += msg->template get<TEID>().last()->get();
+		benchmark::DoNotOptimize(dummy);
+	}
+	state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <std::size_t N, bool BULK>
+void encode_teids(benchmark::State& state)
+{
+	auto const encoded = make_encoded<N>();
+	auto mem = std::make_unique<uint8_t[]>(N * 32);
+	med::allocator alloc{mem.get(), N * 32};
+	auto msg = std::make_unique<TEIDS<N>>();
+	med::decoder_context<med::allocator> dctx{encoded.data(), encoded.size(), &alloc};
+	decode(med::octet_decoder{dctx}, *msg);
+	std::vector<uint8_t> buffer(encoded.size());
+
+	for (auto _ : state)
+	{
+		med::encoder_context<> ctx{buffer.data(), buffer.size()};
+		med::octet_encoder encoder{ctx};
+		if constexpr (BULK)
+		{
+			encode(encoder, *msg);
+		}
+		else //baseline: value by value as done w/o bulk encoder
+		{
+			auto const& teids = msg->template get<TEID>();
+			COUNT count;
+			count.set(uint16_t(teids.count()));
+			encode(encoder, count);
+			for (auto const& teid : teids) { encode(encoder, teid); }
+		}
+		benchmark::DoNotOptimize(buffer.data());
+	}
+	state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <std::size_t N> void BM_decode_teids_bulk(benchmark::State& state) { decode_teids<N, true>(state); }
+template <std::size_t N> void BM_decode_teids_each(benchmark::State& state) { decode_teids<N, false>(state); }
+template <std::size_t N> void BM_encode_teids_bulk(benchmark::State& state) { encode_teids<N, true>(state); }
+template <std::size_t N> void BM_encode_teids_each(benchmark::State& state) { encode_teids<N, false>(state); }
+
+BENCHMARK_TEMPLATE(BM_decode_teids_bulk, 16);
+BENCHMARK_TEMPLATE(BM_decode_teids_each, 16);
+BENCHMARK_TEMPLATE(BM_decode_teids_bulk, 256);
+BENCHMARK_TEMPLATE(BM_decode_teids_each, 256);
+BENCHMARK_TEMPLATE(BM_decode_teids_bulk, 4096);
+BENCHMARK_TEMPLATE(BM_decode_teids_each, 4096);
+BENCHMARK_TEMPLATE(BM_encode_teids_bulk, 16);
+BENCHMARK_TEMPLATE(BM_encode_teids_each, 16);
+BENCHMARK_TEMPLATE(BM_encode_teids_bulk, 256);
+BENCHMARK_TEMPLATE(BM_encode_teids_each, 256);
+BENCHMARK_TEMPLATE(BM_encode_teids_bulk, 4096);
+BENCHMARK_TEMPLATE(BM_encode_teids_each, 4096);
+
+} //end: namespace
@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "encode.hpp"
+#include "decode.hpp"
+#include "encoder_context.hpp"
+#include "decoder_context.hpp"
+#include "protobuf/protobuf.hpp"
+#include "protobuf/encoder.hpp"
+#include "protobuf/decoder.hpp"
+#include "cbor/encoder.hpp"
+#include "cbor/decoder.hpp"
+
+namespace {
+
+template <typename ...T> using O = med::optional<T...>;
+
+using med::protobuf::wire_type;
+template <uint32_t FIELD_NUM, wire_type TYPE>
+using T = med::value<med::fixed<med::protobuf::field_tag(FIELD_NUM, TYPE), med::protobuf::field_type>>;
+
+struct int32 : med::protobuf::int32 {};
+struct int64 : med::protobuf::int64 {};
+struct uint32 : med::protobuf::uint32 {};
+struct uint64 : med::protobuf::uint64 {};
+
+//same definition is used for both codecs: protobuf field tags are CBOR map keys
+struct MSG : med::sequence<
+	O< T<1, wire_type::VARINT>, int32 >,
+	O< T<2, wire_type::VARINT>, int64 >,
+	O< T<3, wire_type::VARINT>, uint32 >,
+	O< T<4, wire_type::VARINT>, uint64 >
+>{};
+
+void fill(MSG& msg)
+{
+	msg.ref<int32>().set(100);
+	msg.ref<int64>().set(1234567890123);
+	msg.ref<uint32>().set(70000);
+	msg.ref<uint64>().set(5);
+}
+
+template <class ENCODER>
+void encode_msg(benchmark::State& state)
+{
+	MSG msg;
+	fill(msg);
+	uint8_t buffer[128];
+	med::encoder_context<> ctx{ buffer };
+
+	while (state.KeepRunning())
+	{
+		ctx.reset();
+		encode(ENCODER{ctx}, msg);
+		benchmark::DoNotOptimize(buffer);
+	}
+	state.SetBytesProcessed(state.iterations() * ctx.buffer().get_offset());
+}
+
+template <class ENCODER, class DECODER>
+void decode_msg(benchmark::State& state)
+{
+	MSG msg;
+	fill(msg);
+	uint8_t encoded[128];
+	med::encoder_context<> ectx{ encoded };
+	encode(ENCODER{ectx}, msg);
+	auto const len = ectx.buffer().get_offset();
+
+	med::decoder_context<> ctx;
+	std::size_t dummy = 0;
+	while (state.KeepRunning())
+	{
+		ctx.reset(encoded, len);
+		msg.clear();
+		decode(DECODER{ctx}, msg);
+		dummy += msg.get<uint64>()->get();
+		benchmark::DoNotOptimize(dummy);
+	}
+	state.SetBytesProcessed(state.iterations() * len);
+}
+
+using pb_enc = med::protobuf::encoder<med::encoder_context<>>;
+using pb_dec = med::protobuf::decoder<med::decoder_context<>>;
+using cbor_enc = med::cbor::encoder<med::encoder_context<>>;
+using cbor_dec = med::cbor::decoder<med::decoder_context<>>;
+
+void BM_protobuf_encode(benchmark::State& state)    { encode_msg<pb_enc>(state); }
+BENCHMARK(BM_protobuf_encode);
+void BM_cbor_encode(benchmark::State& state)        { encode_msg<cbor_enc>(state); }
+BENCHMARK(BM_cbor_encode);
+void BM_protobuf_decode(benchmark::State& state)    { decode_msg<pb_enc, pb_dec>(state); }
+BENCHMARK(BM_protobuf_decode);
+void BM_cbor_decode(benchmark::State& state)        { decode_msg<cbor_enc, cbor_dec>(state); }
+BENCHMARK(BM_cbor_decode);
+
+} //end: namespace
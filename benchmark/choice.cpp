@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "encode.hpp"
+#include "decode.hpp"
+#include "encoder_context.hpp"
+#include "decoder_context.hpp"
+#include "octet_encoder.hpp"
+#include "octet_decoder.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+template <typename ...T> using O = med::optional<T...>;
+using L = med::length_t<med::value<uint8_t>>;
+template <uint8_t TAG> using T = med::value<med::fixed<TAG, uint8_t>>;
+
+struct BYTE : med::value<uint8_t>{};
+struct WORD : med::value<uint16_t>{};
+struct DATA : med::octet_string<med::octets_var_intern<4096>>{};
+
+template <int I>
+struct SMALL : med::sequence<
+	M< T<1>, BYTE >,
+	O< T<2>, WORD >
+>{};
+
+struct LARGE : med::sequence<
+	M< T<1>, L, DATA >
+>{};
+
+template <template <class> class WRAP>
+struct MSG : med::choice<
+	M< T<1>, SMALL<1> >,
+	M< T<2>, SMALL<2> >,
+	M< T<3>, SMALL<3> >,
+	M< T<4>, SMALL<4> >,
+	WRAP< M< T<5>, LARGE > >
+>{};
+
+template <class IE> using INLINE = IE;
+using MSG_INLINE = MSG<INLINE>;
+using MSG_OUTLINE = MSG<med::out_of_line>;
+
+constexpr uint8_t encoded[] = {
+	2, //choice
+	1, 0x37,
+	2, 0x12, 0x34,
+};
+
+//decode into messages of array to account cache footprint
+template <class MSG>
+void decode_array(benchmark::State& state)
+{
+	constexpr std::size_t NUM = 1024;
+	auto msgs = std::make_unique<MSG[]>(NUM);
+	uint8_t mem[64];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> ctx{encoded, &alloc};
+	std::size_t dummy = 0;
+	std::size_t i = 0;
+
+	for (auto _ : state)
+	{
+		auto& msg = msgs[i++ % NUM];
+		ctx.reset(encoded, sizeof(encoded));
+		decode(med::octet_decoder{ctx}, msg);
+		dummy += msg.template get<SMALL<2>>()->template get<BYTE>().get();
+		benchmark::DoNotOptimize(dummy);
+	}
+	state.counters["size"] = sizeof(MSG);
+}
+
+void BM_choice_inline(benchmark::State& state)      { decode_array<MSG_INLINE>(state); }
+BENCHMARK(BM_choice_inline);
+
+void BM_choice_out_of_line(benchmark::State& state) { decode_array<MSG_OUTLINE>(state); }
+BENCHMARK(BM_choice_out_of_line);
+
+} //end: namespace
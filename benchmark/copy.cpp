@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <memory_resource>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "deep_copy.hpp"
+#include "pmr.hpp"
+#include "decode.hpp"
+#include "decoder_context.hpp"
+#include "octet_decoder.hpp"
+
+namespace {
+
+template <typename ...T> using O = med::optional<T...>;
+using L = med::length_t<med::value<uint8_t>>;
+template <uint8_t TAG> using T = med::value<med::fixed<TAG, uint8_t>>;
+
+struct WORD : med::value<uint16_t>{};
+struct TEXT : med::octet_string<med::octets_var_reloc, med::max<64>>{};
+
+struct ITEM : med::sequence<
+	O< T<1>, L, TEXT >,
+	O< T<2>, WORD >
+>{};
+
+//one inplace item and the rest from allocator
+struct MSG : med::sequence<
+	O< T<3>, L, ITEM, med::inf >
+>{};
+
+constexpr uint8_t encoded[] = {
+	3, 9, 1, 4, 'o','n','e','!', 2, 0x00, 0x01,
+	3, 9, 1, 4, 't','w','o','!', 2, 0x00, 0x02,
+	3, 9, 1, 4, 't','h','r','e', 2, 0x00, 0x03,
+	3, 9, 1, 4, 'f','o','u','r', 2, 0x00, 0x04,
+	3, 9, 1, 4, 'f','i','v','e', 2, 0x00, 0x05,
+	3, 9, 1, 4, 's','i','x','!', 2, 0x00, 0x06,
+};
+
+struct fixture
+{
+	fixture()
+	{
+		med::decoder_context<med::allocator> ctx{encoded, &src_alloc};
+		decode(med::octet_decoder{ctx}, src);
+	}
+
+	uint8_t        src_mem[512];
+	med::allocator src_alloc{src_mem};
+	MSG            src;
+	uint8_t        dst_mem[512];
+	med::allocator dst_alloc{dst_mem};
+	MSG            dst;
+};
+
+//allocation per node and string
+void BM_copy_fieldwise(benchmark::State& state)
+{
+	auto f = std::make_unique<fixture>();
+	for (auto _ : state)
+	{
+		f->dst_alloc.release();
+		f->dst.clear();
+		f->dst.copy(f->src, f->dst_alloc);
+		benchmark::DoNotOptimize(f->dst);
+	}
+}
+BENCHMARK(BM_copy_fieldwise);
+
+//single allocation of upfront computed size (pays off w/ costly allocator only)
+void BM_copy_deep(benchmark::State& state)
+{
+	auto f = std::make_unique<fixture>();
+	for (auto _ : state)
+	{
+		f->dst_alloc.release();
+		med::deep_copy(f->dst, f->src, f->dst_alloc);
+		benchmark::DoNotOptimize(f->dst);
+	}
+}
+BENCHMARK(BM_copy_deep);
+
+//same with costly allocator
+template <bool DEEP>
+void copy_pool(benchmark::State& state)
+{
+	auto f = std::make_unique<fixture>();
+	std::pmr::synchronized_pool_resource pool;
+	med::pmr_allocator alloc{&pool};
+	for (auto _ : state)
+	{
+		if constexpr (DEEP) { med::deep_copy(f->dst, f->src, alloc); }
+		else { f->dst.copy(f->src, alloc); }
+		benchmark::DoNotOptimize(f->dst);
+		f->dst.clear();
+		pool.release();
+	}
+}
+
+void BM_copy_fieldwise_pool(benchmark::State& state)   { copy_pool<false>(state); }
+BENCHMARK(BM_copy_fieldwise_pool);
+void BM_copy_deep_pool(benchmark::State& state)        { copy_pool<true>(state); }
+BENCHMARK(BM_copy_deep_pool);
+
+//steals external nodes back and forth
+void BM_copy_move(benchmark::State& state)
+{
+	auto f = std::make_unique<fixture>();
+	for (auto _ : state)
+	{
+		f->dst = std::move(f->src);
+		f->src = std::move(f->dst);
+		benchmark::DoNotOptimize(f->src);
+	}
+}
+BENCHMARK(BM_copy_move);
+
+} //end: namespace
@@ -0,0 +1,149 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "decode.hpp"
+#include "decode_only.hpp"
+#include "decoder_context.hpp"
+#include "octet_decoder.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+template <typename ...T> using O = med::optional<T...>;
+using L = med::length_t<med::value<uint8_t>>;
+
+//Diameter AVPs as in ut/diameter.cpp
+struct avp_code : med::value<uint32_t>
+{
+	static constexpr bool match(value_type) { return true; }
+};
+template <avp_code::value_type CODE>
+struct avp_code_fixed : med::value<med::fixed<CODE, avp_code::value_type>> {};
+
+struct avp_flags : med::value<uint32_t, med::padding<uint32_t>>
+{
+	static constexpr value_type LEN_EXTRA = 8;
+	static constexpr value_type LEN_MASK = (1u << 24) - 1;
+	value_type get_length() const noexcept   { return (get_encoded() & LEN_MASK) - LEN_EXTRA; }
+	void set_length(value_type v) noexcept   { set_encoded((v + LEN_EXTRA) | (get_encoded() & ~LEN_MASK)); }
+};
+
+struct vendor : med::value<uint32_t>
+{
+	struct has
+	{
+		template <class HDR>
+		bool operator()(HDR const& hdr) const { return hdr.template as<avp_flags>().get() & 0x8000'0000; }
+	};
+};
+
+template <class BODY, avp_code::value_type CODE>
+struct avp : med::sequence<
+		M< avp_flags >,
+		O< vendor, vendor::has >,
+		M< BODY >
+	>, med::add_meta_info<
+		med::add_tag<avp_code_fixed<CODE>>,
+		med::add_len<avp_flags>
+	>
+{
+	bool is_set() const { return this->template get<BODY>().is_set(); }
+};
+
+struct unsigned32 : med::value<uint32_t> {};
+struct text : med::ascii_string<> {};
+
+struct result_code : avp<unsigned32, 268> {};
+struct origin_host : avp<text, 264> {};
+struct origin_realm : avp<text, 296> {};
+struct session_id : avp<text, 263> {};
+struct error_message : avp<text, 281> {};
+struct failed_avp : avp<med::octet_string<>, 279> {};
+
+struct any_avp : med::sequence<
+		M< avp_code >,
+		M< avp_flags >,
+		O< vendor, vendor::has >,
+		M< med::octet_string<> >
+	>, med::add_meta_info<
+		med::add_tag<avp_code>,
+		med::add_len<avp_flags>
+	>
+{
+	bool is_set() const { return get<med::octet_string<>>().is_set(); }
+};
+
+struct DPA : med::set<
+	M< session_id >,
+	M< result_code >,
+	M< origin_host >,
+	M< origin_realm >,
+	O< error_message >,
+	O< failed_avp, med::max<4> >,
+	O< any_avp, med::max<8> >
+>{};
+
+//AVPs with explicit length are to be within a length
+struct MSG : med::sequence<
+	M< L, DPA >
+>{};
+
+constexpr uint8_t encoded[] = {
+	180,
+	0x00, 0x00, 0x01, 0x07, 0x40, 0x00, 0x00, 36, //Session-Id
+	'p', 'e', 'e', 'r', '.', 'e', 'x', 'a', 'm', 'p', 'l', 'e', '.', 'c', 'o', 'm',
+	';', '1', '2', '3', '4', ';', '5', '6', '7', '8', ';', '9',
+	0x00, 0x00, 0x01, 0x0C, 0x40, 0x00, 0x00, 12, //Result-Code
+	0x00, 0x00, 0x0B, 0xBC,
+	0x00, 0x00, 0x01, 0x08, 0x40, 0x00, 0x00, 17, //Origin-Host
+	'O', 'r', 'i', 'g', '.', 'H', 'o', 's', 't', 0, 0, 0,
+	0x00, 0x00, 0x01, 0x02, 0x40, 0x00, 0x00, 12, //Auth-App-Id (unknown)
+	0xA5, 0x5A, 0xBC, 0xCB,
+	0x00, 0x00, 0x01, 0x28, 0x40, 0x00, 0x00, 22, //Origin-Realm
+	'o', 'r', 'i', 'g', '.', 'r', 'e', 'a', 'l', 'm', '.', 'n', 'e', 't', 0, 0,
+	0x00, 0x00, 0x01, 0x19, 0x00, 0x00, 0x00, 26, //Error-Message
+	'p', 'e', 'e', 'r', ' ', 'i', 's', ' ', 'g', 'o', 'i', 'n', 'g', ' ', 'a', 'w', 'a', 'y', 0, 0,
+	0x00, 0x00, 0x01, 0x17, 0x40, 0x00, 0x00, 20, //Failed-AVP
+	0x00, 0x00, 0x01, 0x02, 0x40, 0x00, 0x00, 12,
+	0x01, 0x00, 0x00, 0x23,
+	0x00, 0x00, 0x01, 0x15, 0x00, 0x00, 0x00, 12, //Termination-Cause (unknown)
+	0x00, 0x00, 0x00, 0x01,
+	0x00, 0x00, 0x01, 0x16, 0x80, 0x00, 0x00, 16, //Vendor-Specific (unknown)
+	0x00, 0x00, 0x28, 0xAF, 0x00, 0x00, 0x00, 0x05,
+};
+static_assert(sizeof(encoded) == 1 + 180);
+
+void BM_decode_only_full(benchmark::State& state)
+{
+	auto msg = std::make_unique<MSG>();
+
+	for (auto _ : state)
+	{
+		msg->clear();
+		med::decoder_context<> ctx{encoded};
+		decode(med::octet_decoder{ctx}, *msg);
+		benchmark::DoNotOptimize(msg.get());
+	}
+}
+BENCHMARK(BM_decode_only_full);
+
+//only Origin-Host is decoded, other AVPs are skipped by their length
+void BM_decode_only_host(benchmark::State& state)
+{
+	auto msg = std::make_unique<MSG>();
+
+	for (auto _ : state)
+	{
+		msg->clear();
+		med::decoder_context<> ctx{encoded};
+		med::decode_only<origin_host>(med::octet_decoder{ctx}, *msg);
+		benchmark::DoNotOptimize(msg.get());
+	}
+}
+BENCHMARK(BM_decode_only_host);
+
+} //end: namespace
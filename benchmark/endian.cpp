@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "encode.hpp"
+#include "decode.hpp"
+#include "encoder_context.hpp"
+#include "decoder_context.hpp"
+#include "octet_encoder.hpp"
+#include "octet_decoder.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+
+struct U16 : med::value<uint16_t>{};
+struct U32 : med::value<uint32_t>{};
+struct U64 : med::value<uint64_t>{};
+struct U24 : med::value<med::bytes<3>>{};
+struct I32 : med::value<int32_t>{};
+struct I64 : med::value<int64_t>{};
+
+//typical IPC record of multi-octet fields
+struct RECORD : med::sequence<
+	M< U16 >,
+	M< U32 >,
+	M< U64 >,
+	M< U24 >,
+	M< I32 >,
+	M< I64 >
+>
+{};
+
+void fill(RECORD& msg)
+{
+	msg.ref<U16>().set(0x1234);
+	msg.ref<U32>().set(0x12345678);
+	msg.ref<U64>().set(0x123456789ABCDEF0);
+	msg.ref<U24>().set(0x123456);
+	msg.ref<I32>().set(-12345678);
+	msg.ref<I64>().set(-1234567890123);
+}
+
+template <class ORDER>
+void encode_record(benchmark::State& state)
+{
+	RECORD msg;
+	fill(msg);
+	uint8_t buffer[64];
+	med::encoder_context<> ctx{ buffer };
+
+	while (state.KeepRunning())
+	{
+		ctx.reset();
+		encode(med::octet_encoder{ctx, ORDER{}}, msg);
+		benchmark::DoNotOptimize(buffer);
+	}
+	state.SetBytesProcessed(state.iterations() * ctx.buffer().get_offset());
+}
+
+template <class ORDER>
+void decode_record(benchmark::State& state)
+{
+	RECORD msg;
+	fill(msg);
+	uint8_t encoded[64];
+	med::encoder_context<> ectx{ encoded };
+	encode(med::octet_encoder{ectx, ORDER{}}, msg);
+	auto const len = ectx.buffer().get_offset();
+
+	med::decoder_context<> ctx;
+	std::size_t dummy = 0;
+	while (state.KeepRunning())
+	{
+		ctx.reset(encoded, len);
+		decode(med::octet_decoder{ctx, ORDER{}}, msg);
+		dummy += msg.get<U64>().get();
+		benchmark::DoNotOptimize(dummy);
+	}
+	state.SetBytesProcessed(state.iterations() * len);
+}
+
+void BM_endian_big_encode(benchmark::State& state)      { encode_record<med::big_endian>(state); }
+BENCHMARK(BM_endian_big_encode);
+void BM_endian_little_encode(benchmark::State& state)   { encode_record<med::little_endian>(state); }
+BENCHMARK(BM_endian_little_encode);
+void BM_endian_big_decode(benchmark::State& state)      { decode_record<med::big_endian>(state); }
+BENCHMARK(BM_endian_big_decode);
+void BM_endian_little_decode(benchmark::State& state)   { decode_record<med::little_endian>(state); }
+BENCHMARK(BM_endian_little_decode);
+
+} //end: namespace
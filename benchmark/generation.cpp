@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+
+#include <utility>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "encode.hpp"
+#include "decode.hpp"
+#include "encoder_context.hpp"
+#include "decoder_context.hpp"
+#include "octet_encoder.hpp"
+#include "octet_decoder.hpp"
+#include "generation.hpp"
+
+namespace {
+
+template <typename ...T> using O = med::optional<T...>;
+using L = med::length_t<med::value<uint8_t>>;
+template <std::size_t TAG> using T = med::value<med::fixed<TAG, uint8_t>>;
+
+template <std::size_t I>
+struct WORD : med::value<uint32_t>{};
+struct DATA : med::octet_string<med::octets_var_intern<64>>{};
+
+//large message: 64 optional values and 16 octet strings inplace
+template <template <class...> class SET, class SEQ = std::make_index_sequence<64>>
+struct make_big;
+
+template <template <class...> class SET, std::size_t... I>
+struct make_big<SET, std::index_sequence<I...>>
+{
+	using type = SET<
+		O< T<I + 1>, WORD<I> >...,
+		O< T<100>, L, DATA, med::max<16> >
+	>;
+};
+
+struct BIG : make_big<med::set>::type {};
+struct GEN_BIG : make_big<med::gen_set>::type {};
+
+//small message of few fields only
+constexpr uint8_t encoded[] = {
+	1, 0, 0, 0, 1,
+	64, 0, 0, 0, 2,
+	100, 4, 'd', 'a', 't', 'a',
+};
+
+template <class MSG>
+void decode_reused(benchmark::State& state)
+{
+	MSG msg;
+	med::decoder_context<> ctx;
+	std::size_t dummy = 0;
+
+	for (auto _ : state)
+	{
+		msg.clear();
+		ctx.reset(encoded, sizeof(encoded));
+		decode(med::octet_decoder{ctx}, msg);
+		dummy += msg.template get<WORD<63>>()->get();
+		benchmark::DoNotOptimize(dummy);
+	}
+}
+
+void BM_decode_reused_clear(benchmark::State& state)      { decode_reused<BIG>(state); }
+BENCHMARK(BM_decode_reused_clear);
+
+void BM_decode_reused_generation(benchmark::State& state) { decode_reused<GEN_BIG>(state); }
+BENCHMARK(BM_decode_reused_generation);
+
+//clear alone after the message was decoded once
+template <class MSG>
+void clear_only(benchmark::State& state)
+{
+	MSG msg;
+	med::decoder_context<> ctx{encoded};
+	decode(med::octet_decoder{ctx}, msg);
+
+	for (auto _ : state)
+	{
+		msg.clear();
+		benchmark::ClobberMemory();
+	}
+}
+
+void BM_clear_plain(benchmark::State& state)              { clear_only<BIG>(state); }
+BENCHMARK(BM_clear_plain);
+
+void BM_clear_generation(benchmark::State& state)         { clear_only<GEN_BIG>(state); }
+BENCHMARK(BM_clear_generation);
+
+} //end: namespace
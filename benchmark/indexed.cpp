@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "indexed.hpp"
+#include "decode.hpp"
+#include "decoder_context.hpp"
+#include "octet_decoder.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+
+constexpr std::size_t NUM = 32;
+
+struct COUNT : med::value<uint8_t>{};
+struct CODE : med::value<uint32_t>{};
+struct DATA : med::value<uint32_t>{};
+
+//AVP-like entry looked up by its code
+struct ENTRY : med::sequence<
+	M< CODE >,
+	M< DATA >
+>{};
+
+struct by_code
+{
+	uint32_t operator()(ENTRY const& e) const { return e.get<CODE>().get(); }
+};
+
+using ENTRIES = M< med::counter_t<COUNT>, ENTRY, med::max<NUM> >;
+
+struct LINEAR : med::sequence< ENTRIES >{};
+struct INDEXED : med::sequence< med::indexed<ENTRIES, by_code, NUM> >{};
+
+constexpr auto encoded = []()
+{
+	std::array<uint8_t, 1 + 8*NUM> buf{};
+	buf[0] = NUM;
+	for (std::size_t i = 0; i < NUM; ++i)
+	{
+		buf[1 + 8*i + 2] = uint8_t(i * 7);  //code = i*7*256 in shuffled order
+		buf[1 + 8*i + 3] = uint8_t(NUM - i);
+		buf[1 + 8*i + 7] = uint8_t(i);
+	}
+	return buf;
+}();
+
+template <class MSG>
+ENTRY const* find(MSG const& msg, uint32_t code)
+{
+	auto& entries = msg.template get<ENTRY>();
+	if constexpr (requires { entries.find(code); })
+	{
+		return entries.find(code);
+	}
+	else
+	{
+		auto it = std::find_if(entries.begin(), entries.end(), [code](auto const& e) { return by_code{}(e) == code; });
+		return it == entries.end() ? nullptr : &*it;
+	}
+}
+
+//decode then look up the fields by code many times
+template <class MSG>
+void lookup(benchmark::State& state)
+{
+	auto msg = std::make_unique<MSG>();
+	std::size_t dummy = 0;
+
+	for (auto _ : state)
+	{
+		msg->clear();
+		med::decoder_context<> ctx{encoded.data(), encoded.size()};
+		decode(med::octet_decoder{ctx}, *msg);
+		for (std::size_t n = 0; n < 4; ++n)
+		{
+			for (std::size_t i = 0; i < NUM; i += 2)
+			{
+				uint32_t const code = (uint32_t(i * 7 % 256) << 8) | uint32_t(NUM - i);
+				if (auto const* e = find(*msg, code)) { dummy += e->template get<DATA>().get(); }
+			}
+		}
+		benchmark::DoNotOptimize(dummy);
+	}
+}
+
+void BM_lookup_linear(benchmark::State& state)  { lookup<LINEAR>(state); }
+BENCHMARK(BM_lookup_linear);
+
+void BM_lookup_indexed(benchmark::State& state) { lookup<INDEXED>(state); }
+BENCHMARK(BM_lookup_indexed);
+
+} //end: namespace
@@ -0,0 +1,136 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "encode.hpp"
+#include "decode.hpp"
+#include "encoder_context.hpp"
+#include "decoder_context.hpp"
+#include "printer.hpp"
+#include "json/encoder.hpp"
+#include "json/decoder.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+template <typename ...T> using O = med::optional<T...>;
+
+struct ID : med::value<uint32_t> { static constexpr char const* name() { return "id"; } };
+struct SEQ : med::value<uint64_t> { static constexpr char const* name() { return "seq"; } };
+struct TEMP : med::value<int16_t> { static constexpr char const* name() { return "temp"; } };
+struct TEXT : med::ascii_string<med::octets_var_extern, med::max<32>>
+{
+	static constexpr char const* name() { return "text"; }
+	//for printer
+	std::string_view print() const { return get(); }
+};
+
+struct MSG : med::sequence<
+	M< ID >,
+	M< SEQ >,
+	O< TEMP >,
+	O< TEXT >
+>{ static constexpr char const* name() { return "msg"; } };
+
+void fill(MSG& msg)
+{
+	msg.ref<ID>().set(100);
+	msg.ref<SEQ>().set(1234567890123);
+	msg.ref<TEMP>().set(-17);
+	msg.ref<TEXT>().set("sensor-01");
+}
+
+//prints into a text buffer similar to JSON
+struct text_sink
+{
+	char*       out;
+	std::size_t size;
+	std::size_t len {0};
+
+	void put(int n)                         { if (n > 0) { len += std::size_t(n); } }
+
+	template <typename T>
+	void on_value(std::size_t, char const* name, T value)
+	{
+		if constexpr (std::is_signed_v<T>)
+		{
+			put(std::snprintf(out + len, size - len, "\"%s\":%lld,", name, (long long)value));
+		}
+		else
+		{
+			put(std::snprintf(out + len, size - len, "\"%s\":%llu,", name, (unsigned long long)value));
+		}
+	}
+	void on_custom(std::size_t, char const* name, std::string_view s)
+	{
+		put(std::snprintf(out + len, size - len, "\"%s\":\"%.*s\",", name, int(s.size()), s.data()));
+	}
+	void on_container(std::size_t, char const* name)
+	{
+		put(std::snprintf(out + len, size - len, "\"%s\":{", name));
+	}
+	void on_error(char const*)              { }
+};
+
+void BM_print(benchmark::State& state)
+{
+	MSG msg;
+	fill(msg);
+	char buffer[256];
+	std::size_t len = 0;
+
+	while (state.KeepRunning())
+	{
+		text_sink sink{buffer, sizeof(buffer)};
+		med::print(sink, msg);
+		len = sink.len;
+		benchmark::DoNotOptimize(buffer);
+	}
+	state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK(BM_print);
+
+void BM_json_encode(benchmark::State& state)
+{
+	MSG msg;
+	fill(msg);
+	uint8_t buffer[256];
+	med::encoder_context<> ctx{ buffer };
+
+	while (state.KeepRunning())
+	{
+		ctx.reset();
+		encode(med::json::encoder{ctx}, msg);
+		benchmark::DoNotOptimize(buffer);
+	}
+	state.SetBytesProcessed(state.iterations() * ctx.buffer().get_offset());
+}
+BENCHMARK(BM_json_encode);
+
+void BM_json_decode(benchmark::State& state)
+{
+	MSG msg;
+	fill(msg);
+	uint8_t encoded[256];
+	med::encoder_context<> ectx{ encoded };
+	encode(med::json::encoder{ectx}, msg);
+	auto const len = ectx.buffer().get_offset();
+
+	med::decoder_context<> ctx;
+	std::size_t dummy = 0;
+	while (state.KeepRunning())
+	{
+		ctx.reset(encoded, len);
+		msg.clear();
+		decode(med::json::decoder{ctx}, msg);
+		dummy += msg.get<SEQ>().get();
+		benchmark::DoNotOptimize(dummy);
+	}
+	state.SetBytesProcessed(state.iterations() * len);
+}
+BENCHMARK(BM_json_decode);
+
+} //end: namespace
@@ -0,0 +1,130 @@
+#include <benchmark/benchmark.h>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "encode.hpp"
+#include "decode.hpp"
+#include "encoder_context.hpp"
+#include "decoder_context.hpp"
+#include "octet_encoder.hpp"
+#include "octet_decoder.hpp"
+#include "native/encoder.hpp"
+#include "native/view.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+template <typename ...T> using O = med::optional<T...>;
+using L = med::length_t<med::value<uint8_t>>;
+template <uint8_t TAG> using T = med::value<med::fixed<TAG, uint8_t>>;
+
+struct FLD_UC : med::value<uint8_t>{};
+struct FLD_U16 : med::value<uint16_t>{};
+struct FLD_IP : med::value<uint32_t>{};
+struct FLD_DW : med::value<uint32_t>{};
+struct VFLD1 : med::ascii_string<med::min<5>, med::max<10>>{};
+
+//same definition is used for both formats: tags and lengths are ignored by native
+struct MSG : med::sequence<
+	M< FLD_UC >,
+	M< T<0x21>, FLD_U16 >,
+	M< T<0x42>, L, FLD_IP >,
+	O< T<0x51>, FLD_DW >,
+	O< T<0x12>, L, VFLD1 >
+>{};
+
+void fill(MSG& msg)
+{
+	msg.ref<FLD_UC>().set(37);
+	msg.ref<FLD_U16>().set(0x35D9);
+	msg.ref<FLD_IP>().set(0xFee1ABBA);
+	msg.ref<FLD_DW>().set(0x01020304);
+	msg.ref<VFLD1>().set("test.this!");
+}
+
+//encode then decode all to read a field
+void BM_octet_roundtrip(benchmark::State& state)
+{
+	MSG msg;
+	fill(msg);
+	uint8_t buffer[128];
+	med::encoder_context<> ectx{ buffer };
+	med::decoder_context<> dctx;
+	MSG dmsg;
+	std::size_t dummy = 0;
+
+	while (state.KeepRunning())
+	{
+		ectx.reset();
+		encode(med::octet_encoder{ectx}, msg);
+		dctx.reset(buffer, ectx.buffer().get_offset());
+		dmsg.clear();
+		decode(med::octet_decoder{dctx}, dmsg);
+		dummy += dmsg.get<FLD_DW>()->get();
+		benchmark::DoNotOptimize(dummy);
+	}
+}
+BENCHMARK(BM_octet_roundtrip);
+
+//write then access the field directly
+void BM_native_roundtrip(benchmark::State& state)
+{
+	MSG msg;
+	fill(msg);
+	uint8_t buffer[128];
+	med::encoder_context<> ectx{ buffer };
+	std::size_t dummy = 0;
+
+	while (state.KeepRunning())
+	{
+		ectx.reset();
+		encode(med::native::encoder{ectx}, msg);
+		med::native::view<MSG> v{buffer, ectx.buffer().get_offset()};
+		dummy += *v.get<FLD_DW>();
+		benchmark::DoNotOptimize(dummy);
+	}
+}
+BENCHMARK(BM_native_roundtrip);
+
+void BM_octet_read(benchmark::State& state)
+{
+	MSG msg;
+	fill(msg);
+	uint8_t buffer[128];
+	med::encoder_context<> ectx{ buffer };
+	encode(med::octet_encoder{ectx}, msg);
+	med::decoder_context<> dctx;
+	std::size_t dummy = 0;
+
+	while (state.KeepRunning())
+	{
+		dctx.reset(buffer, ectx.buffer().get_offset());
+		msg.clear();
+		decode(med::octet_decoder{dctx}, msg);
+		dummy += msg.get<FLD_DW>()->get();
+		benchmark::DoNotOptimize(dummy);
+	}
+}
+BENCHMARK(BM_octet_read);
+
+void BM_native_read(benchmark::State& state)
+{
+	MSG msg;
+	fill(msg);
+	uint8_t buffer[128];
+	med::encoder_context<> ectx{ buffer };
+	encode(med::native::encoder{ectx}, msg);
+	std::size_t dummy = 0;
+
+	while (state.KeepRunning())
+	{
+		benchmark::DoNotOptimize(buffer);
+		med::native::view<MSG> v{buffer, ectx.buffer().get_offset()};
+		dummy += *v.get<FLD_DW>();
+		benchmark::DoNotOptimize(dummy);
+	}
+}
+BENCHMARK(BM_native_read);
+
+} //end: namespace
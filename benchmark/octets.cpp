@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <memory>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "encode.hpp"
+#include "decode.hpp"
+#include "encoder_context.hpp"
+#include "decoder_context.hpp"
+#include "octet_encoder.hpp"
+#include "octet_decoder.hpp"
+
+namespace {
+
+template <typename ...T> using O = med::optional<T...>;
+using L = med::length_t<med::value<uint8_t>>;
+template <uint8_t TAG> using T = med::value<med::fixed<TAG, uint8_t>>;
+
+template <class VALUE, int I>
+struct STR : med::octet_string<VALUE, med::max<255>>{};
+
+//mostly short strings with occasional long one
+template <class VALUE>
+struct MSG : med::sequence<
+	O< T<1>, L, STR<VALUE, 1> >,
+	O< T<2>, L, STR<VALUE, 2> >,
+	O< T<3>, L, STR<VALUE, 3> >,
+	O< T<4>, L, STR<VALUE, 4> >
+>{};
+
+constexpr auto encoded = []()
+{
+	std::array<uint8_t, 3*(2+12) + 2+200> buf{};
+	std::size_t i = 0;
+	for (uint8_t tag = 1; tag <= 4; ++tag)
+	{
+		uint8_t const len = tag == 4 ? 200 : 12;
+		buf[i++] = tag;
+		buf[i++] = len;
+		for (uint8_t j = 0; j < len; ++j) { buf[i++] = uint8_t(tag + j); }
+	}
+	return buf;
+}();
+
+//decode into messages of array to account cache footprint
+template <class VALUE>
+void decode_array(benchmark::State& state)
+{
+	constexpr std::size_t NUM = 1024;
+	auto msgs = std::make_unique<MSG<VALUE>[]>(NUM);
+	uint8_t mem[256];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> ctx{encoded.data(), encoded.size(), &alloc};
+	std::size_t dummy = 0;
+	std::size_t i = 0;
+
+	for (auto _ : state)
+	{
+		auto& msg = msgs[i++ % NUM];
+		alloc.release();
+		ctx.reset(encoded.data(), encoded.size());
+		decode(med::octet_decoder{ctx}, msg);
+		dummy += msg.template get<STR<VALUE, 4>>()->size();
+		benchmark::DoNotOptimize(dummy);
+	}
+	state.counters["size"] = sizeof(MSG<VALUE>);
+}
+
+void BM_octets_intern(benchmark::State& state)  { decode_array<med::octets_var_intern<255>>(state); }
+BENCHMARK(BM_octets_intern);
+
+void BM_octets_sbo(benchmark::State& state)     { decode_array<med::octets_var_sbo<23>>(state); }
+BENCHMARK(BM_octets_sbo);
+
+void BM_octets_extern(benchmark::State& state)  { decode_array<med::octets_var_extern>(state); }
+BENCHMARK(BM_octets_extern);
+
+} //end: namespace
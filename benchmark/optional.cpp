@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <memory>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "decode.hpp"
+#include "decoder_context.hpp"
+#include "octet_decoder.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+template <typename ...T> using O = med::optional<T...>;
+template <uint8_t TAG> using T = med::value<med::fixed<TAG, uint8_t>>;
+
+template <int I>
+struct FLD : med::value<uint16_t>{};
+
+//extension block: long run of tagged optionals followed by mandatory
+struct EXT : med::sequence<
+	O< T<1>, FLD<1> >,
+	O< T<2>, FLD<2> >,
+	O< T<3>, FLD<3> >,
+	O< T<4>, FLD<4> >,
+	O< T<5>, FLD<5> >,
+	O< T<6>, FLD<6> >,
+	O< T<7>, FLD<7> >,
+	O< T<8>, FLD<8> >,
+	O< T<9>, FLD<9> >,
+	O< T<10>, FLD<10> >,
+	O< T<11>, FLD<11> >,
+	O< T<12>, FLD<12> >,
+	O< T<13>, FLD<13> >,
+	O< T<14>, FLD<14> >,
+	O< T<15>, FLD<15> >,
+	O< T<16>, FLD<16> >,
+	M< T<0xFF>, FLD<0> >
+>{};
+
+//same decoded via table of tags
+template <class SEQ> struct sparse_of;
+template <class... IES>
+struct sparse_of<med::sequence<IES...>>
+{
+	using type = med::sparse_sequence<IES...>;
+};
+struct SPARSE_EXT : sparse_of<EXT::sequence>::type {};
+
+//encoded with every STEP-th optional present
+template <std::size_t STEP, std::size_t NUM = 16>
+constexpr auto encode_ext()
+{
+	std::array<uint8_t, 3 * (NUM / STEP + 1)> buf{};
+	std::size_t i = 0;
+	for (std::size_t tag = STEP; tag <= NUM; tag += STEP)
+	{
+		buf[i++] = uint8_t(tag);
+		buf[i++] = 0x12;
+		buf[i++] = uint8_t(tag);
+	}
+	buf[i++] = 0xFF;
+	buf[i++] = 0x34;
+	buf[i++] = 0x56;
+	return buf;
+}
+
+//wide extension block of 64 optionals
+template <class SEQ> struct wide_of;
+template <std::size_t... Is>
+struct wide_of<std::index_sequence<Is...>>
+{
+	using type = med::sequence< O< T<Is + 1>, FLD<Is + 1> >..., M< T<0xFF>, FLD<0> > >;
+};
+struct WIDE : wide_of<std::make_index_sequence<64>>::type {};
+struct SPARSE_WIDE : sparse_of<WIDE::sequence>::type {};
+
+constexpr auto sparse = encode_ext<8>();
+constexpr auto dense = encode_ext<1>();
+constexpr auto wide_sparse = encode_ext<32, 64>();
+constexpr auto wide_dense = encode_ext<1, 64>();
+
+template <class MSG, auto const& ENCODED>
+void decode_ext(benchmark::State& state)
+{
+	auto msg = std::make_unique<MSG>();
+	auto encoded = ENCODED; //not to fold decode of constant
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(encoded.data());
+		msg->clear();
+		med::decoder_context<> ctx{encoded.data(), encoded.size()};
+		decode(med::octet_decoder{ctx}, *msg);
+		benchmark::DoNotOptimize(msg.get());
+		benchmark::ClobberMemory();
+	}
+}
+
+void BM_optional_sparse(benchmark::State& state) { decode_ext<EXT, sparse>(state); }
+BENCHMARK(BM_optional_sparse);
+
+void BM_optional_dense(benchmark::State& state)  { decode_ext<EXT, dense>(state); }
+BENCHMARK(BM_optional_dense);
+
+void BM_optional_wide_sparse(benchmark::State& state) { decode_ext<WIDE, wide_sparse>(state); }
+BENCHMARK(BM_optional_wide_sparse);
+
+void BM_optional_wide_dense(benchmark::State& state)  { decode_ext<WIDE, wide_dense>(state); }
+BENCHMARK(BM_optional_wide_dense);
+
+void BM_optional_runs_sparse(benchmark::State& state) { decode_ext<SPARSE_EXT, sparse>(state); }
+BENCHMARK(BM_optional_runs_sparse);
+
+void BM_optional_runs_dense(benchmark::State& state)  { decode_ext<SPARSE_EXT, dense>(state); }
+BENCHMARK(BM_optional_runs_dense);
+
+void BM_optional_runs_wide_sparse(benchmark::State& state) { decode_ext<SPARSE_WIDE, wide_sparse>(state); }
+BENCHMARK(BM_optional_runs_wide_sparse);
+
+void BM_optional_runs_wide_dense(benchmark::State& state)  { decode_ext<SPARSE_WIDE, wide_dense>(state); }
+BENCHMARK(BM_optional_runs_wide_dense);
+
+} //end: namespace
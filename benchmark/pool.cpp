@@ -0,0 +1,100 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "encode.hpp"
+#include "decode.hpp"
+#include "encoder_context.hpp"
+#include "decoder_context.hpp"
+#include "octet_encoder.hpp"
+#include "octet_decoder.hpp"
+#include "message_pool.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+template <typename ...T> using O = med::optional<T...>;
+using L = med::length_t<med::value<uint8_t>>;
+template <uint8_t TAG> using T = med::value<med::fixed<TAG, uint8_t>>;
+
+struct BYTE : med::value<uint8_t>{};
+struct WORD : med::value<uint16_t>{};
+struct DATA : med::octet_string<med::octets_var_intern<1024>>{};
+
+//several KB due to inline buffers
+template <int I>
+struct SET : med::set<
+	M< T<1>, BYTE >,
+	O< T<2>, WORD >,
+	O< T<3>, L, DATA >
+>{};
+
+struct MSG : med::choice<
+	M< T<1>, SET<1> >,
+	M< T<2>, SET<2> >,
+	M< T<3>, SET<3> >,
+	M< T<4>, SET<4> >
+>{};
+
+constexpr uint8_t encoded[] = {
+	2, //choice
+	1, 0x37,
+	3, 4, 'd', 'a', 't', 'a',
+};
+
+void BM_decode_new(benchmark::State& state)
+{
+	med::decoder_context<> ctx;
+	std::size_t dummy = 0;
+
+	for (auto _ : state)
+	{
+		auto msg = std::make_unique<MSG>();
+		ctx.reset(encoded, sizeof(encoded));
+		decode(med::octet_decoder{ctx}, *msg);
+		dummy += msg->get<SET<2>>()->get<BYTE>().get();
+		benchmark::DoNotOptimize(dummy);
+	}
+}
+BENCHMARK(BM_decode_new);
+
+void BM_decode_pool(benchmark::State& state)
+{
+	med::message_pool<MSG> pool{16};
+	med::message_pool<MSG>::cache<> cache{pool};
+	med::decoder_context<> ctx;
+	std::size_t dummy = 0;
+
+	for (auto _ : state)
+	{
+		auto msg = cache.acquire();
+		ctx.reset(encoded, sizeof(encoded));
+		decode(med::octet_decoder{ctx}, *msg);
+		dummy += msg->get<SET<2>>()->get<BYTE>().get();
+		benchmark::DoNotOptimize(dummy);
+		cache.release(std::move(msg));
+	}
+}
+BENCHMARK(BM_decode_pool);
+
+void BM_decode_pool_shared(benchmark::State& state)
+{
+	static med::message_pool<MSG> pool{16};
+	med::decoder_context<> ctx;
+	std::size_t dummy = 0;
+
+	for (auto _ : state)
+	{
+		auto msg = pool.acquire();
+		ctx.reset(encoded, sizeof(encoded));
+		decode(med::octet_decoder{ctx}, *msg);
+		dummy += msg->get<SET<2>>()->get<BYTE>().get();
+		benchmark::DoNotOptimize(dummy);
+	}
+}
+BENCHMARK(BM_decode_pool_shared)->ThreadRange(1, 4)->UseRealTime();
+
+} //end: namespace
@@ -0,0 +1,175 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <memory>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "encode.hpp"
+#include "decode.hpp"
+#include "encoder_context.hpp"
+#include "decoder_context.hpp"
+#include "octet_encoder.hpp"
+#include "octet_decoder.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+template <typename ...T> using O = med::optional<T...>;
+using L = med::length_t<med::value<uint8_t>>;
+template <uint8_t TAG> using T = med::value<med::fixed<TAG, uint8_t>>;
+
+struct WORD : med::value<uint16_t>
+{
+	using links = med::relocatable;
+};
+struct TEXT : med::octet_string<med::octets_var_reloc, med::max<64>>{};
+
+struct MSG : med::sequence<
+	O< T<1>, L, TEXT >,
+	O< T<2>, WORD, med::max<8> >
+>{};
+
+//message and its allocator space in one block to be handed off
+struct blob
+{
+	MSG     msg;
+	uint8_t mem[128];
+};
+
+constexpr uint8_t encoded[] = {
+	1, 16, 'r','e','l','o','c','a','t','a','b','l','e',' ','b','l','o','b',
+	2, 0x00, 0x01,  2, 0x00, 0x02,  2, 0x00, 0x03,  2, 0x00, 0x04,
+	2, 0x00, 0x05,  2, 0x00, 0x06,  2, 0x00, 0x07,  2, 0x00, 0x08,
+};
+
+void decode_into(blob& b, uint8_t const* data, std::size_t size)
+{
+	b.msg.clear();
+	med::allocator alloc{b.mem};
+	med::decoder_context<med::allocator> ctx{data, size, &alloc};
+	decode(med::octet_decoder{ctx}, b.msg);
+}
+
+std::size_t sum(MSG const& msg)
+{
+	std::size_t res = msg.get<TEXT>()->size();
+	for (auto& w : msg.get<WORD>()) { res += w.get(); }
+	return res;
+}
+
+//copy of decoded message as a blob
+void BM_handoff_blob(benchmark::State& state)
+{
+	auto src = std::make_unique<blob>();
+	decode_into(*src, encoded, sizeof(encoded));
+	auto dst = std::make_unique<blob>();
+	std::size_t dummy = 0;
+
+	for (auto _ : state)
+	{
+		std::memcpy(static_cast<void*>(dst.get()), src.get(), sizeof(blob));
+		benchmark::ClobberMemory();
+		dummy += sum(dst->msg);
+		benchmark::DoNotOptimize(dummy);
+	}
+	state.counters["size"] = sizeof(blob);
+}
+BENCHMARK(BM_handoff_blob);
+
+//same via re-encoding
+void BM_handoff_reencode(benchmark::State& state)
+{
+	auto src = std::make_unique<blob>();
+	decode_into(*src, encoded, sizeof(encoded));
+	auto dst = std::make_unique<blob>();
+	uint8_t buffer[128];
+	std::size_t dummy = 0;
+
+	for (auto _ : state)
+	{
+		med::encoder_context<> ctx{buffer};
+		encode(med::octet_encoder{ctx}, src->msg);
+		decode_into(*dst, buffer, ctx.buffer().get_offset());
+		dummy += sum(dst->msg);
+		benchmark::DoNotOptimize(dummy);
+	}
+	state.counters["size"] = sizeof(blob);
+}
+BENCHMARK(BM_handoff_reencode);
+
+//cost of relocatable links vs raw ones (default) on decode and traversal
+template <class LINKS>
+struct ITEM : med::value<uint16_t>
+{
+	using links = LINKS;
+};
+
+template <class LINKS>
+struct ITEMS : med::sequence<
+	O< T<2>, ITEM<LINKS>, med::max<16> >
+>{};
+
+template <class LINKS>
+struct ALT : med::choice<
+	M< T<1>, ITEM<LINKS> >,
+	med::out_of_line< M< T<2>, L, TEXT >, LINKS >
+>{};
+
+constexpr uint8_t items[] = {
+	2, 0x00, 0x01,  2, 0x00, 0x02,  2, 0x00, 0x03,  2, 0x00, 0x04,
+	2, 0x00, 0x05,  2, 0x00, 0x06,  2, 0x00, 0x07,  2, 0x00, 0x08,
+	2, 0x00, 0x09,  2, 0x00, 0x0A,  2, 0x00, 0x0B,  2, 0x00, 0x0C,
+};
+constexpr uint8_t alt[] = { 2, 5, 'h','e','l','l','o' };
+
+template <class LINKS>
+void multi_links(benchmark::State& state)
+{
+	uint8_t mem[256];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> ctx{items, &alloc};
+	ITEMS<LINKS> msg;
+	std::size_t dummy = 0;
+
+	for (auto _ : state)
+	{
+		alloc.reset(mem);
+		ctx.reset(items, sizeof(items));
+		msg.clear();
+		decode(med::octet_decoder{ctx}, msg);
+		for (auto& w : msg.template get<ITEM<LINKS>>()) { dummy += w.get(); }
+		benchmark::DoNotOptimize(dummy);
+	}
+}
+
+template <class LINKS>
+void choice_links(benchmark::State& state)
+{
+	uint8_t mem[256];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> ctx{alt, &alloc};
+	ALT<LINKS> msg;
+	std::size_t dummy = 0;
+
+	for (auto _ : state)
+	{
+		alloc.reset(mem);
+		ctx.reset(alt, sizeof(alt));
+		decode(med::octet_decoder{ctx}, msg);
+		dummy += msg.template get<TEXT>()->size();
+		benchmark::DoNotOptimize(dummy);
+	}
+}
+
+void BM_multi_raw_links(benchmark::State& state)        { multi_links<med::raw_links>(state); }
+BENCHMARK(BM_multi_raw_links);
+void BM_multi_reloc_links(benchmark::State& state)      { multi_links<med::relocatable>(state); }
+BENCHMARK(BM_multi_reloc_links);
+void BM_choice_raw_links(benchmark::State& state)       { choice_links<med::raw_links>(state); }
+BENCHMARK(BM_choice_raw_links);
+void BM_choice_reloc_links(benchmark::State& state)     { choice_links<med::relocatable>(state); }
+BENCHMARK(BM_choice_reloc_links);
+
+} //end: namespace
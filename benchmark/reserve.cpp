@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <memory_resource>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "pmr.hpp"
+#include "decode.hpp"
+#include "decoder_context.hpp"
+#include "octet_decoder.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+
+constexpr std::size_t NUM = 64;
+
+struct COUNT : med::value<uint8_t>{};
+struct ITEM : med::value<uint32_t>{};
+
+struct COUNTED : med::sequence<
+	M< med::counter_t<COUNT>, ITEM, med::pmax<NUM> >
+>{};
+
+struct UNCOUNTED : med::sequence<
+	M< COUNT >,
+	M< ITEM, med::pmax<NUM> >
+>{};
+
+constexpr auto encoded = []()
+{
+	std::array<uint8_t, 1 + 4*NUM> buf{};
+	buf[0] = NUM;
+	for (std::size_t i = 0; i < NUM; ++i) { buf[1 + 4*i + 3] = uint8_t(i); }
+	return buf;
+}();
+
+//nodes from general purpose heap via pmr adapter
+template <class MSG>
+void decode_array(benchmark::State& state)
+{
+	std::pmr::unsynchronized_pool_resource pool;
+	med::pmr_allocator alloc{&pool};
+	std::size_t dummy = 0;
+
+	for (auto _ : state)
+	{
+		{
+			MSG msg;
+			med::decoder_context<med::pmr_allocator> ctx{encoded.data(), encoded.size(), &alloc};
+			decode(med::octet_decoder{ctx}, msg);
+			dummy += msg.template count<ITEM>();
+		}
+		pool.release();
+		benchmark::DoNotOptimize(dummy);
+	}
+}
+
+void BM_reserve_counted(benchmark::State& state)    { decode_array<COUNTED>(state); }
+BENCHMARK(BM_reserve_counted);
+
+void BM_reserve_rest(benchmark::State& state)       { decode_array<UNCOUNTED>(state); }
+BENCHMARK(BM_reserve_rest);
+
+} //end: namespace
@@ -0,0 +1,166 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "decode.hpp"
+#include "decoder_context.hpp"
+#include "octet_decoder.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+template <typename ...T> using O = med::optional<T...>;
+using L = med::length_t<med::value<uint8_t>>;
+template <uint8_t TAG> using T = med::value<med::fixed<TAG, uint8_t>>;
+
+//Diameter AVPs as in ut/diameter.cpp
+namespace dia {
+
+struct avp_code : med::value<uint32_t>
+{
+	static constexpr bool match(value_type) { return true; }
+};
+template <avp_code::value_type CODE>
+struct avp_code_fixed : med::value<med::fixed<CODE, avp_code::value_type>> {};
+
+struct avp_flags : med::value<uint32_t, med::padding<uint32_t>>
+{
+	static constexpr value_type LEN_EXTRA = 8;
+	static constexpr value_type LEN_MASK = (1u << 24) - 1;
+	value_type get_length() const noexcept   { return (get_encoded() & LEN_MASK) - LEN_EXTRA; }
+	void set_length(value_type v) noexcept   { set_encoded((v + LEN_EXTRA) | (get_encoded() & ~LEN_MASK)); }
+};
+
+struct vendor : med::value<uint32_t>
+{
+	struct has
+	{
+		template <class HDR>
+		bool operator()(HDR const& hdr) const { return hdr.template as<avp_flags>().get() & 0x8000'0000; }
+	};
+};
+
+template <class BODY, avp_code::value_type CODE>
+struct avp : med::sequence<
+		M< avp_flags >,
+		O< vendor, vendor::has >,
+		M< BODY >
+	>, med::add_meta_info<
+		med::add_tag<avp_code_fixed<CODE>>,
+		med::add_len<avp_flags>
+	>
+{
+	bool is_set() const { return this->template get<BODY>().is_set(); }
+};
+
+struct unsigned32 : med::value<uint32_t> {};
+struct text : med::ascii_string<> {};
+
+struct result_code : avp<unsigned32, 268> {};
+struct origin_host : avp<text, 264> {};
+struct origin_realm : avp<text, 296> {};
+
+struct any_avp : med::sequence<
+		M< avp_code >,
+		M< avp_flags >,
+		O< vendor, vendor::has >,
+		M< med::octet_string<> >
+	>, med::add_meta_info<
+		med::add_tag<avp_code>,
+		med::add_len<avp_flags>
+	>
+{
+	bool is_set() const { return get<med::octet_string<>>().is_set(); }
+};
+
+struct DPA : med::set<
+	M< result_code >,
+	M< origin_host >,
+	M< origin_realm >,
+	O< any_avp, med::max<8> >
+>{};
+
+//AVPs with explicit length are to be within a length
+struct MSG : med::sequence<
+	M< L, DPA >
+>{};
+
+constexpr uint8_t encoded[] = {
+	112,
+	0x00, 0x00, 0x01, 0x0C, 0x40, 0x00, 0x00, 12, //Result-Code
+	0x00, 0x00, 0x0B, 0xBC,
+	0x00, 0x00, 0x01, 0x08, 0x40, 0x00, 0x00, 17, //Origin-Host
+	'O', 'r', 'i', 'g', '.', 'H', 'o', 's', 't', 0, 0, 0,
+	0x00, 0x00, 0x01, 0x02, 0x40, 0x00, 0x00, 12, //Auth-App-Id (unknown)
+	0xA5, 0x5A, 0xBC, 0xCB,
+	0x00, 0x00, 0x01, 0x28, 0x40, 0x00, 0x00, 22, //Origin-Realm
+	'o', 'r', 'i', 'g', '.', 'r', 'e', 'a', 'l', 'm', '.', 'n', 'e', 't', 0, 0,
+	0x00, 0x00, 0x01, 0x15, 0x00, 0x00, 0x00, 12, //Termination-Cause (unknown)
+	0x00, 0x00, 0x00, 0x01,
+	0x00, 0x00, 0x01, 0x07, 0x40, 0x00, 0x00, 16, //Session-Id (unknown)
+	's', 'e', 's', 's', 'i', 'o', 'n', '1',
+	0x00, 0x00, 0x01, 0x16, 0x80, 0x00, 0x00, 16, //Vendor-Specific (unknown)
+	0x00, 0x00, 0x28, 0xAF, 0x00, 0x00, 0x00, 0x05,
+};
+
+} //end: namespace dia
+
+//set with compound header handed to its IEs
+namespace cmp {
+
+struct code : med::value<uint8_t>{};
+struct flags : med::value<uint8_t>{};
+struct number : med::value<uint32_t>{};
+struct string : med::ascii_string<med::max<16>>{};
+
+struct hdr : med::sequence<
+	M<code>,
+	M<flags>
+>
+{
+	auto get_tag() const    { return get<code>().get(); }
+};
+
+struct str_ie : med::sequence< M<hdr>, M<L, string> >{};
+struct num_ie : med::sequence< M<hdr>, M<number> >{};
+
+struct SET : med::set< hdr
+	, M< T<1>, str_ie >
+	, O< T<2>, num_ie, med::max<8> >
+>{};
+
+constexpr uint8_t encoded[] = {
+	2, 0, 0x12, 0x34, 0x56, 0x78,
+	1, 0x80, 8, '1', '2', '3', '4', '5', '6', '7', '8',
+	2, 1, 0x12, 0x34, 0x56, 0x79,
+	2, 2, 0x12, 0x34, 0x56, 0x7A,
+	2, 3, 0x12, 0x34, 0x56, 0x7B,
+	2, 4, 0x12, 0x34, 0x56, 0x7C,
+};
+
+} //end: namespace cmp
+
+template <class MSG, auto const& ENCODED>
+void decode_set(benchmark::State& state)
+{
+	auto msg = std::make_unique<MSG>();
+
+	for (auto _ : state)
+	{
+		msg->clear();
+		med::decoder_context<> ctx{ENCODED};
+		decode(med::octet_decoder{ctx}, *msg);
+		benchmark::DoNotOptimize(msg.get());
+	}
+}
+
+void BM_set_diameter(benchmark::State& state) { decode_set<dia::MSG, dia::encoded>(state); }
+BENCHMARK(BM_set_diameter);
+
+void BM_set_compound(benchmark::State& state) { decode_set<cmp::SET, cmp::encoded>(state); }
+BENCHMARK(BM_set_compound);
+
+} //end: namespace
@@ -0,0 +1,155 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <memory>
+
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+
+#include "med.hpp"
+#include "decode.hpp"
+#include "decoder_context.hpp"
+#include "octet_decoder.hpp"
+#include "tlv_index.hpp"
+
+namespace {
+
+template <typename ...T> using M = med::mandatory<T...>;
+template <typename ...T> using O = med::optional<T...>;
+
+//Diameter-like AVPs as in benchmark/set.cpp
+struct avp_flags : med::value<uint32_t, med::padding<uint32_t>>
+{
+	static constexpr value_type LEN_EXTRA = 8;
+	static constexpr value_type LEN_MASK = (1u << 24) - 1;
+	value_type get_length() const noexcept   { return (get_encoded() & LEN_MASK) - LEN_EXTRA; }
+	void set_length(value_type v) noexcept   { set_encoded((v + LEN_EXTRA) | (get_encoded() & ~LEN_MASK)); }
+};
+
+template <uint32_t CODE>
+struct avp : med::sequence<
+		M< avp_flags >,
+		M< med::value<uint32_t> >
+	>, med::add_meta_info<
+		med::add_tag<med::value<med::fixed<CODE, uint32_t>>>,
+		med::add_len<avp_flags>
+	>
+{
+	bool is_set() const { return this->template get<med::value<uint32_t>>().is_set(); }
+};
+
+constexpr std::size_t NUM_AVPS = 100;
+constexpr std::size_t NUM_CODES = 10;
+
+struct AVPS : med::set<
+	O< avp<1>, med::max<NUM_AVPS> >,
+	O< avp<2>, med::max<NUM_AVPS> >,
+	O< avp<3>, med::max<NUM_AVPS> >,
+	O< avp<4>, med::max<NUM_AVPS> >,
+	O< avp<5>, med::max<NUM_AVPS> >,
+	O< avp<6>, med::max<NUM_AVPS> >,
+	O< avp<7>, med::max<NUM_AVPS> >,
+	O< avp<8>, med::max<NUM_AVPS> >,
+	O< avp<9>, med::max<NUM_AVPS> >,
+	O< avp<10>, med::max<NUM_AVPS> >
+>{};
+
+//AVPs with explicit length are to be within a length
+struct MSG : med::sequence<
+	M< med::length_t<med::value<uint16_t>>, AVPS >
+>{};
+
+using avp_header = med::tlv_header<4, 3, med::padding<uint32_t>, 5, 8, true>;
+using index_t = med::tlv_index<avp_header, NUM_AVPS>;
+
+//2 octets of length then AVPs with codes round robin
+constexpr auto encoded = []
+{
+	constexpr std::size_t AVP_LEN = 12;
+	std::array<uint8_t, 2 + NUM_AVPS * AVP_LEN> buf{};
+	buf[0] = uint8_t((NUM_AVPS * AVP_LEN) >> 8);
+	buf[1] = uint8_t(NUM_AVPS * AVP_LEN);
+	for (std::size_t i = 0; i < NUM_AVPS; ++i)
+	{
+		uint8_t* p = buf.data() + 2 + i * AVP_LEN;
+		p[3] = uint8_t(i % NUM_CODES + 1);
+		p[4] = 0x40;
+		p[7] = AVP_LEN;
+		p[11] = uint8_t(i);
+	}
+	return buf;
+}();
+
+void BM_tlv_decode(benchmark::State& state)
+{
+	auto msg = std::make_unique<MSG>();
+	auto data = encoded; //not to fold decode of constant
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(data.data());
+		msg->clear();
+		med::decoder_context<> ctx{data.data(), data.size()};
+		decode(med::octet_decoder{ctx}, *msg);
+		benchmark::DoNotOptimize(msg.get());
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_tlv_decode);
+
+void BM_tlv_scan(benchmark::State& state)
+{
+	auto index = std::make_unique<index_t>();
+	auto data = encoded;
+	std::span<uint8_t const> const avps{data.data() + 2, data.size() - 2};
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(data.data());
+		benchmark::DoNotOptimize(index->scan(avps));
+	}
+}
+BENCHMARK(BM_tlv_scan);
+
+void BM_tlv_indexed(benchmark::State& state)
+{
+	auto msg = std::make_unique<AVPS>();
+	auto index = std::make_unique<index_t>();
+	auto data = encoded;
+	std::span<uint8_t const> const avps{data.data() + 2, data.size() - 2};
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(data.data());
+		msg->clear();
+		index->scan(avps);
+		med::decoder_context<> ctx{avps};
+		msg->decode_indexed(med::octet_decoder{ctx}, *index);
+		benchmark::DoNotOptimize(msg.get());
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_tlv_indexed);
+
+//only AVPs of interest are decoded, the rest is skipped
+void BM_tlv_indexed_subset(benchmark::State& state)
+{
+	auto msg = std::make_unique<AVPS>();
+	auto index = std::make_unique<index_t>();
+	auto data = encoded;
+	std::span<uint8_t const> const avps{data.data() + 2, data.size() - 2};
+
+	for (auto _ : state)
+	{
+		benchmark::DoNotOptimize(data.data());
+		msg->clear();
+		index->scan(avps);
+		index->remove_if([](auto const& tlv) { return tlv.tag != 1; });
+		med::decoder_context<> ctx{avps};
+		msg->decode_indexed(med::octet_decoder{ctx}, *index);
+		benchmark::DoNotOptimize(msg.get());
+		benchmark::ClobberMemory();
+	}
+}
+BENCHMARK(BM_tlv_indexed_subset);
+
+} //end: namespace
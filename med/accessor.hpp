@@ -23,8 +23,21 @@ FIELD const* get_field(IE const& ie)
 }
 
 //read-only access mandatory field returning a reference
-template <class FIELD, class IE> requires (!AMultiField<IE> && !AOptional<IE>)
+template <class FIELD, class IE> requires (!AMultiField<IE> && !AOptional<IE> && !APacked<IE>)
 FIELD const& get_field(IE const& ie)
+{
+	if constexpr (AStale<IE>)
+	{
+		//stale field of reused container reads as never set
+		static FIELD const unset{};
+		if (ie.stale()) { return unset; }
+	}
+	return ie;
+}
+
+//read-only access mandatory packed field returning a reference to keep its presence
+template <class FIELD, APacked IE> requires (!AOptional<IE>)
+IE const& get_field(IE const& ie)
 {
 	return ie;
 }
@@ -36,6 +49,14 @@ constexpr IE const& get_field(IE const& ie)
 	return ie;
 }
 
+//read-write access to field in container (stale field is reset first)
+template <class IE>
+constexpr IE& ref_field(IE& ie)
+{
+	if constexpr (AStale<IE>) { ie.refresh(); }
+	return ie;
+}
+
 namespace sl {
 
 template <class FIELD>
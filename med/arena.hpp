@@ -0,0 +1,235 @@
+/**
+@file
+growable arena of chained chunks from upstream memory resource
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace med {
+
+/**
+ * Bump allocator which grows by chunks from upstream memory resource.
+ * @details The initial space is either user-provided buffer or the 1st chunk
+ * taken from upstream on demand and kept till destruction. When exhausted
+ * the next chunk (twice the previous one) is taken from upstream up to the
+ * maximum total size. All additional chunks are returned on release.
+ */
+class arena
+{
+	struct alignas(std::max_align_t) chunk
+	{
+		chunk*      next;
+		std::size_t size;
+
+		uint8_t* data() noexcept                      { return reinterpret_cast<uint8_t*>(this + 1); }
+	};
+
+public:
+	static constexpr std::size_t DEFAULT_SIZE = 4096;
+	static constexpr std::size_t UNLIMITED = std::numeric_limits<std::size_t>::max();
+
+	arena(arena const&) = delete;
+	arena& operator=(arena const&) = delete;
+
+	/**
+	 * @param initial_size size of the 1st chunk taken from upstream
+	 * @param max_size limit of total size of all chunks
+	 * @param upstream resource to take chunks from
+	 */
+	explicit arena(std::size_t initial_size = DEFAULT_SIZE, std::size_t max_size = UNLIMITED
+			, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+		: m_upstream{upstream}, m_chunk_size{initial_size}, m_next_size{initial_size}, m_max_size{max_size}
+	{}
+
+	/**
+	 * @param data start of initial buffer
+	 * @param size size of initial buffer
+	 * @param max_size limit of total size incl. initial buffer
+	 * @param upstream resource to take chunks from
+	 */
+	arena(void* data, std::size_t size, std::size_t max_size = UNLIMITED
+			, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+		: m_start{static_cast<uint8_t*>(data)}, m_initial{size}
+		, m_upstream{upstream}, m_chunk_size{size ? size : DEFAULT_SIZE}, m_next_size{m_chunk_size}, m_max_size{max_size}
+	{
+		release();
+	}
+
+	template <typename T, std::size_t SIZE>
+	explicit arena(T (&data)[SIZE], std::size_t max_size = UNLIMITED
+			, std::pmr::memory_resource* upstream = std::pmr::get_default_resource()) noexcept
+		: arena(data, SIZE * sizeof(T), max_size, upstream)
+	{}
+
+	~arena()
+	{
+		free_chunks();
+		if (m_own) { deallocate(m_own); }
+	}
+
+	[[nodiscard]]
+	void* allocate(std::size_t bytes, std::size_t alignment) noexcept
+	{
+		if (void* p = bump(bytes, alignment)) { return p; }
+		return grow(bytes, alignment);
+	}
+
+	/**
+	 * Returns additional chunks to upstream and resets to the initial space
+	 */
+	void release() noexcept
+	{
+		free_chunks();
+		m_begin = m_start;
+		m_size = m_initial;
+		m_total = m_initial;
+		m_next_size = m_chunk_size;
+	}
+
+	//total size of initial space and chunks
+	std::size_t capacity() const noexcept             { return m_total; }
+	//number of additional chunks
+	std::size_t num_chunks() const noexcept
+	{
+		std::size_t num = 0;
+		for (auto* p = m_chunks; p; p = p->next) { ++num; }
+		return num;
+	}
+	std::pmr::memory_resource* upstream() const noexcept  { return m_upstream; }
+
+private:
+	void* bump(std::size_t bytes, std::size_t alignment) noexcept
+	{
+		auto const addr = reinterpret_cast<uintptr_t>(m_begin);
+		auto const pad = (alignment - (addr & (alignment - 1))) & (alignment - 1);
+		if (pad + bytes > m_size) { return nullptr; }
+		m_begin = reinterpret_cast<uint8_t*>(addr + pad + bytes);
+		m_size -= pad + bytes;
+		return reinterpret_cast<void*>(addr + pad);
+	}
+
+	void* grow(std::size_t bytes, std::size_t alignment) noexcept
+	{
+		auto const need = bytes + alignment;
+		if (m_total > m_max_size || need > m_max_size - m_total) { return nullptr; }
+		auto const size = std::min(std::max(m_next_size, need), m_max_size - m_total);
+
+		chunk* c;
+		try
+		{
+			c = static_cast<chunk*>(m_upstream->allocate(sizeof(chunk) + size, alignof(chunk)));
+		}
+		catch (std::bad_alloc const&)
+		{
+			return nullptr;
+		}
+		c->size = size;
+		m_total += size;
+		if (nullptr == m_start)
+		{
+			//initial space is kept on release
+			c->next = nullptr;
+			m_own = c;
+			m_start = c->data();
+			m_initial = size;
+		}
+		else
+		{
+			c->next = m_chunks;
+			m_chunks = c;
+			if (m_next_size <= UNLIMITED / 2) { m_next_size *= 2; }
+		}
+		m_begin = c->data();
+		m_size = size;
+		return bump(bytes, alignment);
+	}
+
+	void deallocate(chunk* c) noexcept                { m_upstream->deallocate(c, sizeof(chunk) + c->size, alignof(chunk)); }
+
+	void free_chunks() noexcept
+	{
+		for (auto* p = m_chunks; p; )
+		{
+			auto* next = p->next;
+			deallocate(p);
+			p = next;
+		}
+		m_chunks = nullptr;
+	}
+
+	uint8_t*    m_begin {nullptr};
+	std::size_t m_size {0};
+	uint8_t*    m_start {nullptr};
+	std::size_t m_initial {0};
+	std::size_t m_total {0};
+	chunk*      m_own {nullptr};     //initial space from upstream
+	chunk*      m_chunks {nullptr};  //additional chunks (the last one first)
+	std::pmr::memory_resource* m_upstream;
+	std::size_t m_chunk_size;        //initial size of additional chunk
+	std::size_t m_next_size;
+	std::size_t m_max_size;
+};
+
+#if defined(__linux__)
+/**
+ * Memory resource of huge pages via mmap (falls back to regular pages hinted
+ * for transparent huge pages when no huge pages are reserved in the system).
+ * NOTE: each allocation takes whole pages thus it's meant as upstream of arena.
+ */
+class hugepage_resource : public std::pmr::memory_resource
+{
+public:
+	static constexpr std::size_t PAGE_SIZE = 2 << 20;
+
+	static hugepage_resource* instance() noexcept
+	{
+		static hugepage_resource res;
+		return &res;
+	}
+
+private:
+	static constexpr std::size_t round_up(std::size_t bytes) noexcept
+	{
+		return (bytes + PAGE_SIZE - 1) & ~(PAGE_SIZE - 1);
+	}
+
+	void* do_allocate(std::size_t bytes, std::size_t) override
+	{
+		auto const size = round_up(bytes);
+		void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+		if (MAP_FAILED == p)
+		{
+			p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (MAP_FAILED == p) { throw std::bad_alloc{}; }
+			::madvise(p, size, MADV_HUGEPAGE);
+		}
+		return p;
+	}
+
+	void do_deallocate(void* p, std::size_t bytes, std::size_t) override
+	{
+		::munmap(p, round_up(bytes));
+	}
+
+	bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+	{
+		return this == &other;
+	}
+};
+#endif
+
+} //end: namespace med
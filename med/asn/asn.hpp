@@ -31,6 +31,29 @@ using null = null_t<traits<tg_value::NULL_TYPE>>;
 //NOTE! ASN assumes the integer is signed! don't use unsigned ever
 using integer = value_t<int, traits<tg_value::INTEGER>>;
 
+//X.680 51.4 value range constraint as an extended trait of integral value
+//NOTE: is ignored by BER but defines the size of encoded value in PER/OER
+template <std::intmax_t LB, std::intmax_t UB>
+struct range
+{
+	static_assert(LB <= UB, "LOWER BOUND EXCEEDS UPPER ONE");
+	static constexpr std::intmax_t lower_bound = LB;
+	static constexpr std::intmax_t upper_bound = UB;
+};
+
+template <class T>
+concept AConstrained = requires
+{
+	{ T::traits::lower_bound } -> std::convertible_to<std::intmax_t>;
+	{ T::traits::upper_bound } -> std::convertible_to<std::intmax_t>;
+};
+
+//INTEGER (LB..UB)
+template <std::intmax_t LB, std::intmax_t UB, class... ASN_TRAITS>
+struct ranged_t : value<int, range<LB, UB>>, add_meta_info<add_tag<ASN_TRAITS>...>{};
+template <std::intmax_t LB, std::intmax_t UB>
+using ranged = ranged_t<LB, UB, traits<tg_value::INTEGER>>;
+
 template <class... ASN_TRAITS>
 using enumerated_t = value_t<int, ASN_TRAITS...>;
 using enumerated = enumerated_t<traits<tg_value::ENUMERATED>>;
@@ -142,6 +165,65 @@ constexpr subid_t oid_make_1st(uint8_t root, subid_t subroot)
 	return root * OID_ROOT_FACTOR + subroot;
 }
 
+//number of octets to encode a non-negative-binary-integer (at least 1)
+constexpr uint8_t unsigned_octets(std::uint64_t v)
+{
+	uint8_t n = 1;
+	for (v >>= 8; v; v >>= 8) { ++n; }
+	return n;
+}
+
+//number of octets to encode a 2's-complement-binary-integer (at least 1)
+constexpr uint8_t signed_octets(std::int64_t v)
+{
+	uint8_t n = 1;
+	for (; v < -128 || v > 127; v >>= 8) { ++n; }
+	return n;
+}
+
+//size constraint of strings and sequence-of in octets, bits or elements
+template <class IE>
+struct size_bounds;
+
+template <AMultiField IE>
+struct size_bounds<IE>
+{
+	static constexpr std::size_t lower = IE::min;
+	static constexpr std::size_t upper = IE::max;
+};
+
+template <class IE> requires (!AMultiField<IE> && std::is_same_v<IE_OCTET_STRING, typename IE::ie_type>)
+struct size_bounds<IE>
+{
+	static constexpr std::size_t lower = IE::traits::min_octets;
+	static constexpr std::size_t upper = IE::traits::max_octets;
+};
+
+template <class IE> requires (!AMultiField<IE> && std::is_same_v<IE_BIT_STRING, typename IE::ie_type>)
+struct size_bounds<IE>
+{
+	static constexpr std::size_t lower = IE::traits::min_bits;
+	static constexpr std::size_t upper = IE::traits::max_bits;
+};
+
+struct is_mandatory
+{
+	template <class T>
+	static constexpr bool value = !AOptional<T>;
+};
+
+//number of optional IEs in the list (bits in preamble)
+template <class IES>
+constexpr std::size_t num_optionals = meta::list_size_v<meta::remove_if_t<IES, is_mandatory>>;
+
+//index of IE among the optional ones in the list (bit number in preamble)
+template <class IE, class IES>
+constexpr std::size_t optional_index = meta::list_index_of_v<IE, meta::remove_if_t<IES, is_mandatory>>;
+
+//ENUMERATED is an integer with own universal tag
+template <class IE>
+constexpr bool is_enumerated = meta::count_v<get_meta_info_t<IE>, add_tag<traits<tg_value::ENUMERATED>>> > 0;
+
 } //end: namespace detail
 
 //OID has at least 2 components
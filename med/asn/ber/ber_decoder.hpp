@@ -54,6 +54,7 @@ struct decoder : info
 	auto operator() (GET_STATE)                 { return get_context().buffer().get_state(); }
 	template <class IE>
 	bool operator() (CHECK_STATE, IE const&)    { return !get_context().buffer().empty(); }
+	void operator() (ADVANCE_STATE ss)          { get_context().buffer().template advance<ADVANCE_STATE>(ss.delta); }
 
 	//IE_TAG
 	template <class IE> [[nodiscard]] std::size_t operator() (IE&, IE_TAG)
@@ -64,6 +65,17 @@ struct decoder : info
 		CODEC_TRACE("T=%zX [%s] %zu bits: %s", vtag, name<IE>(), IE::traits::bits, get_context().buffer().toString());
 		return vtag;
 	}
+	//tag w/o consuming (its size is known upfront)
+	template <class IE> std::size_t operator() (PEEK_TAG, IE&, std::size_t& tag)
+	{
+		constexpr std::size_t NUM_BYTES = bits_to_bytes(IE::traits::bits);
+		auto& buf = get_context().buffer();
+		if (buf.empty()) { return 0; }
+		if (buf.size() < NUM_BYTES) { MED_THROW_EXCEPTION(overflow, name<IE>(), NUM_BYTES, buf) }
+		tag = get_bytes<NUM_BYTES>(buf.begin());
+		CODEC_TRACE("peek T=%zX [%s]: %s", tag, name<IE>(), buf.toString());
+		return NUM_BYTES;
+	}
 	//IE_LEN
 	template <class IE> void operator() (IE& ie, IE_LEN)
 	{
@@ -157,7 +169,7 @@ struct decoder : info
 	{
 		auto const len = get_context().buffer().size();
 		CODEC_TRACE("\tOSTR[%s] %zu octets: %s", name<IE>(), len, get_context().buffer().toString());
-		if (ie.set_encoded(len, get_context().buffer().begin()))
+		if (ie.set_encoded(len, get_context().buffer().begin(), *this))
 		{
 			get_context().buffer().template advance<IE>(len);
 		}
@@ -10,6 +10,7 @@ Distributed under the MIT License
 #include "debug.hpp"
 #include "name.hpp"
 #include "state.hpp"
+#include "bytes.hpp"
 #include "octet_string.hpp"
 #include "ber_tag.hpp"
 #include "ber_length.hpp"
@@ -0,0 +1,353 @@
+#pragma once
+/**
+@file
+ASN.1 OER decoder definition
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include "debug.hpp"
+#include "name.hpp"
+#include "bytes.hpp"
+#include "count.hpp"
+#include "decode.hpp"
+#include "choice.hpp"
+#include "octet_string.hpp"
+#include "bit_string.hpp"
+#include "oer_info.hpp"
+
+namespace med::asn::oer {
+
+template <class DEC_CTX>
+struct decoder : info
+{
+	using state_type = typename DEC_CTX::buffer_type::state_type;
+	using size_state = typename DEC_CTX::buffer_type::size_state;
+	using allocator_type = typename DEC_CTX::allocator_type;
+
+	explicit decoder(DEC_CTX& ctx_) : m_ctx{ ctx_ } { }
+	DEC_CTX& get_context() noexcept             { return m_ctx; }
+	allocator_type& get_allocator()             { return get_context().get_allocator(); }
+
+	//OER has no tags and lengths of components thus containers are decoded here
+	struct container_decoder
+	{
+		template <class IE>
+		void operator()(decoder& me, IE& ie)    { me.decode_container(ie); }
+	};
+
+	//IE_NULL
+	template <class IE> constexpr void operator() (IE&, IE_NULL) const
+	{
+	}
+
+	//IE_VALUE
+	template <class IE> void operator() (IE& ie, IE_VALUE)
+	{
+		if constexpr (AMultiField<IE>)
+		{
+			decode_multi(ie);
+		}
+		else
+		{
+			using value_type = typename IE::value_type;
+			if constexpr (std::is_same_v<bool, value_type>)
+			{
+				//X.696 9 Encoding of boolean values
+				ie.set_encoded(0 != get_context().buffer().template pop<IE>());
+				CODEC_TRACE("BOOL[%s]=%d: %s", name<IE>(), ie.get_encoded(), get_context().buffer().toString());
+			}
+			else if constexpr (std::is_integral_v<value_type>)
+			{
+				if constexpr (detail::is_enumerated<IE>)
+				{
+					//X.696 11 Encoding of enumerated values
+					uint8_t const v = get_context().buffer().template pop<IE>();
+					if (0 == (v & detail::LONG_LEN))
+					{
+						ie.set_encoded(value_type(v));
+					}
+					else
+					{
+						ie.set_encoded(get_int<IE, value_type>(v & ~detail::LONG_LEN));
+					}
+				}
+				else if constexpr (AConstrained<IE>)
+				{
+					//X.696 fixed-size unsigned or 2's complement
+					constexpr std::intmax_t lb = IE::traits::lower_bound;
+					constexpr std::intmax_t ub = IE::traits::upper_bound;
+					constexpr auto num_octets = detail::fixed_octets(lb, ub);
+					auto* in = get_context().buffer().template advance<IE, num_octets>();
+					std::intmax_t v;
+					if constexpr (lb >= 0)
+					{
+						v = std::intmax_t(get_bytes<num_octets, std::uint64_t>(in));
+					}
+					else
+					{
+						v = sign_extend(get_bytes<num_octets, std::uint64_t>(in), 8 * num_octets);
+					}
+					if (v < lb || v > ub)
+					{
+						MED_THROW_EXCEPTION(invalid_value, name<IE>(), std::size_t(v), get_context().buffer())
+					}
+					ie.set_encoded(value_type(v));
+				}
+				else
+				{
+					//X.696 semi-constrained unsigned or unconstrained 2's complement
+					ie.set_encoded(get_int<IE, value_type>(get_length<IE>()));
+				}
+				CODEC_TRACE("INT[%s]=%lld: %s", name<IE>(), (long long)ie.get_encoded(), get_context().buffer().toString());
+			}
+			else
+			{
+				static_assert(std::is_void_v<value_type>, "NOT IMPLEMENTED?");
+			}
+		}
+	}
+
+	//IE_BIT_STRING
+	template <class IE> void operator() (IE& ie, IE_BIT_STRING)
+	{
+		//X.696 Encoding of bitstring values
+		std::size_t num_bits;
+		if constexpr (detail::is_fixed_size<IE>)
+		{
+			num_bits = detail::size_bounds<IE>::lower;
+		}
+		else
+		{
+			//length determinant then initial octet with number of unused bits
+			auto const len = get_length<IE>();
+			uint8_t const unused = len ? get_context().buffer().template pop<IE>() : 0xFF;
+			if (unused > 7 || (len == 1 && unused))
+			{
+				MED_THROW_EXCEPTION(invalid_value, name<IE>(), unused, get_context().buffer())
+			}
+			num_bits = 8 * (len - 1) - unused;
+		}
+
+		auto* data = get_context().buffer().template advance<IE>(bits_to_bytes(num_bits));
+		if (not ie.set_encoded(num_bits, data))
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), num_bits, get_context().buffer())
+		}
+		CODEC_TRACE("BSTR[%s] %zu bits: %s", name<IE>(), num_bits, get_context().buffer().toString());
+	}
+
+	//IE_OCTET_STRING
+	template <class IE> void operator() (IE& ie, IE_OCTET_STRING)
+	{
+		//X.696 Encoding of octetstring values
+		std::size_t len;
+		if constexpr (detail::is_fixed_size<IE>)
+		{
+			len = detail::size_bounds<IE>::lower;
+		}
+		else
+		{
+			len = get_length<IE>();
+		}
+
+		if (not ie.set_encoded(len, get_context().buffer().template advance<IE>(len), *this))
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), len, get_context().buffer())
+		}
+		CODEC_TRACE("OSTR[%s] %zu octets: %s", name<IE>(), len, get_context().buffer().toString());
+	}
+
+#ifndef UNIT_TEST
+private:
+#endif
+	struct seq_dec
+	{
+		template <class IE, class SEQ>
+		static void apply(SEQ& seq, uint8_t const* preamble, decoder& me)
+		{
+			using field_t = get_field_type_t<IE>;
+			if constexpr (AOptional<IE>)
+			{
+				constexpr auto bit = detail::optional_index<IE, typename SEQ::ies_types>;
+				if (0 == (preamble[bit / 8] & (0x80 >> (bit % 8))))
+				{
+					CODEC_TRACE("SEQ[%s] skip absent %s", name<SEQ>(), name<field_t>());
+					return;
+				}
+			}
+
+			if constexpr (AMultiField<IE>)
+			{
+				me.decode_multi(seq.template ref<field_t>());
+			}
+			else
+			{
+				med::decode(me, seq.template ref<field_t>());
+			}
+		}
+	};
+
+	struct choice_dec
+	{
+		template <class IE, class CHOICE>
+		static constexpr bool check(CHOICE const&, std::size_t tag, decoder&)
+		{
+			using alt_tag = detail::outer_tag<get_field_type_t<IE>>;
+			return tag == make_tag(uint8_t(alt_tag::AsnTagClass), alt_tag::AsnTagValue);
+		}
+
+		template <class IE, class CHOICE>
+		static void apply(CHOICE& ie, std::size_t, decoder& me)
+		{
+			med::decode(me, ie.template ref<get_field_type_t<IE>>(me));
+		}
+
+		template <class CHOICE>
+		static void apply(CHOICE&, std::size_t tag, decoder& me)
+		{
+			MED_THROW_EXCEPTION(unknown_tag, name<CHOICE>(), tag, me.get_context().buffer())
+		}
+	};
+
+	template <class IE>
+	void decode_container(IE& ie)
+	{
+		if constexpr (AMultiField<IE>)
+		{
+			decode_multi(ie);
+		}
+		else if constexpr (std::is_same_v<IE_CHOICE, typename IE::ie_type>)
+		{
+			//X.696 Encoding of choice values
+			ie.clear();
+			auto const tag = get_tag<IE>();
+			CODEC_TRACE("CHOICE[%s] tag=%zX: %s", name<IE>(), tag, get_context().buffer().toString());
+			meta::for_if<typename IE::ies_types>(choice_dec{}, ie, tag, *this);
+		}
+		else
+		{
+			//X.696 Encoding of sequence values
+			//X.696 Encoding of set values (components are expected in canonical order)
+			using ies = typename IE::ies_types;
+			constexpr std::size_t num_opts = detail::num_optionals<ies>;
+			uint8_t const* preamble = nullptr;
+			if constexpr (num_opts > 0)
+			{
+				preamble = get_context().buffer().template advance<IE, (num_opts + 7) / 8>();
+			}
+			CODEC_TRACE("SEQ[%s] preamble of %zu: %s", name<IE>(), num_opts, get_context().buffer().toString());
+			meta::foreach<ies>(seq_dec{}, ie, preamble, *this);
+		}
+	}
+
+	template <class IE>
+	void decode_multi(IE& ie)
+	{
+		//X.696 Encoding of sequence-of values: quantity field then occurrences
+		auto const num_octets = get_context().buffer().template pop<IE>();
+		if (0 == num_octets || num_octets > sizeof(std::size_t))
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), num_octets, get_context().buffer())
+		}
+		auto const count = get_uint<IE>(num_octets);
+		CODEC_TRACE("SEQOF[%s] *%zu: %s", name<IE>(), count, get_context().buffer().toString());
+		check_arity(*this, ie, count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			auto* field = ie.push_back(*this);
+			med::decode(*this, *field);
+		}
+	}
+
+	//X.696 8.6 Length determinant
+	template <class IE>
+	std::size_t get_length()
+	{
+		uint8_t const len = get_context().buffer().template pop<IE>();
+		if (0 == (len & detail::LONG_LEN))
+		{
+			return len;
+		}
+		//long form
+		uint8_t const num_octets = len & ~detail::LONG_LEN;
+		if (0 == num_octets || num_octets > sizeof(std::size_t))
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), len, get_context().buffer())
+		}
+		return get_uint<IE>(num_octets);
+	}
+
+	//X.696 8.7 Encoding of tags (class in 2 MSBs followed by number)
+	static constexpr std::size_t make_tag(uint8_t cls, std::size_t num)
+	{
+		return (num << 2) | cls;
+	}
+
+	template <class IE>
+	std::size_t get_tag()
+	{
+		auto& buf = get_context().buffer();
+		uint8_t const v = buf.template pop<IE>();
+		std::size_t num = v & 0x3F;
+		if (0x3F == num)
+		{
+			num = 0;
+			uint8_t b;
+			do
+			{
+				if (num >> (8 * sizeof(num) - 7))
+				{
+					MED_THROW_EXCEPTION(invalid_value, name<IE>(), num, buf)
+				}
+				b = buf.template pop<IE>();
+				num = (num << 7) | (b & 0x7F);
+			}
+			while (b & 0x80);
+		}
+		return make_tag(v >> 6, num);
+	}
+
+	static std::intmax_t sign_extend(std::uint64_t v, std::size_t num_bits)
+	{
+		if (num_bits < 64 && (v >> (num_bits - 1))) { v |= ~std::uint64_t(0) << num_bits; }
+		return std::intmax_t(v);
+	}
+
+	template <class IE>
+	std::uint64_t get_uint(std::size_t num_octets)
+	{
+		auto* in = get_context().buffer().template advance<IE>(num_octets);
+		std::uint64_t v = 0;
+		for (std::size_t i = 0; i < num_octets; ++i) { v = (v << 8) | in[i]; }
+		return v;
+	}
+
+	//variable size integer of given number of octets
+	template <class IE, typename T>
+	T get_int(std::size_t num_octets)
+	{
+		if (0 == num_octets || num_octets > sizeof(T))
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), num_octets, get_context().buffer())
+		}
+		auto const v = get_uint<IE>(num_octets);
+		if constexpr (std::is_signed_v<T>)
+		{
+			return static_cast<T>(sign_extend(v, 8 * num_octets));
+		}
+		else
+		{
+			return static_cast<T>(v);
+		}
+	}
+
+	DEC_CTX& m_ctx;
+};
+
+template <class C>
+explicit decoder(C&) -> decoder<C>;
+
+}	//end: namespace med::asn::oer
@@ -0,0 +1,328 @@
+#pragma once
+/**
+@file
+ASN.1 OER encoder definition
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+#include <cstring>
+
+#include "debug.hpp"
+#include "name.hpp"
+#include "bytes.hpp"
+#include "count.hpp"
+#include "encode.hpp"
+#include "choice.hpp"
+#include "octet_string.hpp"
+#include "bit_string.hpp"
+#include "oer_info.hpp"
+
+
+namespace med::asn::oer {
+
+template <class ENC_CTX>
+struct encoder : info
+{
+	using state_type = typename ENC_CTX::buffer_type::state_type;
+	using allocator_type = typename ENC_CTX::allocator_type;
+
+	explicit encoder(ENC_CTX& ctx_) : m_ctx{ ctx_ } { }
+	ENC_CTX& get_context() noexcept                   { return m_ctx; }
+	allocator_type& get_allocator()                   { return get_context().get_allocator(); }
+
+	//OER has no tags and lengths of components thus containers are encoded here
+	struct container_encoder
+	{
+		template <class IE>
+		void operator()(encoder& me, IE const& ie)    { me.encode_container(ie); }
+	};
+
+	//IE_NULL
+	template <class IE> constexpr void operator() (IE const&, IE_NULL) const
+	{
+		//X.696 Encoding of the null type: no octets
+	}
+
+	//IE_VALUE
+	template <class IE> void operator() (IE const& ie, IE_VALUE)
+	{
+		if constexpr (AMultiField<IE>)
+		{
+			encode_multi(ie);
+		}
+		else
+		{
+			using value_type = typename IE::value_type;
+			if constexpr (std::is_same_v<bool, value_type>)
+			{
+				//X.696 9 Encoding of boolean values
+				get_context().buffer().template push<IE>(ie.get_encoded() ? 0xFF : 0x00);
+				CODEC_TRACE("BOOL[%s]=%d: %s", name<IE>(), ie.get_encoded(), get_context().buffer().toString());
+			}
+			else if constexpr (std::is_integral_v<value_type>)
+			{
+				auto const v = ie.get_encoded();
+				if constexpr (detail::is_enumerated<IE>)
+				{
+					//X.696 11 Encoding of enumerated values
+					if (v >= 0 && v < 0x80)
+					{
+						//short form
+						get_context().buffer().template push<IE>(uint8_t(v));
+					}
+					else
+					{
+						//long form: number of octets then 2's complement value
+						auto const num_octets = detail::signed_octets(v);
+						get_context().buffer().template push<IE>(detail::LONG_LEN | num_octets);
+						put_uint<IE>(std::uint64_t(v), num_octets);
+					}
+				}
+				else if constexpr (AConstrained<IE>)
+				{
+					//X.696 fixed-size unsigned or 2's complement
+					constexpr std::intmax_t lb = IE::traits::lower_bound;
+					constexpr std::intmax_t ub = IE::traits::upper_bound;
+					if (std::intmax_t(v) < lb || std::intmax_t(v) > ub)
+					{
+						MED_THROW_EXCEPTION(invalid_value, name<IE>(), std::size_t(v), get_context().buffer())
+					}
+					constexpr auto num_octets = detail::fixed_octets(lb, ub);
+					put_bytes<num_octets>(std::size_t(v), get_context().buffer().template advance<IE, num_octets>());
+				}
+				else
+				{
+					//X.696 semi-constrained unsigned or unconstrained 2's complement
+					uint8_t const num_octets = std::is_signed_v<value_type>
+						? detail::signed_octets(v) : detail::unsigned_octets(v);
+					put_length<IE>(num_octets);
+					put_uint<IE>(std::uint64_t(v), num_octets);
+				}
+				CODEC_TRACE("INT[%s]=%lld: %s", name<IE>(), (long long)v, get_context().buffer().toString());
+			}
+			else
+			{
+				static_assert(std::is_void_v<value_type>, "NOT IMPLEMENTED?");
+			}
+		}
+	}
+
+	//IE_BIT_STRING
+	template <class IE> void operator() (IE const& ie, IE_BIT_STRING)
+	{
+		//X.696 Encoding of bitstring values
+		auto const num_bits = std::size_t(ie.get().num_of_bits());
+		auto const num_octets = bits_to_bytes(num_bits);
+		uint8_t const unused = uint8_t(8 * num_octets - num_bits);
+		if constexpr (not detail::is_fixed_size<IE>)
+		{
+			//length determinant then initial octet with number of unused bits
+			put_length<IE>(num_octets + 1);
+			get_context().buffer().template push<IE>(unused);
+		}
+		put_octets<IE>(ie.data(), num_octets);
+		//unused trailing bits are set to zero
+		if (unused) { get_context().buffer().begin()[-1] &= uint8_t(0xFF << unused); }
+		CODEC_TRACE("BSTR[%s] %zu bits: %s", name<IE>(), num_bits, get_context().buffer().toString());
+	}
+
+	//IE_OCTET_STRING
+	template <class IE> void operator() (IE const& ie, IE_OCTET_STRING)
+	{
+		//X.696 Encoding of octetstring values
+		auto const len = ie.size();
+		if constexpr (not detail::is_fixed_size<IE>)
+		{
+			put_length<IE>(len);
+		}
+		put_octets<IE>(ie.data(), len);
+		CODEC_TRACE("OSTR[%s] %zu octets: %s", name<IE>(), len, get_context().buffer().toString());
+	}
+
+#ifndef UNIT_TEST
+private:
+#endif
+	template <class IE, class SEQ>
+	static bool is_present(SEQ const& seq)
+	{
+		using field_t = get_field_type_t<IE>;
+		if constexpr (AMultiField<IE>)
+		{
+			return not seq.template get<field_t>().empty();
+		}
+		else
+		{
+			return nullptr != seq.template get<field_t>();
+		}
+	}
+
+	//X.696 presence bit-map of OPTIONAL and DEFAULT components
+	struct seq_preamble
+	{
+		template <class IE, class SEQ>
+		static void apply(SEQ const& seq, uint8_t* preamble)
+		{
+			if constexpr (AOptional<IE>)
+			{
+				constexpr auto bit = detail::optional_index<IE, typename SEQ::ies_types>;
+				if (is_present<IE>(seq)) { preamble[bit / 8] |= uint8_t(0x80 >> (bit % 8)); }
+			}
+		}
+	};
+
+	struct seq_enc
+	{
+		template <class IE, class SEQ>
+		static void apply(SEQ const& seq, encoder& me)
+		{
+			using field_t = get_field_type_t<IE>;
+			if constexpr (AMultiField<IE>)
+			{
+				auto const& ie = seq.template get<field_t>();
+				if (AMandatory<IE> || not ie.empty()) { me.encode_multi(ie); }
+			}
+			else if constexpr (AOptional<IE>)
+			{
+				if (auto const* pie = seq.template get<field_t>()) { med::encode(me, *pie); }
+			}
+			else
+			{
+				auto const& ie = seq.template get<field_t>();
+				if (not ie.is_set())
+				{
+					MED_THROW_EXCEPTION(missing_ie, name<field_t>(), 1, 0, me.get_context().buffer())
+				}
+				med::encode(me, ie);
+			}
+		}
+	};
+
+	struct choice_enc : sl::choice_if
+	{
+		template <class IE, class CHOICE>
+		static void apply(CHOICE const& ie, encoder& me)
+		{
+			using field_t = get_field_type_t<IE>;
+			me.template put_tag<field_t>();
+			med::encode(me, *ie.template get<field_t>());
+		}
+
+		template <class CHOICE>
+		static void apply(CHOICE const& ie, encoder& me)
+		{
+			MED_THROW_EXCEPTION(unknown_tag, name<CHOICE>(), ie.index(), me.get_context().buffer())
+		}
+	};
+
+	template <class IE>
+	void encode_container(IE const& ie)
+	{
+		if constexpr (AMultiField<IE>)
+		{
+			encode_multi(ie);
+		}
+		else if constexpr (std::is_same_v<IE_CHOICE, typename IE::ie_type>)
+		{
+			//X.696 Encoding of choice values: outermost tag of the alternative then its value
+			if (not ie.is_set())
+			{
+				MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0, get_context().buffer())
+			}
+			meta::for_if<typename IE::ies_types>(choice_enc{}, ie, *this);
+		}
+		else
+		{
+			//X.696 Encoding of sequence values
+			//X.696 Encoding of set values (components are expected in canonical order)
+			using ies = typename IE::ies_types;
+			constexpr std::size_t num_opts = detail::num_optionals<ies>;
+			if constexpr (num_opts > 0)
+			{
+				constexpr std::size_t num_octets = (num_opts + 7) / 8;
+				auto* preamble = get_context().buffer().template advance<IE, num_octets>();
+				std::memset(preamble, 0, num_octets);
+				meta::foreach<ies>(seq_preamble{}, ie, preamble);
+			}
+			CODEC_TRACE("SEQ[%s] preamble of %zu: %s", name<IE>(), num_opts, get_context().buffer().toString());
+			meta::foreach<ies>(seq_enc{}, ie, *this);
+		}
+	}
+
+	template <class IE>
+	void encode_multi(IE const& ie)
+	{
+		//X.696 Encoding of sequence-of values: quantity field then occurrences
+		check_arity(*this, ie);
+		auto const count = ie.count();
+		auto const num_octets = detail::unsigned_octets(count);
+		get_context().buffer().template push<IE>(num_octets);
+		put_uint<IE>(count, num_octets);
+		CODEC_TRACE("SEQOF[%s] *%zu: %s", name<IE>(), count, get_context().buffer().toString());
+		for (auto& field : ie) { med::encode(*this, field); }
+	}
+
+	//X.696 8.6 Length determinant
+	template <class IE>
+	void put_length(std::size_t len)
+	{
+		if (len < detail::LONG_LEN)
+		{
+			//short form
+			get_context().buffer().template push<IE>(uint8_t(len));
+		}
+		else
+		{
+			//long form
+			auto const num_octets = detail::unsigned_octets(len);
+			get_context().buffer().template push<IE>(detail::LONG_LEN | num_octets);
+			put_uint<IE>(len, num_octets);
+		}
+	}
+
+	//X.696 8.7 Encoding of tags
+	template <class IE>
+	void put_tag()
+	{
+		using tag = detail::outer_tag<IE>;
+		constexpr uint8_t cls = uint8_t(tag::AsnTagClass) << 6;
+		auto& buf = get_context().buffer();
+		if constexpr (tag::AsnTagValue < 0x3F)
+		{
+			buf.template push<IE>(cls | uint8_t(tag::AsnTagValue));
+		}
+		else
+		{
+			buf.template push<IE>(cls | 0x3F);
+			constexpr std::size_t num = tag::AsnTagValue;
+			constexpr uint8_t num_octets = [](){ uint8_t n = 1; for (auto v = num >> 7; v; v >>= 7) { ++n; } return n; }();
+			auto* out = buf.template advance<IE, num_octets>();
+			for (uint8_t i = 0; i < num_octets; ++i)
+			{
+				out[i] = uint8_t((num >> (7 * (num_octets - i - 1))) & 0x7F) | (i + 1 < num_octets ? 0x80 : 0);
+			}
+		}
+	}
+
+	template <class IE>
+	void put_uint(std::uint64_t v, uint8_t num_octets)
+	{
+		auto* out = get_context().buffer().template advance<IE>(num_octets);
+		for (auto i = num_octets; i; v >>= 8) { out[--i] = uint8_t(v); }
+	}
+
+	template <class IE>
+	void put_octets(uint8_t const* data, std::size_t len)
+	{
+		auto* out = get_context().buffer().template advance<IE>(len);
+		if (len) { std::memcpy(out, data, len); }
+	}
+
+	ENC_CTX& m_ctx;
+};
+
+template <class C>
+explicit encoder(C&) -> encoder<C>;
+
+}	//end: namespace med::asn::oer
@@ -0,0 +1,75 @@
+#pragma once
+/**
+@file
+ASN.1 OER common definitions
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "../asn.hpp"
+
+namespace med::asn::oer {
+
+namespace detail {
+
+using asn::detail::unsigned_octets;
+using asn::detail::signed_octets;
+using asn::detail::size_bounds;
+using asn::detail::num_optionals;
+using asn::detail::optional_index;
+using asn::detail::is_enumerated;
+
+//X.696 long form of length determinant has bit 8 of 1st octet set
+constexpr uint8_t LONG_LEN = 0x80;
+
+/* X.696 number of octets of a fixed-size integer given its value range
+NOTE: any range of intmax_t fits into one of the fixed sizes thus no length is encoded
+*/
+constexpr uint8_t fixed_octets(std::intmax_t lb, std::intmax_t ub)
+{
+	if (lb >= 0)
+	{
+		if (ub <= std::numeric_limits<uint8_t>::max()) return 1;
+		if (ub <= std::numeric_limits<uint16_t>::max()) return 2;
+		if (ub <= std::numeric_limits<uint32_t>::max()) return 4;
+	}
+	else
+	{
+		auto const fits = [lb, ub]<typename T>(T)
+		{
+			return lb >= std::numeric_limits<T>::min() && ub <= std::numeric_limits<T>::max();
+		};
+		if (fits(int8_t{})) return 1;
+		if (fits(int16_t{})) return 2;
+		if (fits(int32_t{})) return 4;
+	}
+	return 8;
+}
+
+//X.696 size of strings is not encoded when fixed by constraint
+template <class IE>
+constexpr bool is_fixed_size = size_bounds<IE>::lower == size_bounds<IE>::upper;
+
+//X.696 8.7 class and number of the outermost tag
+template <class IE>
+using outer_tag = get_info_t<meta::list_first_t<get_meta_info_t<IE>>>;
+
+} //end: namespace detail
+
+struct info
+{
+	//OER encodes no tags and lengths of IEs except for the ones defined by rules
+	template <class IE>
+	static constexpr auto produce_meta_info()
+	{
+		return meta::wrap<meta::typelist<>>{};
+	}
+};
+
+} //end: namespace med::asn::oer
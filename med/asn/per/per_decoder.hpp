@@ -0,0 +1,412 @@
+#pragma once
+/**
+@file
+ASN.1 PER decoder definition
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <array>
+
+#include "debug.hpp"
+#include "bit_cursor.hpp"
+#include "name.hpp"
+#include "count.hpp"
+#include "decode.hpp"
+#include "choice.hpp"
+#include "octet_string.hpp"
+#include "bit_string.hpp"
+#include "per_info.hpp"
+
+namespace med::asn::per {
+
+template <class DEC_CTX, class VARIANT = aligned>
+struct decoder : info
+{
+	using state_type = typename DEC_CTX::buffer_type::state_type;
+	using size_state = typename DEC_CTX::buffer_type::size_state;
+	using allocator_type = typename DEC_CTX::allocator_type;
+	static constexpr bool is_aligned = VARIANT::value;
+
+	explicit decoder(DEC_CTX& ctx_, VARIANT = {}) : m_ctx{ ctx_ }, m_bits{ ctx_.buffer() } { }
+	DEC_CTX& get_context() noexcept             { return m_ctx; }
+	allocator_type& get_allocator()             { return get_context().get_allocator(); }
+
+	//PER has no tags and lengths to drive the structure layer thus containers are decoded here
+	struct container_decoder
+	{
+		template <class IE>
+		void operator()(decoder& me, IE& ie)    { nested const n{me}; me.decode_container(ie); }
+	};
+
+	//IE_NULL
+	template <class IE> constexpr void operator() (IE&, IE_NULL) const
+	{
+	}
+
+	//IE_VALUE
+	template <class IE> void operator() (IE& ie, IE_VALUE)
+	{
+		nested const n{*this};
+		if constexpr (AMultiField<IE>)
+		{
+			decode_multi(ie);
+		}
+		else
+		{
+			using value_type = typename IE::value_type;
+			if constexpr (std::is_same_v<bool, value_type>)
+			{
+				//X.691 12 Encoding the boolean type
+				ie.set_encoded(0 != get_bits<IE>(1));
+				CODEC_TRACE("BOOL[%s]=%d: %s", name<IE>(), ie.get_encoded(), get_context().buffer().toString());
+			}
+			else if constexpr (std::is_integral_v<value_type>)
+			{
+				//X.691 13 Encoding the integer type
+				//X.691 14 Encoding the enumerated type (by index of constrained value)
+				if constexpr (AConstrained<IE>)
+				{
+					constexpr std::intmax_t lb = IE::traits::lower_bound;
+					constexpr std::intmax_t ub = IE::traits::upper_bound;
+					auto const v = get_constrained<IE, std::uint64_t(ub - lb)>();
+					ie.set_encoded(value_type(lb + std::intmax_t(v)));
+				}
+				else
+				{
+					ie.set_encoded(get_unconstrained<IE, value_type>());
+				}
+				CODEC_TRACE("INT[%s]=%lld: %s", name<IE>(), (long long)ie.get_encoded(), get_context().buffer().toString());
+			}
+			else
+			{
+				static_assert(std::is_void_v<value_type>, "NOT IMPLEMENTED?");
+			}
+		}
+	}
+
+	//IE_BIT_STRING
+	template <class IE> void operator() (IE& ie, IE_BIT_STRING)
+	{
+		nested const n{*this};
+		//X.691 16 Encoding the bitstring type
+		std::size_t num_bits;
+		if constexpr (detail::is_fixed_size<IE>)
+		{
+			num_bits = detail::size_bounds<IE>::lower;
+			if constexpr (detail::size_bounds<IE>::upper > 16) { align(); }
+		}
+		else
+		{
+			num_bits = get_length<IE>();
+			if (num_bits) { align(); }
+		}
+
+		auto const num_octets = bits_to_bytes(num_bits);
+		uint8_t const* data;
+		uint8_t inplace[sizeof(std::uint64_t)];
+		if (m_bits.is_aligned() && 0 == (num_bits % 8))
+		{
+			m_bits.align();
+			data = get_context().buffer().template advance<IE>(num_octets);
+		}
+		else
+		{
+			//not octet-aligned or the last octet is shared with next field
+			uint8_t* out = (num_octets <= sizeof(inplace)) ? inplace : allocate<IE>(num_octets);
+			for (std::size_t i = 0; i < num_bits / 8; ++i) { out[i] = uint8_t(get_bits<IE>(8)); }
+			if (auto const tail = num_bits % 8)
+			{
+				out[num_bits / 8] = uint8_t(get_bits<IE>(tail) << (8 - tail));
+			}
+			data = out;
+		}
+
+		if (not ie.set_encoded(num_bits, data))
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), num_bits, get_context().buffer())
+		}
+		CODEC_TRACE("BSTR[%s] %zu bits: %s", name<IE>(), num_bits, get_context().buffer().toString());
+	}
+
+	//IE_OCTET_STRING
+	template <class IE> void operator() (IE& ie, IE_OCTET_STRING)
+	{
+		nested const n{*this};
+		//X.691 17 Encoding the octetstring type
+		std::size_t len;
+		if constexpr (detail::is_fixed_size<IE>)
+		{
+			len = detail::size_bounds<IE>::lower;
+			if constexpr (detail::size_bounds<IE>::upper > 2) { align(); }
+		}
+		else
+		{
+			len = get_length<IE>();
+			if (len) { align(); }
+		}
+
+		if (not ie.set_encoded(len, get_octets<IE>(len), *this))
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), len, get_context().buffer())
+		}
+		CODEC_TRACE("OSTR[%s] %zu octets: %s", name<IE>(), len, get_context().buffer().toString());
+	}
+
+#ifndef UNIT_TEST
+private:
+#endif
+	//bits of the outermost encoding padded to the octet boundary are skipped
+	struct nested
+	{
+		explicit nested(decoder& me) : m_me{me}    { if (0 == m_me.m_depth++) { m_me.m_bits.reset(); } }
+		~nested()                                   { if (0 == --m_me.m_depth) { m_me.m_bits.align(); } }
+		decoder& m_me;
+	};
+
+	struct seq_dec
+	{
+		template <class IE, class SEQ, class PRESENCE>
+		static void apply(SEQ& seq, PRESENCE const& presence, decoder& me)
+		{
+			using field_t = get_field_type_t<IE>;
+			if constexpr (AOptional<IE>)
+			{
+				constexpr auto bit = detail::optional_index<IE, typename SEQ::ies_types>;
+				if (0 == (presence[bit / 64] & (std::uint64_t(1) << (bit % 64))))
+				{
+					CODEC_TRACE("SEQ[%s] skip absent %s", name<SEQ>(), name<field_t>());
+					return;
+				}
+			}
+
+			if constexpr (AMultiField<IE>)
+			{
+				me.decode_multi(seq.template ref<field_t>());
+			}
+			else
+			{
+				med::decode(me, seq.template ref<field_t>());
+			}
+		}
+	};
+
+	struct choice_dec
+	{
+		template <class IE, class CHOICE>
+		static constexpr bool check(CHOICE const&, std::size_t index, decoder&)
+		{
+			return index == CHOICE::template index<get_field_type_t<IE>>();
+		}
+
+		template <class IE, class CHOICE>
+		static void apply(CHOICE& ie, std::size_t, decoder& me)
+		{
+			med::decode(me, ie.template ref<get_field_type_t<IE>>(me));
+		}
+
+		template <class CHOICE>
+		static void apply(CHOICE&, std::size_t index, decoder& me)
+		{
+			MED_THROW_EXCEPTION(unknown_tag, name<CHOICE>(), index, me.get_context().buffer())
+		}
+	};
+
+	template <class IE>
+	void decode_container(IE& ie)
+	{
+		if constexpr (AMultiField<IE>)
+		{
+			decode_multi(ie);
+		}
+		else if constexpr (std::is_same_v<IE_CHOICE, typename IE::ie_type>)
+		{
+			//X.691 23 Encoding the choice type
+			ie.clear();
+			std::size_t const index = get_constrained<IE, IE::num_types - 1>();
+			CODEC_TRACE("CHOICE[%s] index=%zu: %s", name<IE>(), index, get_context().buffer().toString());
+			meta::for_if<typename IE::ies_types>(choice_dec{}, ie, index, *this);
+		}
+		else
+		{
+			//X.691 19 Encoding the sequence type
+			//X.691 21 Encoding the set type (components are expected in canonical order)
+			using ies = typename IE::ies_types;
+			constexpr std::size_t num_opts = detail::num_optionals<ies>;
+			std::array<std::uint64_t, (num_opts + 63) / 64> presence{};
+			for (std::size_t i = 0; i < num_opts; ++i)
+			{
+				if (get_bits<IE>(1)) { presence[i / 64] |= std::uint64_t(1) << (i % 64); }
+			}
+			CODEC_TRACE("SEQ[%s] preamble of %zu: %s", name<IE>(), num_opts, get_context().buffer().toString());
+			meta::foreach<ies>(seq_dec{}, ie, presence, *this);
+		}
+	}
+
+	template <class IE>
+	void decode_multi(IE& ie)
+	{
+		//X.691 20 Encoding the sequence-of type
+		std::size_t count;
+		if constexpr (detail::is_fixed_size<IE>)
+		{
+			count = detail::size_bounds<IE>::lower;
+		}
+		else
+		{
+			count = get_length<IE>();
+		}
+		CODEC_TRACE("SEQOF[%s] *%zu: %s", name<IE>(), count, get_context().buffer().toString());
+		check_arity(*this, ie, count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			auto* field = ie.push_back(*this);
+			med::decode(*this, *field);
+		}
+	}
+
+	//X.691 11.9 General rules for encoding a length determinant
+	template <class IE>
+	std::size_t get_length()
+	{
+		using bounds = detail::size_bounds<IE>;
+		if constexpr (detail::is_size_constrained<IE>)
+		{
+			return bounds::lower + get_constrained<IE, bounds::upper - bounds::lower>();
+		}
+		else
+		{
+			return get_unconstrained_length<IE>();
+		}
+	}
+
+	template <class IE>
+	std::size_t get_unconstrained_length()
+	{
+		align();
+		auto const len = get_bits<IE>(8);
+		if (0 == (len & 0x80))
+		{
+			return len;
+		}
+		else if (0x80 == (len & 0xC0))
+		{
+			return ((len & 0x3F) << 8) | get_bits<IE>(8);
+		}
+		//fragmentation is not supported
+		MED_THROW_EXCEPTION(invalid_value, name<IE>(), len, get_context().buffer())
+	}
+
+	//X.691 11.5.7 Decoding of constrained whole number in range 0..RANGE
+	template <class IE, std::uint64_t RANGE>
+	std::uint64_t get_constrained()
+	{
+		if constexpr (RANGE == 0)
+		{
+			return 0;
+		}
+		else
+		{
+			std::uint64_t v;
+			if constexpr (not is_aligned || RANGE < 255)
+			{
+				v = get_bits<IE>(detail::range_bits(RANGE));
+			}
+			else if constexpr (RANGE == 255)
+			{
+				align();
+				v = get_bits<IE>(8);
+			}
+			else if constexpr (RANGE < 0x10000)
+			{
+				align();
+				v = get_bits<IE>(16);
+			}
+			else
+			{
+				constexpr uint8_t max_octets = detail::unsigned_octets(RANGE);
+				auto const num_octets = get_constrained<IE, max_octets - 1>() + 1;
+				align();
+				v = get_bits<IE>(8 * num_octets);
+			}
+
+			if (v > RANGE)
+			{
+				MED_THROW_EXCEPTION(invalid_value, name<IE>(), v, get_context().buffer())
+			}
+			return v;
+		}
+	}
+
+	//X.691 11.8 Decoding of an unconstrained whole number (2's complement) prefixed by length
+	template <class IE, typename T>
+	T get_unconstrained()
+	{
+		auto const num_octets = get_unconstrained_length<IE>();
+		constexpr std::size_t max_octets = sizeof(T) + (std::is_signed_v<T> ? 0 : 1);
+		if (0 == num_octets || num_octets > max_octets)
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), num_octets, get_context().buffer())
+		}
+		//skip sign octet of unsigned
+		std::size_t const num_bits = 8 * std::min(num_octets, sizeof(T));
+		if (num_octets > sizeof(T)) { get_bits<IE>(8); }
+		std::uint64_t v = get_bits<IE>(num_bits);
+		if constexpr (std::is_signed_v<T>)
+		{
+			//sign extension
+			if (num_bits < 64 && (v >> (num_bits - 1))) { v |= ~std::uint64_t(0) << num_bits; }
+		}
+		return static_cast<T>(v);
+	}
+
+	//ALIGNED variant: skip padding bits up to the octet boundary
+	void align()
+	{
+		if constexpr (is_aligned) { m_bits.align(); }
+	}
+
+	//reads num_bits starting from MSB
+	template <class IE>
+	std::uint64_t get_bits(std::size_t num_bits)
+	{
+		return m_bits.template get<IE>(num_bits);
+	}
+
+	template <class IE>
+	uint8_t* allocate(std::size_t len)
+	{
+		auto* p = static_cast<uint8_t*>(get_allocator().allocate(len, 1));
+		if (!p) { MED_THROW_EXCEPTION(out_of_memory, name<IE>(), len) }
+		return p;
+	}
+
+	template <class IE>
+	uint8_t const* get_octets(std::size_t len)
+	{
+		if (m_bits.is_aligned())
+		{
+			m_bits.align();
+			return get_context().buffer().template advance<IE>(len);
+		}
+		//not octet-aligned (UNALIGNED variant): copy out to allocated space
+		uint8_t* out = allocate<IE>(len);
+		for (std::size_t i = 0; i < len; ++i) { out[i] = uint8_t(get_bits<IE>(8)); }
+		return out;
+	}
+
+	using bit_reader_t = bit_reader<typename DEC_CTX::buffer_type>;
+
+	DEC_CTX&     m_ctx;
+	bit_reader_t m_bits;
+	std::size_t  m_depth {0}; //nesting level of IE being decoded
+};
+
+template <class C>
+explicit decoder(C&) -> decoder<C>;
+template <class C, class V>
+decoder(C&, V) -> decoder<C, V>;
+
+}	//end: namespace med::asn::per
@@ -0,0 +1,409 @@
+#pragma once
+/**
+@file
+ASN.1 PER encoder definition
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+#include <cstring>
+
+#include "debug.hpp"
+#include "bit_cursor.hpp"
+#include "name.hpp"
+#include "count.hpp"
+#include "encode.hpp"
+#include "choice.hpp"
+#include "octet_string.hpp"
+#include "bit_string.hpp"
+#include "per_info.hpp"
+
+
+namespace med::asn::per {
+
+template <class ENC_CTX, class VARIANT = aligned>
+struct encoder : info
+{
+	using state_type = typename ENC_CTX::buffer_type::state_type;
+	using allocator_type = typename ENC_CTX::allocator_type;
+	static constexpr bool is_aligned = VARIANT::value;
+
+	explicit encoder(ENC_CTX& ctx_, VARIANT = {}) : m_ctx{ ctx_ }, m_bits{ ctx_.buffer() } { }
+	ENC_CTX& get_context() noexcept                   { return m_ctx; }
+	allocator_type& get_allocator()                   { return get_context().get_allocator(); }
+
+	//PER has no tags and lengths to drive the structure layer thus containers are encoded here
+	struct container_encoder
+	{
+		template <class IE>
+		void operator()(encoder& me, IE const& ie)    { nested const n{me}; me.encode_container(ie); }
+	};
+
+	//IE_NULL
+	template <class IE> constexpr void operator() (IE const&, IE_NULL) const
+	{
+		//X.691 24 Encoding the null type
+		//24.1 The null type shall be encoded as an empty bit-field.
+	}
+
+	//IE_VALUE
+	template <class IE> void operator() (IE const& ie, IE_VALUE)
+	{
+		nested const n{*this};
+		if constexpr (AMultiField<IE>)
+		{
+			encode_multi(ie);
+		}
+		else
+		{
+			using value_type = typename IE::value_type;
+			if constexpr (std::is_same_v<bool, value_type>)
+			{
+				//X.691 12 Encoding the boolean type
+				put_bits<IE>(ie.get_encoded() ? 1 : 0, 1);
+				CODEC_TRACE("BOOL[%s]=%d: %s", name<IE>(), ie.get_encoded(), get_context().buffer().toString());
+			}
+			else if constexpr (std::is_integral_v<value_type>)
+			{
+				//X.691 13 Encoding the integer type
+				//X.691 14 Encoding the enumerated type (by index of constrained value)
+				if constexpr (AConstrained<IE>)
+				{
+					constexpr std::intmax_t lb = IE::traits::lower_bound;
+					constexpr std::intmax_t ub = IE::traits::upper_bound;
+					auto const v = std::intmax_t(ie.get_encoded());
+					if (v < lb || v > ub)
+					{
+						MED_THROW_EXCEPTION(invalid_value, name<IE>(), std::size_t(v), get_context().buffer())
+					}
+					//13.2.2 constrained whole number
+					put_constrained<IE, std::uint64_t(ub - lb)>(std::uint64_t(v - lb));
+				}
+				else
+				{
+					//13.2.4 unconstrained whole number
+					put_unconstrained<IE>(ie.get_encoded());
+				}
+				CODEC_TRACE("INT[%s]=%lld: %s", name<IE>(), (long long)ie.get_encoded(), get_context().buffer().toString());
+			}
+			else
+			{
+				static_assert(std::is_void_v<value_type>, "NOT IMPLEMENTED?");
+			}
+		}
+	}
+
+	//IE_BIT_STRING
+	template <class IE> void operator() (IE const& ie, IE_BIT_STRING)
+	{
+		nested const n{*this};
+		//X.691 16 Encoding the bitstring type
+		auto const num_bits = std::size_t(ie.get().num_of_bits());
+		if constexpr (detail::is_fixed_size<IE>)
+		{
+			//16.9 fixed size up to 16 bits: no length and not octet-aligned
+			//16.10 fixed size up to 64K: no length but octet-aligned
+			if constexpr (detail::size_bounds<IE>::upper > 16) { align(); }
+		}
+		else
+		{
+			//16.11 length determinant followed by octet-aligned bits
+			put_length<IE>(num_bits);
+			if (num_bits) { align(); }
+		}
+
+		uint8_t const* data = ie.data();
+		put_octets<IE>(data, num_bits / 8);
+		if (auto const tail = num_bits % 8)
+		{
+			put_bits<IE>(data[num_bits / 8] >> (8 - tail), tail);
+		}
+		CODEC_TRACE("BSTR[%s] %zu bits: %s", name<IE>(), num_bits, get_context().buffer().toString());
+	}
+
+	//IE_OCTET_STRING
+	template <class IE> void operator() (IE const& ie, IE_OCTET_STRING)
+	{
+		nested const n{*this};
+		//X.691 17 Encoding the octetstring type
+		auto const len = ie.size();
+		if constexpr (detail::is_fixed_size<IE>)
+		{
+			//17.6 fixed size of zero: no bits
+			//17.7 fixed size up to 2 octets: no length and not octet-aligned
+			//17.8 fixed size up to 64K: no length but octet-aligned
+			if constexpr (detail::size_bounds<IE>::upper > 2) { align(); }
+		}
+		else
+		{
+			//17.8 length determinant followed by octet-aligned octets
+			put_length<IE>(len);
+			if (len) { align(); }
+		}
+		put_octets<IE>(ie.data(), len);
+		CODEC_TRACE("OSTR[%s] %zu octets: %s", name<IE>(), len, get_context().buffer().toString());
+	}
+
+#ifndef UNIT_TEST
+private:
+#endif
+	//X.691 10.1.3 the outermost encoding is padded to the octet boundary
+	struct nested
+	{
+		explicit nested(encoder& me) : m_me{me}    { if (0 == m_me.m_depth++) { m_me.m_bits.reset(); } }
+		~nested()                                   { if (0 == --m_me.m_depth) { m_me.m_bits.align(); } }
+		encoder& m_me;
+	};
+
+	template <class IE, class SEQ>
+	static bool is_present(SEQ const& seq)
+	{
+		using field_t = get_field_type_t<IE>;
+		if constexpr (AMultiField<IE>)
+		{
+			return not seq.template get<field_t>().empty();
+		}
+		else
+		{
+			return nullptr != seq.template get<field_t>();
+		}
+	}
+
+	//X.691 19.2 bit-map of presence of OPTIONAL and DEFAULT components
+	struct seq_preamble
+	{
+		template <class IE, class SEQ>
+		static void apply(SEQ const& seq, encoder& me)
+		{
+			if constexpr (AOptional<IE>)
+			{
+				me.template put_bits<IE>(is_present<IE>(seq) ? 1 : 0, 1);
+			}
+		}
+	};
+
+	struct seq_enc
+	{
+		template <class IE, class SEQ>
+		static void apply(SEQ const& seq, encoder& me)
+		{
+			using field_t = get_field_type_t<IE>;
+			if constexpr (AMultiField<IE>)
+			{
+				auto const& ie = seq.template get<field_t>();
+				if (AMandatory<IE> || not ie.empty()) { me.encode_multi(ie); }
+			}
+			else if constexpr (AOptional<IE>)
+			{
+				if (auto const* pie = seq.template get<field_t>()) { med::encode(me, *pie); }
+			}
+			else
+			{
+				auto const& ie = seq.template get<field_t>();
+				if (not ie.is_set())
+				{
+					MED_THROW_EXCEPTION(missing_ie, name<field_t>(), 1, 0, me.get_context().buffer())
+				}
+				med::encode(me, ie);
+			}
+		}
+	};
+
+	struct choice_enc : sl::choice_if
+	{
+		template <class IE, class CHOICE>
+		static void apply(CHOICE const& ie, encoder& me)
+		{
+			med::encode(me, *ie.template get<get_field_type_t<IE>>());
+		}
+
+		template <class CHOICE>
+		static void apply(CHOICE const& ie, encoder& me)
+		{
+			MED_THROW_EXCEPTION(unknown_tag, name<CHOICE>(), ie.index(), me.get_context().buffer())
+		}
+	};
+
+	template <class IE>
+	void encode_container(IE const& ie)
+	{
+		if constexpr (AMultiField<IE>)
+		{
+			encode_multi(ie);
+		}
+		else if constexpr (std::is_same_v<IE_CHOICE, typename IE::ie_type>)
+		{
+			//X.691 23 Encoding the choice type
+			//23.6 index of the alternative as constrained whole number
+			if (not ie.is_set())
+			{
+				MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0, get_context().buffer())
+			}
+			put_constrained<IE, IE::num_types - 1>(ie.index());
+			CODEC_TRACE("CHOICE[%s] index=%zu: %s", name<IE>(), ie.index(), get_context().buffer().toString());
+			meta::for_if<typename IE::ies_types>(choice_enc{}, ie, *this);
+		}
+		else
+		{
+			//X.691 19 Encoding the sequence type
+			//X.691 21 Encoding the set type (components are expected in canonical order)
+			using ies = typename IE::ies_types;
+			meta::foreach<ies>(seq_preamble{}, ie, *this);
+			CODEC_TRACE("SEQ[%s] preamble of %zu: %s", name<IE>(), detail::num_optionals<ies>, get_context().buffer().toString());
+			meta::foreach<ies>(seq_enc{}, ie, *this);
+		}
+	}
+
+	template <class IE>
+	void encode_multi(IE const& ie)
+	{
+		//X.691 20 Encoding the sequence-of type
+		check_arity(*this, ie);
+		if constexpr (not detail::is_fixed_size<IE>)
+		{
+			put_length<IE>(ie.count());
+		}
+		CODEC_TRACE("SEQOF[%s] *%zu: %s", name<IE>(), ie.count(), get_context().buffer().toString());
+		for (auto& field : ie) { med::encode(*this, field); }
+	}
+
+	//X.691 11.9 General rules for encoding a length determinant
+	template <class IE>
+	void put_length(std::size_t len)
+	{
+		using bounds = detail::size_bounds<IE>;
+		if constexpr (detail::is_size_constrained<IE>)
+		{
+			//11.9.3.3 ub less than 64K: constrained whole number
+			put_constrained<IE, bounds::upper - bounds::lower>(len - bounds::lower);
+		}
+		else
+		{
+			put_unconstrained_length<IE>(len);
+		}
+	}
+
+	template <class IE>
+	void put_unconstrained_length(std::size_t len)
+	{
+		//11.9.3.5-8 octet-aligned in ALIGNED variant
+		align();
+		if (len < 0x80)
+		{
+			//11.9.3.6 single octet with bit 8 set to zero
+			put_bits<IE>(len, 8);
+		}
+		else if (len < detail::LEN_16K)
+		{
+			//11.9.3.7 two octets with bit 8 of 1st set to 1 and bit 7 set to zero
+			put_bits<IE>(0x8000 | len, 16);
+		}
+		else
+		{
+			//11.9.3.8 fragmentation is not supported
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), len, get_context().buffer())
+		}
+	}
+
+	//X.691 11.5.7 Encoding of constrained whole number in range 0..RANGE
+	template <class IE, std::uint64_t RANGE>
+	void put_constrained(std::uint64_t v)
+	{
+		if constexpr (RANGE == 0)
+		{
+			//11.5.4 range of one value: empty bit-field
+		}
+		else if constexpr (not is_aligned || RANGE < 255)
+		{
+			//11.5.7.1 bit-field case (also the only case in UNALIGNED variant)
+			put_bits<IE>(v, detail::range_bits(RANGE));
+		}
+		else if constexpr (RANGE == 255)
+		{
+			//11.5.7.2 one-octet case
+			align();
+			put_bits<IE>(v, 8);
+		}
+		else if constexpr (RANGE < 0x10000)
+		{
+			//11.5.7.3 two-octet case
+			align();
+			put_bits<IE>(v, 16);
+		}
+		else
+		{
+			//11.5.7.4 indefinite length case: minimal octets prefixed by their number
+			constexpr uint8_t max_octets = detail::unsigned_octets(RANGE);
+			uint8_t const num_octets = detail::unsigned_octets(v);
+			put_constrained<IE, max_octets - 1>(num_octets - 1);
+			align();
+			put_bits<IE>(v, 8 * num_octets);
+		}
+	}
+
+	//X.691 11.8 Encoding of an unconstrained whole number (2's complement) prefixed by length
+	template <class IE, typename T>
+	void put_unconstrained(T v)
+	{
+		uint8_t num_octets;
+		if constexpr (std::is_signed_v<T>)
+		{
+			num_octets = detail::signed_octets(v);
+		}
+		else
+		{
+			num_octets = detail::unsigned_octets(v);
+			//extra octet to keep the sign bit clear
+			if (v >> (8 * num_octets - 1)) { ++num_octets; }
+		}
+		put_unconstrained_length<IE>(num_octets);
+		if (num_octets > sizeof(std::uint64_t))
+		{
+			put_bits<IE>(0, 8 * (num_octets - sizeof(std::uint64_t)));
+			num_octets = sizeof(std::uint64_t);
+		}
+		put_bits<IE>(std::uint64_t(v), 8 * num_octets);
+	}
+
+	//ALIGNED variant: pad with zero bits to the octet boundary
+	void align()
+	{
+		if constexpr (is_aligned) { m_bits.align(); }
+	}
+
+	//writes num_bits of v starting from MSB
+	template <class IE>
+	void put_bits(std::uint64_t v, std::size_t num_bits)
+	{
+		m_bits.template put<IE>(v, num_bits);
+	}
+
+	template <class IE>
+	void put_octets(uint8_t const* data, std::size_t len)
+	{
+		if (m_bits.is_aligned())
+		{
+			m_bits.align();
+			auto* out = get_context().buffer().template advance<IE>(len);
+			if (len) { std::memcpy(out, data, len); }
+		}
+		else
+		{
+			for (std::size_t i = 0; i < len; ++i) { put_bits<IE>(data[i], 8); }
+		}
+	}
+
+	using bit_writer_t = bit_writer<typename ENC_CTX::buffer_type>;
+
+	ENC_CTX&     m_ctx;
+	bit_writer_t m_bits;
+	std::size_t  m_depth {0}; //nesting level of IE being encoded
+};
+
+template <class C>
+explicit encoder(C&) -> encoder<C>;
+template <class C, class V>
+encoder(C&, V) -> encoder<C, V>;
+
+}	//end: namespace med::asn::per
@@ -0,0 +1,65 @@
+#pragma once
+/**
+@file
+ASN.1 PER common definitions
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#include <cstdint>
+#include <type_traits>
+
+#include "../asn.hpp"
+
+namespace med::asn::per {
+
+/* X.691
+3.7.1 ALIGNED variant: padding bits are inserted to restore octet alignment.
+3.7.32 UNALIGNED variant: no padding bits are inserted.
+*/
+struct aligned : std::true_type {};
+struct unaligned : std::false_type {};
+
+namespace detail {
+
+//11.9.3.3 lengths below 64K can be encoded as constrained whole number
+constexpr std::size_t LEN_64K = 64*1024;
+//11.9.3.6 max length encoded w/o fragmentation
+constexpr std::size_t LEN_16K = 16*1024;
+
+//number of bits to encode a constrained whole number in range 0..r
+constexpr uint8_t range_bits(std::uint64_t r)
+{
+	uint8_t n = 0;
+	for (; r; r >>= 1) { ++n; }
+	return n;
+}
+
+using asn::detail::unsigned_octets;
+using asn::detail::signed_octets;
+using asn::detail::size_bounds;
+using asn::detail::num_optionals;
+using asn::detail::optional_index;
+
+//NOTE: as in X.691 the size is considered unconstrained when its UB is 64K and above
+template <class IE>
+constexpr bool is_size_constrained = size_bounds<IE>::upper < LEN_64K;
+
+template <class IE>
+constexpr bool is_fixed_size = is_size_constrained<IE> && size_bounds<IE>::lower == size_bounds<IE>::upper;
+
+} //end: namespace detail
+
+struct info
+{
+	//PER doesn't encode tags and lengths of IEs in general thus no meta-info
+	template <class IE>
+	static constexpr auto produce_meta_info()
+	{
+		return meta::wrap<meta::typelist<>>{};
+	}
+};
+
+} //end: namespace med::asn::per
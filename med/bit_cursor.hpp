@@ -0,0 +1,198 @@
+/**
+@file
+bit-granular cursors on top of octet buffer
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "bytes.hpp"
+#include "exception.hpp"
+#include "name.hpp"
+#include "value_traits.hpp"
+
+namespace med {
+
+namespace detail {
+
+constexpr std::uint64_t lsb_mask(std::size_t num_bits)
+{
+	return num_bits < 64 ? (std::uint64_t(1) << num_bits) - 1 : ~std::uint64_t(0);
+}
+
+} //end: namespace detail
+
+/**
+ * Writes bit-fields MSB first at arbitrary bit positions of the buffer.
+ * @details Bits are collected in 64-bit accumulator and spilled to the buffer
+ * by 8 octets. The buffer cursor always covers all the bits written (i.e. the
+ * space is reserved and checked for overflow on put) while the last partial
+ * octets are written on flush/align only.
+ * NOTE: the buffer can be accessed directly only when the writer is aligned.
+ */
+template <class BUFFER>
+class bit_writer
+{
+public:
+	using buffer_type = BUFFER;
+	using pointer = typename buffer_type::pointer;
+
+	explicit constexpr bit_writer(buffer_type& buf) noexcept : m_buf{buf} {}
+	bit_writer(bit_writer const&) = delete;
+	bit_writer& operator=(bit_writer const&) = delete;
+
+	//number of bits written from the start of buffer
+	constexpr std::size_t bit_offset() const noexcept
+	{
+		return m_num ? 8 * std::size_t(m_out - m_buf.get_start()) + m_num : 8 * m_buf.get_offset();
+	}
+	constexpr bool is_aligned() const noexcept        { return 0 == (m_num % 8); }
+
+	template <class IE>
+	constexpr void put(std::uint64_t v, std::size_t num_bits)
+	{
+		if (0 == num_bits) { return; }
+		//sync with the buffer which might be used directly
+		if (0 == m_num) { m_out = m_buf.begin(); }
+		//reserve octets to fit new bits
+		if (auto const delta = m_out + bits_to_bytes(m_num + num_bits) - m_buf.begin(); delta > 0)
+		{
+			if (delta > m_buf.end() - m_buf.begin())
+			{
+				MED_THROW_EXCEPTION(overflow, name<IE>(), std::size_t(delta), m_buf)
+			}
+			m_buf.offset(int(delta));
+		}
+
+		v &= detail::lsb_mask(num_bits);
+		if (std::size_t const free = 64 - m_num; num_bits < free)
+		{
+			m_acc = (m_acc << num_bits) | v;
+			m_num += num_bits;
+		}
+		else
+		{
+			//fill up the accumulator and spill it
+			std::size_t const rest = num_bits - free;
+			m_acc = (free < 64 ? (m_acc << free) : 0) | (v >> rest);
+			put_bytes<sizeof(m_acc)>(m_acc, m_out);
+			m_out += sizeof(m_acc);
+			m_acc = v & detail::lsb_mask(rest);
+			m_num = rest;
+		}
+	}
+
+	//writes all pending bits incl. partial octet padded with zeros keeping the position
+	constexpr void flush() noexcept
+	{
+		if (m_num)
+		{
+			auto v = m_acc << (64 - m_num);
+			for (std::size_t i = 0, n = bits_to_bytes(m_num); i < n; ++i, v <<= 8)
+			{
+				m_out[i] = uint8_t(v >> 56);
+			}
+		}
+	}
+
+	//pads with zero bits up to octet boundary and flushes
+	constexpr void align() noexcept
+	{
+		flush();
+		reset();
+	}
+
+	//drops pending bits (e.g. after buffer is reset)
+	constexpr void reset() noexcept
+	{
+		m_acc = 0;
+		m_num = 0;
+	}
+
+private:
+	buffer_type&  m_buf;
+	pointer       m_out {nullptr}; //octet of the 1st bit in accumulator
+	std::uint64_t m_acc {0};       //pending bits in LSBs
+	std::size_t   m_num {0};       //number of pending bits
+};
+
+/**
+ * Reads bit-fields MSB first at arbitrary bit positions of the buffer.
+ * @details Each field is extracted from 64-bit window loaded at the octet of
+ * its first bit. The buffer cursor is kept after the last octet a bit was
+ * read from thus the buffer state is consistent on any bit position.
+ * NOTE: the buffer can be accessed directly only after align.
+ */
+template <class BUFFER>
+class bit_reader
+{
+public:
+	using buffer_type = BUFFER;
+	using pointer = typename buffer_type::pointer;
+
+	explicit constexpr bit_reader(buffer_type& buf) noexcept : m_buf{buf} {}
+	bit_reader(bit_reader const&) = delete;
+	bit_reader& operator=(bit_reader const&) = delete;
+
+	//number of bits read from the start of buffer
+	constexpr std::size_t bit_offset() const noexcept
+	{
+		return m_bit ? 8 * std::size_t(m_in - m_buf.get_start()) + m_bit : 8 * m_buf.get_offset();
+	}
+	constexpr bool is_aligned() const noexcept        { return 0 == m_bit; }
+
+	template <class IE>
+	constexpr std::uint64_t get(std::size_t num_bits)
+	{
+		//window of 8 octets fits 57 bits at any bit offset
+		if (num_bits > 56)
+		{
+			auto const hi = get<IE>(num_bits - 32);
+			return (hi << 32) | get<IE>(32);
+		}
+		if (0 == num_bits) { return 0; }
+
+		//sync with the buffer which might be used directly
+		if (0 == m_bit) { m_in = m_buf.begin(); }
+		auto const avail = m_buf.end() - m_in;
+		std::uint64_t v;
+		if (avail >= std::ptrdiff_t(sizeof(v)))
+		{
+			v = get_bytes<sizeof(v), std::uint64_t>(m_in);
+		}
+		else if (std::size_t(avail) >= bits_to_bytes(m_bit + num_bits))
+		{
+			v = 0;
+			for (std::ptrdiff_t i = 0; i < std::ptrdiff_t(sizeof(v)); ++i) { v = (v << 8) | (i < avail ? m_in[i] : 0); }
+		}
+		else
+		{
+			MED_THROW_EXCEPTION(overflow, name<IE>(), bits_to_bytes(m_bit + num_bits), m_buf)
+		}
+
+		v = (v << m_bit) >> (64 - num_bits);
+		m_bit += num_bits;
+		m_in += m_bit / 8;
+		m_bit %= 8;
+		m_buf.offset(int(m_in - m_buf.begin()) + (m_bit ? 1 : 0));
+		return v;
+	}
+
+	//skips bits up to octet boundary
+	constexpr void align() noexcept                   { m_bit = 0; }
+
+	//drops position within octet (e.g. after buffer is reset)
+	constexpr void reset() noexcept                   { align(); }
+
+private:
+	buffer_type&  m_buf;
+	pointer       m_in {nullptr}; //octet of the next bit
+	std::size_t   m_bit {0};      //offset of the next bit in octet
+};
+
+}	//end: namespace med
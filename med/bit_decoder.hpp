@@ -0,0 +1,98 @@
+/**
+@file
+bit decoder definition
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include "bit_cursor.hpp"
+#include "exception.hpp"
+#include "name.hpp"
+#include "ie_type.hpp"
+#include "sl/octet_info.hpp"
+
+namespace med {
+
+/**
+ * Unpacks values placed back to back at bit granularity (see bit_encoder).
+ * Octet strings are aligned to the octet boundary and take the rest of buffer.
+ */
+template <class DEC_CTX>
+struct bit_decoder : sl::octet_info
+{
+	using allocator_type = typename DEC_CTX::allocator_type;
+
+	explicit bit_decoder(DEC_CTX& c) : m_ctx{c}, m_bits{c.buffer()} { }
+	DEC_CTX& get_context() noexcept             { return m_ctx; }
+	allocator_type& get_allocator()             { return get_context().get_allocator(); }
+
+	//skips pending bits up to octet boundary
+	void align() noexcept                       { m_bits.align(); }
+	std::size_t bit_offset() const noexcept     { return m_bits.bit_offset(); }
+
+	//IE_TAG
+	template <class IE> [[nodiscard]] auto operator() (IE&, IE_TAG)
+	{
+		as_writable_t<IE> ie;
+		(*this)(ie, typename as_writable_t<IE>::ie_type{});
+		return ie.get_encoded();
+	}
+	//IE_LEN
+	template <class IE> void operator() (IE& ie, IE_LEN)
+	{
+		(*this)(ie, typename IE::ie_type{});
+	}
+
+	//IE_NULL
+	template <class IE> void operator() (IE&, IE_NULL)
+	{
+		CODEC_TRACE("NULL[%s]: %s", name<IE>(), get_context().buffer().toString());
+	}
+
+	//IE_VALUE
+	template <class IE> void operator() (IE& ie, IE_VALUE)
+	{
+		using value_t = typename IE::value_type;
+		auto const val = value_t(m_bits.template get<IE>(IE::traits::bits));
+		if constexpr (std::is_same_v<bool, decltype(ie.set_encoded(val))>)
+		{
+			if (not ie.set_encoded(val))
+			{
+				MED_THROW_EXCEPTION(invalid_value, name<IE>(), val, get_context().buffer())
+			}
+		}
+		else
+		{
+			ie.set_encoded(val);
+		}
+		CODEC_TRACE("VAL=%zXh @%zu [%s]: %s", std::size_t(val), m_bits.bit_offset(), name<IE>(), get_context().buffer().toString());
+	}
+
+	//IE_OCTET_STRING
+	template <class IE> void operator() (IE& ie, IE_OCTET_STRING)
+	{
+		m_bits.align();
+		auto& buf = get_context().buffer();
+		if (ie.set_encoded(buf.size(), buf.begin(), *this))
+		{
+			buf.template advance<IE>(ie.size());
+			CODEC_TRACE("STR[%s] %zu octets: %s", name<IE>(), std::size_t(ie.size()), buf.toString());
+		}
+		else
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), ie.size(), buf)
+		}
+	}
+
+private:
+	using bit_reader_t = bit_reader<typename DEC_CTX::buffer_type>;
+
+	DEC_CTX&     m_ctx;
+	bit_reader_t m_bits;
+};
+
+}	//end: namespace med
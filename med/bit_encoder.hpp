@@ -0,0 +1,73 @@
+/**
+@file
+bit encoder definition
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include "bit_cursor.hpp"
+#include "name.hpp"
+#include "octet_string.hpp"
+#include "sl/octet_info.hpp"
+
+namespace med {
+
+/**
+ * Packs values back to back at bit granularity w/o regard to octet boundaries,
+ * i.e. traits::bits of each value are used while traits::offset is ignored.
+ * Octet strings are aligned to the octet boundary.
+ * NOTE: lengths calculated by the codec (placeholders) are not supported.
+ * NOTE: the last partial octet is written on flush or destruction.
+ */
+template <class ENC_CTX>
+struct bit_encoder : sl::octet_info
+{
+	using allocator_type = typename ENC_CTX::allocator_type;
+
+	explicit bit_encoder(ENC_CTX& ctx_) : m_ctx{ ctx_ }, m_bits{ ctx_.buffer() } { }
+	~bit_encoder()                                    { flush(); }
+	ENC_CTX& get_context() noexcept                   { return m_ctx; }
+	allocator_type& get_allocator()                   { return get_context().get_allocator(); }
+
+	//writes pending bits padded with zeros to octet boundary
+	void flush() noexcept                             { m_bits.align(); }
+	std::size_t bit_offset() const noexcept           { return m_bits.bit_offset(); }
+
+	//IE_TAG/IE_LEN
+	template <class IE> void operator() (IE const& ie, IE_TAG)
+		{ (*this)(ie, typename IE::ie_type{}); }
+	template <class IE> void operator() (IE const& ie, IE_LEN)
+		{ (*this)(ie, typename IE::ie_type{}); }
+
+	//IE_NULL
+	template <class IE> void operator() (IE const&, IE_NULL)
+		{ CODEC_TRACE("NULL[%s]: %s", name<IE>(), get_context().buffer().toString()); }
+
+	//IE_VALUE
+	template <class IE> void operator() (IE const& ie, IE_VALUE)
+	{
+		m_bits.template put<IE>(std::uint64_t(ie.get_encoded()), IE::traits::bits);
+		CODEC_TRACE("V=%zXh %zu@%zu bits[%s]: %s", std::size_t(ie.get_encoded()), IE::traits::bits, m_bits.bit_offset(), name<IE>(), get_context().buffer().toString());
+	}
+
+	//IE_OCTET_STRING
+	template <class IE> void operator() (IE const& ie, IE_OCTET_STRING)
+	{
+		m_bits.align();
+		uint8_t* out = get_context().buffer().template advance<IE>(ie.size());
+		octets<IE::traits::min_octets, IE::traits::max_octets>::copy(out, ie.data(), ie.size());
+		CODEC_TRACE("STR[%s] %zu octets: %s", name<IE>(), ie.size(), get_context().buffer().toString());
+	}
+
+private:
+	using bit_writer_t = bit_writer<typename ENC_CTX::buffer_type>;
+
+	ENC_CTX&     m_ctx;
+	bit_writer_t m_bits;
+};
+
+}	//end: namespace med
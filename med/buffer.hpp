@@ -299,6 +299,8 @@ private:
 			}
 			else
 			{
+				//committed end can't exceed the current one
+				if (ps1 > m_end) { MED_THROW_EXCEPTION(overflow, "end of buffer", ps1 - m_end) }
 				m_end = ps1;
 				//replace EoB from previous level to restore properly
 				if (ss.m_index > 0) { ps1 = m_eob[ss.m_index - 1]; }
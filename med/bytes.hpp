@@ -8,6 +8,8 @@ Distributed under the MIT License
 (See accompanying file LICENSE or visit https://github.com/cppden/med)
 */
 
+#include <bit>
+#include <cstring>
 #include <utility>
 
 #include "value_traits.hpp"
@@ -72,4 +74,79 @@ constexpr void put_bytes(std::size_t value, uint8_t* output)
 	}(value, output, std::make_index_sequence<NUM_BYTES>{});
 }
 
+//order of octets in multi-octet values
+enum class byte_order
+{
+	big,    //network
+	little,
+	host = (std::endian::native == std::endian::little) ? little : big,
+};
+
+/**
+ * Selects byte order of codec or of IE when given as its extension trait,
+ * e.g. octet_encoder{ctx, med::little_endian{}} or med::value<uint32_t, med::little_endian>.
+ * NOTE: only the values of whole octets not sharing them with other bits are affected.
+ */
+template <byte_order ORDER>
+struct endian
+{
+	static constexpr byte_order endianness = ORDER;
+};
+using big_endian = endian<byte_order::big>;
+using little_endian = endian<byte_order::little>;
+using host_endian = endian<byte_order::host>;
+
+//byte order of IE given one of codec
+template <class IE, byte_order DEFAULT>
+constexpr byte_order byte_order_of()
+{
+	if constexpr (requires { IE::traits::endianness; }) { return IE::traits::endianness; }
+	else { return DEFAULT; }
+}
+
+template <std::size_t NUM_BYTES>
+constexpr void put_bytes_le(std::size_t value, uint8_t* output)
+{
+	if (std::endian::native == std::endian::little && not std::is_constant_evaluated())
+	{
+		std::memcpy(output, &value, NUM_BYTES);
+	}
+	else
+	{
+		for (std::size_t i = 0; i < NUM_BYTES; ++i, value >>= 8) { output[i] = uint8_t(value); }
+	}
+}
+
+template <uint8_t NUM_BYTES, typename VALUE = std::size_t>
+constexpr VALUE get_bytes_le(uint8_t const* input)
+{
+	static_assert(NUM_BYTES <= sizeof(VALUE));
+	if (std::endian::native == std::endian::little && not std::is_constant_evaluated())
+	{
+		VALUE value{};
+		std::memcpy(&value, input, NUM_BYTES);
+		return value;
+	}
+	else
+	{
+		std::size_t value = 0;
+		for (std::size_t i = NUM_BYTES; i; --i) { value = (value << 8) | input[i - 1]; }
+		return static_cast<VALUE>(value);
+	}
+}
+
+template <byte_order ORDER, std::size_t NUM_BYTES>
+constexpr void put_bytes(std::size_t value, uint8_t* output)
+{
+	if constexpr (ORDER == byte_order::little) { put_bytes_le<NUM_BYTES>(value, output); }
+	else { put_bytes<NUM_BYTES>(value, output); }
+}
+
+template <byte_order ORDER, uint8_t NUM_BYTES, typename VALUE = std::size_t>
+constexpr VALUE get_bytes(uint8_t const* input)
+{
+	if constexpr (ORDER == byte_order::little) { return get_bytes_le<NUM_BYTES, VALUE>(input); }
+	else { return get_bytes<NUM_BYTES, VALUE>(input); }
+}
+
 } //end: namespace med
@@ -0,0 +1,127 @@
+/**
+@file
+CBOR (RFC 8949) definitions
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "../value.hpp"
+#include "../name.hpp"
+#include "../traits.hpp"
+
+
+namespace med::cbor {
+
+enum class major_type : uint8_t
+{
+	UINT   = 0, //unsigned integer
+	NINT   = 1, //negative integer -1-N
+	BYTES  = 2, //byte string
+	TEXT   = 3, //UTF-8 text string
+	ARRAY  = 4, //array of items
+	MAP    = 5, //map of pairs of items
+	TAG    = 6, //tagged item
+	SIMPLE = 7, //simple values and floats
+};
+
+//additional information of initial byte
+constexpr uint8_t AI_1BYTE    = 24;
+constexpr uint8_t AI_2BYTES   = 25;
+constexpr uint8_t AI_4BYTES   = 26;
+constexpr uint8_t AI_8BYTES   = 27;
+constexpr uint8_t AI_INDEFINITE = 31;
+
+constexpr uint8_t FALSE = 0xF4;
+constexpr uint8_t TRUE  = 0xF5;
+constexpr uint8_t FLOAT32 = 0xFA;
+constexpr uint8_t FLOAT64 = 0xFB;
+
+//max nesting of items skipped when unknown
+constexpr std::size_t MAX_DEPTH = 32;
+
+constexpr uint8_t initial_byte(major_type mt, uint8_t ai)
+{
+	return (static_cast<uint8_t>(mt) << 5) | ai;
+}
+
+namespace detail {
+
+//number of argument bytes following the initial byte or INVALID (incl. indefinite lengths)
+constexpr uint8_t INVALID = 0xFF;
+constexpr auto head_table = []()
+{
+	std::array<uint8_t, 256> table{};
+	for (std::size_t i = 0; i < table.size(); ++i)
+	{
+		uint8_t const ai = i & 0x1F;
+		table[i] = ai < AI_1BYTE ? 0 : ai <= AI_8BYTES ? uint8_t(1 << (ai - AI_1BYTE)) : INVALID;
+	}
+	return table;
+}();
+
+template <class IE>
+struct tag_of
+{
+	using type = get_meta_tag_t<get_meta_info_t<IE>>;
+};
+template <AMultiField IE> requires std::is_void_v<get_meta_tag_t<get_meta_info_t<IE>>>
+struct tag_of<IE>
+{
+	using type = get_meta_tag_t<get_meta_info_t<typename IE::field_type>>;
+};
+
+//key of container field is its tag if any or its name otherwise
+template <class IE>
+using key_tag = typename tag_of<IE>::type;
+
+template <class IE>
+constexpr bool has_key_tag = not std::is_void_v<key_tag<IE>>;
+
+template <class IE>
+constexpr std::size_t key_value()
+{
+	return std::size_t(key_tag<IE>::get_encoded());
+}
+
+} //end: namespace detail
+
+//key of map entry as decoded
+struct key_type
+{
+	char const*   text{nullptr}; //key is a string when not null
+	std::uint64_t value{0};      //integer or length of string
+
+	template <class IE>
+	bool match() const noexcept
+	{
+		if constexpr (detail::has_key_tag<IE>)
+		{
+			return not text && value == detail::key_value<IE>();
+		}
+		else
+		{
+			char const* const key = name<get_field_type_t<IE>>();
+			return text && value == std::strlen(key) && 0 == std::memcmp(text, key, value);
+		}
+	}
+};
+
+struct info
+{
+	//CBOR items are self-describing thus no meta-info of IEs is used
+	template <class IE>
+	static constexpr auto produce_meta_info()
+	{
+		return meta::wrap<meta::typelist<>>{};
+	}
+};
+
+} //end: namespace med::cbor
@@ -0,0 +1,357 @@
+/**
+@file
+CBOR (RFC 8949) decoder definition
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <bit>
+#include <limits>
+
+#include "debug.hpp"
+#include "name.hpp"
+#include "bytes.hpp"
+#include "count.hpp"
+#include "decode.hpp"
+#include "choice.hpp"
+#include "octet_string.hpp"
+#include "cbor.hpp"
+
+namespace med::cbor {
+
+/**
+ * Decodes maps into sequence/set (entries in any order, unknown ones are skipped),
+ * arrays into multi-fields and byte/text strings into octet strings
+ * (w/o copy for octets_var_extern).
+ * NOTE: indefinite-length items are not supported.
+ */
+template <class DEC_CTX>
+struct decoder : info
+{
+	using state_type = typename DEC_CTX::buffer_type::state_type;
+	using size_state = typename DEC_CTX::buffer_type::size_state;
+	using allocator_type = typename DEC_CTX::allocator_type;
+
+	explicit decoder(DEC_CTX& ctx_) : m_ctx{ ctx_ } { }
+	DEC_CTX& get_context() noexcept             { return m_ctx; }
+	allocator_type& get_allocator()             { return get_context().get_allocator(); }
+
+	//containers are decoded from maps here
+	struct container_decoder
+	{
+		template <class IE>
+		void operator()(decoder& me, IE& ie)    { me.decode_container(ie); }
+	};
+
+	//IE_NULL
+	template <class IE> void operator() (IE&, IE_NULL)
+	{
+		if (auto const b = get_context().buffer().template pop<IE>(); b != initial_byte(major_type::SIMPLE, 22))
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), b, get_context().buffer())
+		}
+	}
+
+	//IE_VALUE
+	template <class IE> void operator() (IE& ie, IE_VALUE)
+	{
+		if constexpr (AMultiField<IE>)
+		{
+			decode_multi(ie);
+		}
+		else
+		{
+			using value_type = typename IE::value_type;
+			auto const head = get_head<IE>();
+			value_type v;
+			if constexpr (std::is_same_v<bool, value_type>)
+			{
+				if (head.byte != TRUE && head.byte != FALSE)
+				{
+					MED_THROW_EXCEPTION(invalid_value, name<IE>(), head.byte, get_context().buffer())
+				}
+				v = (head.byte == TRUE);
+			}
+			else if constexpr (std::is_floating_point_v<value_type>)
+			{
+				using bits_type = conditional_t<sizeof(v) == 4, uint32_t, uint64_t>;
+				if (head.byte != (sizeof(v) == 4 ? FLOAT32 : FLOAT64))
+				{
+					MED_THROW_EXCEPTION(invalid_value, name<IE>(), head.byte, get_context().buffer())
+				}
+				v = std::bit_cast<value_type>(bits_type(head.arg));
+			}
+			else
+			{
+				static_assert(std::is_integral_v<value_type>, "INTEGRAL VALUE EXPECTED");
+				using limits = std::numeric_limits<value_type>;
+				if (head.major == major_type::UINT && head.arg <= std::uint64_t(limits::max()))
+				{
+					v = value_type(head.arg);
+				}
+				else if (std::is_signed_v<value_type> && head.major == major_type::NINT
+					&& head.arg <= std::uint64_t(limits::max()))
+				{
+					//RFC 8949 3.1 negative integer is encoded as -1-N
+					v = value_type(~head.arg);
+				}
+				else
+				{
+					MED_THROW_EXCEPTION(invalid_value, name<IE>(), head.byte, get_context().buffer())
+				}
+			}
+
+			if constexpr (std::is_same_v<bool, decltype(ie.set_encoded(v))>)
+			{
+				if (not ie.set_encoded(v))
+				{
+					MED_THROW_EXCEPTION(invalid_value, name<IE>(), std::size_t(v), get_context().buffer())
+				}
+			}
+			else
+			{
+				ie.set_encoded(v);
+			}
+			CODEC_TRACE("VAL[%s]=%zX: %s", name<IE>(), std::size_t(v), get_context().buffer().toString());
+		}
+	}
+
+	//IE_OCTET_STRING
+	template <class IE> void operator() (IE& ie, IE_OCTET_STRING)
+	{
+		auto const head = get_head<IE>();
+		if (head.major != major_type::BYTES && head.major != major_type::TEXT)
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), head.byte, get_context().buffer())
+		}
+		auto const len = std::size_t(head.arg);
+		if (not ie.set_encoded(len, get_octets<IE>(head.arg), *this))
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), len, get_context().buffer())
+		}
+		CODEC_TRACE("STR[%s] %zu octets: %s", name<IE>(), len, get_context().buffer().toString());
+	}
+
+#ifndef UNIT_TEST
+private:
+#endif
+	struct head_type
+	{
+		uint8_t       byte;  //initial byte
+		major_type    major;
+		std::uint64_t arg;   //value or length or count
+	};
+
+	struct seq_dec
+	{
+		template <class IE, class SEQ>
+		static constexpr bool check(SEQ const&, key_type const& key, decoder&)
+		{
+			return key.template match<IE>();
+		}
+
+		template <class IE, class SEQ>
+		static void apply(SEQ& seq, key_type const&, decoder& me)
+		{
+			using field_t = get_field_type_t<IE>;
+			if constexpr (AMultiField<IE>)
+			{
+				me.decode_multi(seq.template ref<field_t>());
+			}
+			else
+			{
+				med::decode(me, seq.template ref<field_t>());
+			}
+		}
+
+		//unknown entries are skipped
+		template <class SEQ>
+		static void apply(SEQ&, [[maybe_unused]] key_type const& key, decoder& me)
+		{
+			CODEC_TRACE("MAP[%s] skip %s", name<SEQ>(), key.text ? "text key" : "int key");
+			me.template skip<SEQ>(0);
+		}
+	};
+
+	struct seq_check
+	{
+		template <class IE, class SEQ>
+		static void apply(SEQ const& seq, decoder& me)
+		{
+			using field_t = get_field_type_t<IE>;
+			if constexpr (AMultiField<IE>)
+			{
+				check_arity(me, seq.template get<field_t>());
+			}
+			else if constexpr (AMandatory<IE>)
+			{
+				if (not seq.template get<field_t>().is_set())
+				{
+					MED_THROW_EXCEPTION(missing_ie, name<field_t>(), 1, 0, me.get_context().buffer())
+				}
+			}
+		}
+	};
+
+	struct choice_dec
+	{
+		template <class IE, class CHOICE>
+		static constexpr bool check(CHOICE const&, key_type const& key, decoder&)
+		{
+			return key.template match<IE>();
+		}
+
+		template <class IE, class CHOICE>
+		static void apply(CHOICE& ie, key_type const&, decoder& me)
+		{
+			med::decode(me, ie.template ref<get_field_type_t<IE>>(me));
+		}
+
+		template <class CHOICE>
+		static void apply(CHOICE&, key_type const& key, decoder& me)
+		{
+			MED_THROW_EXCEPTION(unknown_tag, name<CHOICE>(), std::size_t(key.value), me.get_context().buffer())
+		}
+	};
+
+	template <class IE>
+	void decode_container(IE& ie)
+	{
+		if constexpr (AMultiField<IE>)
+		{
+			decode_multi(ie);
+		}
+		else
+		{
+			auto const head = get_head<IE>();
+			if (head.major != major_type::MAP)
+			{
+				MED_THROW_EXCEPTION(invalid_value, name<IE>(), head.byte, get_context().buffer())
+			}
+			CODEC_TRACE("MAP[%s] of %zu: %s", name<IE>(), std::size_t(head.arg), get_context().buffer().toString());
+
+			using ies = typename IE::ies_types;
+			if constexpr (std::is_same_v<IE_CHOICE, typename IE::ie_type>)
+			{
+				if (head.arg != 1)
+				{
+					MED_THROW_EXCEPTION(invalid_value, name<IE>(), std::size_t(head.arg), get_context().buffer())
+				}
+				ie.clear();
+				meta::for_if<ies>(choice_dec{}, ie, get_key<IE>(), *this);
+			}
+			else
+			{
+				for (auto n = head.arg; n; --n)
+				{
+					meta::for_if<ies>(seq_dec{}, ie, get_key<IE>(), *this);
+				}
+				meta::foreach<ies>(seq_check{}, ie, *this);
+			}
+		}
+	}
+
+	template <class IE>
+	void decode_multi(IE& ie)
+	{
+		auto const head = get_head<IE>();
+		if (head.major != major_type::ARRAY)
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), head.byte, get_context().buffer())
+		}
+		auto const count = std::size_t(head.arg);
+		CODEC_TRACE("ARRAY[%s] *%zu: %s", name<IE>(), count, get_context().buffer().toString());
+		check_arity(*this, ie, count);
+		ie.reserve(ie.count() + count, *this);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			auto* field = ie.push_back(*this);
+			med::decode(*this, *field);
+		}
+	}
+
+	template <class IE>
+	key_type get_key()
+	{
+		auto const head = get_head<IE>();
+		if (head.major == major_type::UINT)
+		{
+			return key_type{nullptr, head.arg};
+		}
+		if (head.major == major_type::TEXT)
+		{
+			return key_type{reinterpret_cast<char const*>(get_octets<IE>(head.arg)), head.arg};
+		}
+		MED_THROW_EXCEPTION(invalid_value, name<IE>(), head.byte, get_context().buffer())
+	}
+
+	//RFC 8949 3 initial byte and its argument via table of argument sizes
+	template <class IE>
+	head_type get_head()
+	{
+		auto& buf = get_context().buffer();
+		uint8_t const byte = buf.template pop<IE>();
+		head_type head{byte, major_type(byte >> 5), std::uint64_t(byte & 0x1F)};
+		switch (detail::head_table[byte])
+		{
+		case 0: break;
+		case 1: head.arg = buf.template pop<IE>(); break;
+		case 2: head.arg = get_bytes<2, std::uint64_t>(buf.template advance<IE, 2>()); break;
+		case 4: head.arg = get_bytes<4, std::uint64_t>(buf.template advance<IE, 4>()); break;
+		case 8: head.arg = get_bytes<8, std::uint64_t>(buf.template advance<IE, 8>()); break;
+		default:
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), byte, buf)
+		}
+		return head;
+	}
+
+	template <class IE>
+	uint8_t const* get_octets(std::uint64_t len)
+	{
+		auto& buf = get_context().buffer();
+		if (len > buf.size())
+		{
+			MED_THROW_EXCEPTION(overflow, name<IE>(), std::size_t(len), buf)
+		}
+		return buf.template advance<IE>(int(len));
+	}
+
+	//skips an item of any type
+	template <class IE>
+	void skip(std::size_t depth)
+	{
+		if (depth > MAX_DEPTH)
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), depth, get_context().buffer())
+		}
+		auto const head = get_head<IE>();
+		switch (head.major)
+		{
+		case major_type::BYTES:
+		case major_type::TEXT:
+			get_octets<IE>(head.arg);
+			break;
+		case major_type::ARRAY:
+			for (auto n = head.arg; n; --n) { skip<IE>(depth + 1); }
+			break;
+		case major_type::MAP:
+			for (auto n = 2 * head.arg; n; --n) { skip<IE>(depth + 1); }
+			break;
+		case major_type::TAG:
+			skip<IE>(depth + 1);
+			break;
+		default: //the head is the whole item
+			break;
+		}
+	}
+
+	DEC_CTX& m_ctx;
+};
+
+template <class C> explicit decoder(C&) -> decoder<C>;
+
+}	//end: namespace med::cbor
@@ -0,0 +1,280 @@
+/**
+@file
+CBOR (RFC 8949) encoder definition
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <bit>
+#include <cstring>
+
+#include "debug.hpp"
+#include "name.hpp"
+#include "bytes.hpp"
+#include "count.hpp"
+#include "encode.hpp"
+#include "choice.hpp"
+#include "octet_string.hpp"
+#include "cbor.hpp"
+
+namespace med::cbor {
+
+/**
+ * Encodes sequence/set as map keyed by tag of each field or its name,
+ * multi-field as array, integers, booleans and floats as numbers and
+ * octet strings as byte strings.
+ * NOTE: name of IE is its demangled type unless static name() is defined.
+ */
+template <class ENC_CTX>
+struct encoder : info
+{
+	using state_type = typename ENC_CTX::buffer_type::state_type;
+	using allocator_type = typename ENC_CTX::allocator_type;
+
+	explicit encoder(ENC_CTX& ctx_) : m_ctx{ ctx_ }   { }
+	ENC_CTX& get_context() noexcept                   { return m_ctx; }
+	allocator_type& get_allocator()                   { return get_context().get_allocator(); }
+
+	//containers are encoded as maps here
+	struct container_encoder
+	{
+		template <class IE>
+		void operator()(encoder& me, IE const& ie)    { me.encode_container(ie); }
+	};
+
+	//IE_NULL
+	template <class IE> void operator() (IE const&, IE_NULL)
+	{
+		//RFC 8949 3.3 simple value null
+		get_context().buffer().template push<IE>(initial_byte(major_type::SIMPLE, 22));
+	}
+
+	//IE_VALUE
+	template <class IE> void operator() (IE const& ie, IE_VALUE)
+	{
+		if constexpr (AMultiField<IE>)
+		{
+			encode_multi(ie);
+		}
+		else
+		{
+			using value_type = typename IE::value_type;
+			auto const v = ie.get_encoded();
+			if constexpr (std::is_same_v<bool, value_type>)
+			{
+				get_context().buffer().template push<IE>(v ? TRUE : FALSE);
+			}
+			else if constexpr (std::is_floating_point_v<value_type>)
+			{
+				//RFC 8949 3.3 floating-point numbers
+				using bits_type = conditional_t<sizeof(v) == 4, uint32_t, uint64_t>;
+				static_assert(sizeof(bits_type) == sizeof(v), "FLOAT OR DOUBLE EXPECTED");
+				auto* out = get_context().buffer().template advance<IE, 1 + sizeof(v)>();
+				out[0] = sizeof(v) == 4 ? FLOAT32 : FLOAT64;
+				put_bytes<sizeof(v)>(std::bit_cast<bits_type>(v), out + 1);
+			}
+			else if constexpr (std::is_signed_v<value_type>)
+			{
+				//RFC 8949 3.1 negative integer is encoded as -1-N
+				if (v < 0) { put_head<IE>(major_type::NINT, ~std::uint64_t(v)); }
+				else       { put_head<IE>(major_type::UINT, std::uint64_t(v)); }
+			}
+			else
+			{
+				static_assert(std::is_unsigned_v<value_type>, "INTEGRAL VALUE EXPECTED");
+				put_head<IE>(major_type::UINT, v);
+			}
+			CODEC_TRACE("VAL[%s]=%zX: %s", name<IE>(), std::size_t(v), get_context().buffer().toString());
+		}
+	}
+
+	//IE_OCTET_STRING
+	template <class IE> void operator() (IE const& ie, IE_OCTET_STRING)
+	{
+		auto const len = ie.size();
+		put_head<IE>(major_type::BYTES, len);
+		uint8_t* out = get_context().buffer().template advance<IE>(len);
+		octets<IE::traits::min_octets, IE::traits::max_octets>::copy(out, ie.data(), len);
+		CODEC_TRACE("STR[%s] %zu octets: %s", name<IE>(), std::size_t(len), get_context().buffer().toString());
+	}
+
+#ifndef UNIT_TEST
+private:
+#endif
+	template <class IE, class SEQ>
+	static bool is_present(SEQ const& seq)
+	{
+		using field_t = get_field_type_t<IE>;
+		if constexpr (AMultiField<IE>)
+		{
+			return not seq.template get<field_t>().empty();
+		}
+		else if constexpr (AOptional<IE>)
+		{
+			return nullptr != seq.template get<field_t>();
+		}
+		else
+		{
+			return true;
+		}
+	}
+
+	struct seq_count
+	{
+		template <class IE, class SEQ>
+		static void apply(SEQ const& seq, std::size_t& count)
+		{
+			count += (AMandatory<IE> || is_present<IE>(seq)) ? 1 : 0;
+		}
+	};
+
+	struct seq_enc
+	{
+		template <class IE, class SEQ>
+		static void apply(SEQ const& seq, encoder& me)
+		{
+			using field_t = get_field_type_t<IE>;
+			if constexpr (AMultiField<IE>)
+			{
+				auto const& ie = seq.template get<field_t>();
+				if (AMandatory<IE> || not ie.empty())
+				{
+					me.template put_key<IE>();
+					me.encode_multi(ie);
+				}
+			}
+			else if constexpr (AOptional<IE>)
+			{
+				if (auto const* pie = seq.template get<field_t>())
+				{
+					me.template put_key<IE>();
+					med::encode(me, *pie);
+				}
+			}
+			else
+			{
+				auto const& ie = seq.template get<field_t>();
+				if (not ie.is_set())
+				{
+					MED_THROW_EXCEPTION(missing_ie, name<field_t>(), 1, 0, me.get_context().buffer())
+				}
+				me.template put_key<IE>();
+				med::encode(me, ie);
+			}
+		}
+	};
+
+	struct choice_enc : sl::choice_if
+	{
+		template <class IE, class CHOICE>
+		static void apply(CHOICE const& ie, encoder& me)
+		{
+			me.template put_key<IE>();
+			med::encode(me, *ie.template get<get_field_type_t<IE>>());
+		}
+
+		template <class CHOICE>
+		static void apply(CHOICE const& ie, encoder& me)
+		{
+			MED_THROW_EXCEPTION(unknown_tag, name<CHOICE>(), ie.index(), me.get_context().buffer())
+		}
+	};
+
+	template <class IE>
+	void encode_container(IE const& ie)
+	{
+		if constexpr (AMultiField<IE>)
+		{
+			encode_multi(ie);
+		}
+		else if constexpr (std::is_same_v<IE_CHOICE, typename IE::ie_type>)
+		{
+			//single entry map of the alternative
+			if (not ie.is_set())
+			{
+				MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0, get_context().buffer())
+			}
+			put_head<IE>(major_type::MAP, 1);
+			meta::for_if<typename IE::ies_types>(choice_enc{}, ie, *this);
+		}
+		else
+		{
+			using ies = typename IE::ies_types;
+			std::size_t count = 0;
+			meta::foreach<ies>(seq_count{}, ie, count);
+			put_head<IE>(major_type::MAP, count);
+			CODEC_TRACE("MAP[%s] of %zu: %s", name<IE>(), count, get_context().buffer().toString());
+			meta::foreach<ies>(seq_enc{}, ie, *this);
+		}
+	}
+
+	template <class IE>
+	void encode_multi(IE const& ie)
+	{
+		check_arity(*this, ie);
+		put_head<IE>(major_type::ARRAY, ie.count());
+		CODEC_TRACE("ARRAY[%s] *%zu: %s", name<IE>(), ie.count(), get_context().buffer().toString());
+		for (auto& field : ie) { med::encode(*this, field); }
+	}
+
+	template <class IE>
+	void put_key()
+	{
+		if constexpr (detail::has_key_tag<IE>)
+		{
+			put_head<IE>(major_type::UINT, detail::key_value<IE>());
+		}
+		else
+		{
+			char const* const key = name<get_field_type_t<IE>>();
+			auto const len = std::strlen(key);
+			put_head<IE>(major_type::TEXT, len);
+			std::memcpy(get_context().buffer().template advance<IE>(len), key, len);
+		}
+	}
+
+	//RFC 8949 3 initial byte with the shortest argument
+	template <class IE>
+	void put_head(major_type mt, std::uint64_t arg)
+	{
+		auto& buf = get_context().buffer();
+		if (arg < AI_1BYTE)
+		{
+			buf.template push<IE>(initial_byte(mt, uint8_t(arg)));
+		}
+		else if (arg <= 0xFF)
+		{
+			auto* out = buf.template advance<IE, 2>();
+			out[0] = initial_byte(mt, AI_1BYTE);
+			out[1] = uint8_t(arg);
+		}
+		else if (arg <= 0xFFFF)
+		{
+			auto* out = buf.template advance<IE, 3>();
+			out[0] = initial_byte(mt, AI_2BYTES);
+			put_bytes<2>(arg, out + 1);
+		}
+		else if (arg <= 0xFFFF'FFFF)
+		{
+			auto* out = buf.template advance<IE, 5>();
+			out[0] = initial_byte(mt, AI_4BYTES);
+			put_bytes<4>(arg, out + 1);
+		}
+		else
+		{
+			auto* out = buf.template advance<IE, 9>();
+			out[0] = initial_byte(mt, AI_8BYTES);
+			put_bytes<8>(arg, out + 1);
+		}
+	}
+
+	ENC_CTX& m_ctx;
+};
+
+template <class C> explicit encoder(C&) -> encoder<C>;
+
+}	//end: namespace med::cbor
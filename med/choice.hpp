@@ -18,11 +18,30 @@ Distributed under the MIT License
 #include "value.hpp"
 #include "encode.hpp"
 #include "decode.hpp"
+#include "offset_ptr.hpp"
 #include "meta/unique.hpp"
 #include "meta/typelist.hpp"
 
 namespace med {
 
+//marker of choice alternative stored out of line
+struct out_of_line_t {};
+
+template <class T>
+concept AOutOfLine = std::is_base_of_v<out_of_line_t, T>;
+
+/**
+ * Choice alternative which is allocated via allocator of the context when
+ * selected so only a pointer to it is kept in the choice.
+ * Useful for large but rarely used alternatives to keep the choice compact.
+ * @tparam LINKS kind of the pointer (see raw_links and relocatable)
+ */
+template <class IE, class LINKS = raw_links>
+struct out_of_line : IE, out_of_line_t
+{
+	using links = LINKS;
+};
+
 namespace sl {
 
 struct choice_if
@@ -82,7 +101,8 @@ struct choice_clear : choice_if
 	static constexpr void apply(TO& to)
 	{
 		CODEC_TRACE("clear: %s", name<IE>());
-		to.template ref<get_field_type_t<IE>>().clear();
+		//out of line alternative is abandoned since re-allocated on next select
+		if constexpr (not AOutOfLine<IE>) { to.template ref<get_field_type_t<IE>>().clear(); }
 	}
 
 	template <class TO>
@@ -95,7 +115,16 @@ struct choice_copy : choice_if
 	static constexpr void apply(FROM const& from, TO& to, ARGS&&... args)
 	{
 		//CODEC_TRACE("copy: %s", name<IE>());
-		to.template ref<get_field_type_t<IE>>().copy(from.template as<IE>(), std::forward<ARGS>(args)...);
+		if constexpr (AOutOfLine<IE> && sizeof...(ARGS) == 0)
+		{
+			//no allocator to place the alternative
+			null_allocator const none{};
+			to.template ref<get_field_type_t<IE>>(none).copy(from.template as<IE>());
+		}
+		else
+		{
+			to.template ref<get_field_type_t<IE>>(args...).copy(from.template as<IE>(), std::forward<ARGS>(args)...);
+		}
 		if constexpr (not (TO::plain_header or FROM::plain_header))
 		{
 			to.header().copy(from.header(), std::forward<ARGS>(args)...);
@@ -106,6 +135,52 @@ struct choice_copy : choice_if
 	static constexpr void apply(FROM const&, TO&, ARGS&&...) { }
 };
 
+//copy or move (from non-const) of selected alternative into empty choice
+struct choice_take : choice_if
+{
+	template <class IE, class FROM, class TO>
+	static void apply(FROM& from, TO& to)
+	{
+		if constexpr (AOutOfLine<IE>)
+		{
+			static_assert(not std::is_const_v<FROM>, "OUT OF LINE CASE IS MOVED ONLY");
+			new (&to.m_storage) link_t<IE, IE>{&from.template as<IE>()};
+		}
+		else if constexpr (std::is_const_v<FROM>)
+		{
+			new (&to.m_storage) IE(from.template as<IE>());
+		}
+		else
+		{
+			new (&to.m_storage) IE(std::move(from.template as<IE>()));
+		}
+		to.m_index = from.m_index;
+	}
+
+	template <class FROM, class TO>
+	static constexpr void apply(FROM&, TO&) { }
+};
+
+struct choice_ext_size : choice_if
+{
+	template <class IE, class TO>
+	static constexpr std::size_t apply(TO const& to)
+	{
+		auto const& ie = to.template as<IE>();
+		if constexpr (AOutOfLine<IE>)
+		{
+			return sizeof(IE) + alignof(IE) - 1 + field_ext_size(ie);
+		}
+		else
+		{
+			return field_ext_size(ie);
+		}
+	}
+
+	template <class TO>
+	static constexpr std::size_t apply(TO const&) { return 0; }
+};
+
 struct choice_eq : choice_if
 {
 	template <class IE, class CHOICE>
@@ -211,7 +286,7 @@ struct choice_dec
 	static constexpr void apply(TO& to, HEADER const& header, DECODER& decoder, DEPS&... deps)
 	{
 		CODEC_TRACE("CASE[%s] %s", name<IE>(), class_name<IE>());
-		auto& ie = static_cast<IE&>(to.template ref<get_field_type_t<IE>>());
+		auto& ie = static_cast<IE&>(to.template ref<get_field_type_t<IE>>(decoder));
 		//skip 1st TAG meta-info as it's decoded in header
 		using mi = meta::produce_info_t<DECODER, IE>;
 		if constexpr (AContainer<IE>)
@@ -240,9 +315,21 @@ struct choice_dec
 
 namespace detail {
 
+//out of line alternative is stored as pointer
+template <class IE>
+struct choice_storage
+{
+	using type = conditional_t<AOutOfLine<IE>, link_t<IE, IE>, IE>;
+};
+
 template <class L> struct list_aligned_union;
 template <template <class...> class L, class... Ts> struct list_aligned_union<L<Ts...>> : std::aligned_union<0, Ts...> {};
 
+//out of line alternatives need an allocator to copy (see choice::copy)
+template <class L> struct list_copyable;
+template <template <class...> class L, class... Ts>
+struct list_copyable<L<Ts...>> : std::bool_constant<((!AOutOfLine<Ts> && std::is_copy_constructible_v<Ts>) && ...)> {};
+
 template <class HEADER>
 struct choice_header
 {
@@ -273,6 +360,8 @@ template <class... IEs>
 class choice : public IE<IE_CHOICE>
 		, public detail::choice_header< meta::list_first_t<meta::typelist<IEs...>> >
 {
+	using header_base = detail::choice_header< meta::list_first_t<meta::typelist<IEs...>> >;
+
 public:
 	using ies_types = conditional_t<
 		AHasGetTag< meta::list_first_t<meta::typelist<IEs...>> >,
@@ -294,6 +383,33 @@ public:
 	template <class T>
 	static constexpr std::size_t index()    { return meta::list_index_of_v<T, fields_types>; }
 
+	choice() = default;
+	choice(choice const& rhs) requires detail::list_copyable<ies_types>::value
+		: IE<IE_CHOICE>{}, header_base(rhs)         { take(rhs); }
+	choice(choice&& rhs) noexcept
+		: IE<IE_CHOICE>{}, header_base(std::move(rhs)) { take(rhs); }
+
+	choice& operator=(choice const& rhs) requires detail::list_copyable<ies_types>::value
+	{
+		if (this != &rhs)
+		{
+			clear();
+			header_base::operator=(rhs);
+			take(rhs);
+		}
+		return *this;
+	}
+	choice& operator=(choice&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			clear();
+			header_base::operator=(std::move(rhs));
+			take(rhs);
+		}
+		return *this;
+	}
+
 	constexpr void clear()
 	{
 		meta::for_if<ies_types>(sl::choice_clear{}, *this);
@@ -306,20 +422,30 @@ public:
 	constexpr std::size_t calc_length(auto& enc) const
 		{ return meta::for_if<ies_types>(this->header().is_set(), sl::choice_len<TYPE_CTX>{}, *this, enc); }
 
-	template <class T> constexpr T& ref()
+	//NOTE: out of line alternative is selected via allocator of the context
+	template <class T, class... CTX> requires (sizeof...(CTX) <= 1)
+	constexpr T& ref(CTX&... ctx)
 	{
 		//TODO: how to prevent a copy when callee-side re-uses reference by mistake?
 		static_assert(!std::is_const_v<T>, "REFERENCE IS NOT FOR ACCESSING AS CONST");
 		using type = meta::find_t<ies_types, sl::field_at<T>>;
 		static_assert(!std::is_void<type>(), "NO SUCH TYPE IN CHOICE");
+		static_assert(!AOutOfLine<type> || sizeof...(CTX) == 1, "OUT OF LINE CASE IS SELECTED VIA CONTEXT");
 		constexpr auto idx = choice::template index<T>();
-		auto* ie = reinterpret_cast<type*>(&m_storage);
 		if (idx != index())
 		{
+			if constexpr (AOutOfLine<type>)
+			{
+				auto* ie = create<type>(get_allocator(ctx...));
+				new (&m_storage) link_t<type, type>{ie};
+			}
+			else
+			{
+				new (&m_storage) type{};
+			}
 			m_index = idx;
-			new (&m_storage) type{};
 		}
-		return *ie;
+		return as<type>();
 	}
 
 	template <class T> constexpr T const* get() const
@@ -343,6 +469,14 @@ public:
 	constexpr void copy_to(TO& to, ARGS&&... args) const
 	{ meta::for_if<ies_types>(sl::choice_copy{}, *this, to, std::forward<ARGS>(args)...); }
 
+	//size of external storage to copy this choice (see deep_copy)
+	std::size_t external_size() const
+	{
+		std::size_t size = meta::for_if<ies_types>(sl::choice_ext_size{}, *this);
+		if constexpr (not choice::plain_header) { size += sl::field_ext_size(this->header()); }
+		return size;
+	}
+
 	template <class ENCODER>
 	constexpr void encode(ENCODER& encoder) const
 	{ meta::for_if<ies_types>(sl::choice_enc{}, *this, encoder); }
@@ -376,14 +510,28 @@ private:
 	template <class>
 	friend struct sl::choice_len;
 	friend struct sl::choice_copy;
+	friend struct sl::choice_take;
+	friend struct sl::choice_ext_size;
 	friend struct sl::choice_enc;
 	friend struct sl::choice_dec;
 	friend struct sl::choice_eq;
 
-	using storage_type = typename detail::list_aligned_union<ies_types>::type;
+	using storage_type = typename detail::list_aligned_union<meta::transform_t<ies_types, detail::choice_storage>>::type;
+
+	template <class T> constexpr T& as()
+	{
+		if constexpr (AOutOfLine<T>) { return **reinterpret_cast<link_t<T, T>*>(&m_storage); }
+		else { return *reinterpret_cast<T*>(&m_storage); }
+	}
+	template <class T> constexpr T const& as() const    { return const_cast<choice*>(this)->template as<T>(); }
 
-	template <class T> constexpr T& as()                { return *reinterpret_cast<T*>(&m_storage); }
-	template <class T> constexpr T const& as() const    { return *reinterpret_cast<T const*>(&m_storage); }
+	//rhs is left empty when moved from
+	template <class FROM>
+	void take(FROM& rhs)
+	{
+		meta::for_if<ies_types>(sl::choice_take{}, rhs, *this);
+		if constexpr (not std::is_const_v<FROM>) { rhs.m_index = num_types; }
+	}
 
 	std::size_t  m_index {num_types}; //index of selected type in storage
 	storage_type m_storage;
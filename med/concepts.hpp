@@ -97,6 +97,21 @@ concept AOptional = std::is_base_of_v<optional_t, T>;
 template <class T>
 concept AMandatory = !std::is_base_of_v<optional_t, T>;
 
+//field which can be stale i.e. to be reset on access (see generational)
+template <class T>
+concept AStale = requires(T& v)
+{
+	{ v.stale() } -> std::same_as<bool>;
+	{ v.refresh() };
+};
+
+//field which presence is kept by container (see packed_field)
+template <class T>
+concept APacked = requires(T v)
+{
+	{ T::packed_index } -> std::convertible_to<std::size_t>;
+};
+
 //checks if T looks like a functor to test condition of a field presense
 template <typename T>
 concept ACondition = requires(T v)
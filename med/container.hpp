@@ -13,6 +13,7 @@ Distributed under the MIT License
 #include "accessor.hpp"
 #include "length.hpp"
 #include "concepts.hpp"
+#include "presence.hpp"
 #include "sl/field_copy.hpp"
 #include "meta/typelist.hpp"
 #include "meta/foreach.hpp"
@@ -36,10 +37,11 @@ struct cont_copy
 		auto const& from_field = from.m_ies.template as<field_t>();
 		if (from_field.is_set())
 		{
-			auto& to_field = to.m_ies.template as<field_t>();
+			auto& to_field = ref_field(to.m_ies.template as<field_t>());
 			if constexpr (AMultiField<IE>)
 			{
 				to_field.clear();
+				if constexpr (sizeof...(ARGS) == 1) { to_field.reserve(from_field.count(), args...); }
 				for (auto const& rhs : from_field)
 				{
 					auto* p = to_field.push_back(std::forward<ARGS>(args)...);
@@ -134,6 +136,17 @@ struct cont_is
 	static constexpr bool apply(SEQ const&)     { return false; }
 };
 
+struct cont_ext_size
+{
+	static constexpr std::size_t op(std::size_t r1, std::size_t r2) { return r1 + r2; }
+
+	template <class IE, class SEQ>
+	static constexpr std::size_t apply(SEQ const& seq)  { return field_ext_size(static_cast<IE const&>(seq)); }
+
+	template <class SEQ>
+	static constexpr std::size_t apply(SEQ const&)      { return 0; }
+};
+
 struct cont_eq
 {
 	static constexpr bool op(bool r1, bool r2)  { return r1 && r2; }
@@ -178,9 +191,9 @@ public:
 	decltype(auto) ref()
 	{
 		static_assert(!std::is_const_v<FIELD>, "ATTEMPT TO COPY FROM CONST REF");
-		auto& ie = m_ies.template as<FIELD>();
+		auto& ie = ref_field(m_ies.template as<FIELD>());
 		using IE = std::remove_cvref_t<decltype(ie)>;
-		if constexpr (AMultiField<IE>)
+		if constexpr (AMultiField<IE> || APacked<IE>)
 		{
 			return static_cast<IE&>(ie);
 		}
@@ -222,6 +235,9 @@ public:
 
 	bool operator==(container const& rhs) const { return meta::fold<ies_types>(sl::cont_eq{}, this->m_ies, rhs.m_ies); }
 
+	//size of external storage to copy this container (see deep_copy)
+	std::size_t external_size() const       { return meta::fold<ies_types>(sl::cont_ext_size{}, this->m_ies); }
+
 protected:
 	friend struct sl::cont_copy;
 
@@ -242,6 +258,9 @@ protected:
 			static_assert(!std::is_void<IE>(), "NO SUCH FIELD");
 			return static_cast<IE&>(*this);
 		}
+
+		[[no_unique_address]] detail::presence_t<IES...> m_presence;
+		[[no_unique_address]] detail::generation_of_t<IES...> m_generation {};
 	};
 
 	ies_t m_ies;
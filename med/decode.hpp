@@ -162,6 +162,113 @@ constexpr void invoke_dependency(DEPENDENCY const& ie, DEPS& deps)
 	deps.commit(DEPENDENT::dependency(ie));
 }
 
+//decoder of selected IEs only (see decode_only)
+template <class DECODER>
+concept ASelectiveDecoder = requires(DECODER& decoder)
+{
+	typename DECODER::base_decoder;
+	{ decoder.base() } -> std::same_as<typename DECODER::base_decoder&>;
+};
+
+//IE can be skipped by its length w/o decoding: the length is not dependent
+//and if explicit then it leads the IE (after explicit tag if any)
+template <class TYPE_CTX, class IE>
+constexpr bool skippable()
+{
+	using META_INFO = typename TYPE_CTX::meta_info_type;
+	if constexpr (meta::list_is_empty_v<META_INFO>)
+	{
+		return false;
+	}
+	else if constexpr (meta::list_first_t<META_INFO>::kind != mik::LEN)
+	{
+		return false;
+	}
+	else
+	{
+		using len_t = get_info_t<meta::list_first_t<META_INFO>>;
+		using field_t = get_field_type_t<IE>;
+		if constexpr (not std::is_void_v<get_dependency_t<len_t>>)
+		{
+			return false;
+		}
+		else if constexpr (APresentIn<len_t, IE>)
+		{
+			using EXP_TAG = typename TYPE_CTX::explicit_tag_type;
+			if constexpr (not std::is_void_v<EXP_TAG> && leading_in<field_t, EXP_TAG>())
+			{
+				using rest = meta::list_rest_t<typename field_t::ies_types>;
+				return not meta::list_is_empty_v<rest> && std::is_same_v<len_t, get_field_type_t<meta::list_first_t<rest>>>;
+			}
+			else
+			{
+				return leading_in<field_t, len_t>();
+			}
+		}
+		else
+		{
+			return true;
+		}
+	}
+}
+
+//IE neither selected by the decoder nor containing the selected ones
+template <class DECODER, class IE>
+constexpr bool unselected()
+{
+	if constexpr (ASelectiveDecoder<DECODER>)
+	{
+		return not DECODER::template wanted<IE>();
+	}
+	return false;
+}
+
+//IE to decode as whole by the base of selective decoder: the selected one
+//or unselected which can't be skipped w/o meta-info
+template <class DECODER, class TYPE_CTX, class IE>
+constexpr bool decoded_by_base()
+{
+	if constexpr (ASelectiveDecoder<DECODER>)
+	{
+		return DECODER::template selected<IE>()
+			|| (unselected<DECODER, IE>() && meta::list_is_empty_v<typename TYPE_CTX::meta_info_type>);
+	}
+	return false;
+}
+
+//advances the decoder past the IE by its length including padding
+template <class TYPE_CTX, class IE, class DECODER>
+void skip_ie(DECODER& decoder)
+{
+	using len_t = get_info_t<meta::list_first_t<typename TYPE_CTX::meta_info_type>>;
+	using pad_traits = typename get_padding<len_t>::type;
+	CODEC_TRACE("skip %s by %s", name<IE>(), name<len_t>());
+
+	struct no_padder
+	{
+		explicit no_padder(DECODER&) noexcept  { }
+		void add_padding() const noexcept       { }
+	};
+	using pad_t = conditional_t<std::is_void_v<pad_traits>, no_padder
+		, typename DECODER::template padder_type<pad_traits, DECODER>>;
+
+	if constexpr (APresentIn<len_t, IE>) //explicit length counts from the field after, padding from the field
+	{
+		pad_t pad{decoder};
+		len_t len_ie;
+		decoder(len_ie, typename len_t::ie_type{});
+		decoder(ADVANCE_STATE{int(value_to_length(len_ie))});
+		pad.add_padding();
+	}
+	else
+	{
+		auto const len = decode_len<len_t>(decoder);
+		pad_t pad{decoder};
+		decoder(ADVANCE_STATE{int(len)});
+		pad.add_padding();
+	}
+}
+
 template <class TYPE_CTX, class DECODER, class IE, class... DEPS>
 constexpr void ie_decode(DECODER& decoder, IE& ie, DEPS&... deps)
 {
@@ -169,7 +276,15 @@ constexpr void ie_decode(DECODER& decoder, IE& ie, DEPS&... deps)
 	using EXP_TAG = typename TYPE_CTX::explicit_tag_type;
 	using EXP_LEN = typename TYPE_CTX::explicit_length_type;
 
-	if constexpr (not meta::list_is_empty_v<META_INFO>)
+	if constexpr (decoded_by_base<DECODER, TYPE_CTX, IE>())
+	{
+		ie_decode<TYPE_CTX>(decoder.base(), ie, deps...);
+	}
+	else if constexpr (unselected<DECODER, IE>() && skippable<TYPE_CTX, IE>())
+	{
+		skip_ie<TYPE_CTX, IE>(decoder);
+	}
+	else if constexpr (not meta::list_is_empty_v<META_INFO>)
 	{
 		static_assert(std::is_void_v<typename TYPE_CTX::dependent_type>);
 		static_assert(std::is_void_v<typename TYPE_CTX::dependency_type>);
@@ -211,12 +326,24 @@ constexpr void ie_decode(DECODER& decoder, IE& ie, DEPS&... deps)
 		if constexpr (AContainer<IE>)
 		{
 			CODEC_TRACE(">>> %s<%s:%s>", name<IE>(), name<EXP_TAG>(), name<EXP_LEN>());
-			if constexpr (not std::is_void_v<EXP_TAG>)
+			//special case for codecs w/o structure driven by meta-info
+			if constexpr (requires { typename DECODER::container_decoder; })
+			{
+				typename DECODER::container_decoder{}(decoder, ie, deps...);
+			}
+			else if constexpr (not std::is_void_v<EXP_TAG>)
 			{
-				static_assert(std::is_void_v<EXP_LEN>);
 				static_assert(std::is_same_v<EXP_TAG, get_field_type_t<meta::list_first_t<typename IE::ies_types>>>);
 				/* NOTE: 1st IE is expected to be explicit so it s.b. skipped as was decoded in meta */
-				ie.template decode<meta::list_rest_t<typename IE::ies_types>>(decoder, deps...);
+				if constexpr (not std::is_void_v<EXP_LEN>)
+				{
+					using ctx = type_context<typename TYPE_CTX::ie_type, meta::typelist<>, void, EXP_LEN>;
+					ie.template decode<meta::list_rest_t<typename IE::ies_types>, ctx>(decoder, deps...);
+				}
+				else
+				{
+					ie.template decode<meta::list_rest_t<typename IE::ies_types>>(decoder, deps...);
+				}
 			}
 			else if constexpr (not std::is_void_v<EXP_LEN>)
 			{
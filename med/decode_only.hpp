@@ -0,0 +1,86 @@
+/**
+@file
+decoding of selected IEs only skipping the rest by their length
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <type_traits>
+
+#include "decode.hpp"
+
+namespace med {
+
+namespace detail {
+
+template <class IE, class... FIELDS>
+constexpr bool contains();
+
+template <class L, class... FIELDS>
+struct any_contains;
+
+template <template <class...> class L, class... IES, class... FIELDS>
+struct any_contains<L<IES...>, FIELDS...>
+{
+	static constexpr bool value = (contains<IES, FIELDS...>() || ...);
+};
+
+//IE is one of FIELDS or has one of them inside at any depth
+template <class IE, class... FIELDS>
+constexpr bool contains()
+{
+	using field_t = get_field_type_t<IE>;
+	if constexpr ((std::is_same_v<field_t, FIELDS> || ...))
+	{
+		return true;
+	}
+	else if constexpr (AContainer<field_t>)
+	{
+		return any_contains<typename field_t::ies_types, FIELDS...>::value;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+}	//end: namespace detail
+
+/**
+ * Decoder of FIELDS only: other IEs with length are skipped w/o decoding
+ * and the rest is decoded as usual.
+ * @details Skipped IEs are left unset and their presence is not checked.
+ */
+template <class DECODER, class... FIELDS>
+struct selective_decoder : DECODER
+{
+	using base_decoder = DECODER;
+
+	explicit selective_decoder(DECODER const& decoder) : DECODER{decoder} { }
+
+	DECODER& base() noexcept                            { return *this; }
+
+	template <class IE>
+	static constexpr bool selected()                    { return (std::is_same_v<get_field_type_t<IE>, FIELDS> || ...); }
+	template <class IE>
+	static constexpr bool wanted()                      { return detail::contains<IE, FIELDS...>(); }
+};
+
+/**
+ * Decodes FIELDS of IE skipping the IEs w/o FIELDS by their length.
+ * E.g. decode_only<origin_host>(octet_decoder{ctx}, msg);
+ */
+template <class... FIELDS, class DECODER, AHasIeType IE, class... DEPS>
+constexpr void decode_only(DECODER&& decoder, IE& ie, DEPS&... deps)
+{
+	static_assert(sizeof...(FIELDS) > 0, "NO FIELDS TO DECODE");
+	static_assert((detail::contains<IE, FIELDS>() && ...), "FIELD IS NOT IN IE");
+	selective_decoder<std::remove_cvref_t<DECODER>, FIELDS...> selective{decoder};
+	decode(selective, ie, deps...);
+}
+
+}	//end: namespace med
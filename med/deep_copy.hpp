@@ -0,0 +1,75 @@
+/**
+@file
+deep copy of message into single block of allocator space
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "allocator.hpp"
+#include "exception.hpp"
+#include "name.hpp"
+#include "field.hpp"
+#include "sl/field_copy.hpp"
+
+namespace med {
+
+namespace detail {
+
+//bump pointer over the block of upfront computed size thus w/o checks
+class block_allocator
+{
+public:
+	explicit block_allocator(void* block) noexcept : m_next{std::bit_cast<uintptr_t>(block)} {}
+
+	[[nodiscard]]
+	void* allocate(std::size_t bytes, std::size_t alignment) noexcept
+	{
+		uintptr_t const p = (m_next + alignment - 1) & -alignment;
+		m_next = p + bytes;
+		return std::bit_cast<void*>(p);
+	}
+
+private:
+	uintptr_t m_next;
+};
+
+} //end: namespace detail
+
+/**
+ * Copies the message with all its external parts (multi-field nodes,
+ * out of line alternatives and allocated octets) into the destination.
+ * @details The size of external storage is computed upfront and taken from
+ * the allocator as one block. The copy then takes space from the block w/o
+ * checks and nodes of each multi-field are reserved at once.
+ * NOTE: it pays off with costly allocators (e.g. pmr pools) only, with a bump
+ * allocator (e.g. med::allocator) copy() is faster by the sizing pass.
+ * @param to destination message (cleared before copy)
+ * @param from source message
+ * @param alloc allocator (or context providing one) of destination
+ */
+template <class IE, class ALLOC>
+void deep_copy(IE& to, IE const& from, ALLOC& alloc)
+{
+	to.clear();
+	if (std::size_t const size = sl::field_ext_size(from))
+	{
+		void* block = get_allocator(alloc).allocate(size, alignof(std::max_align_t));
+		if (!block) { MED_THROW_EXCEPTION(out_of_memory, name<IE>(), size) }
+		detail::block_allocator space{block};
+		sl::field_copy(to, from, space);
+	}
+	else
+	{
+		sl::field_copy(to, from);
+	}
+}
+
+}	//end: namespace med
@@ -11,6 +11,7 @@ Distributed under the MIT License
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <iterator>
 
 #include "ie_type.hpp"
@@ -20,6 +21,7 @@ Distributed under the MIT License
 #include "meta/typelist.hpp"
 #include "allocator.hpp"
 #include "concepts.hpp"
+#include "offset_ptr.hpp"
 
 
 namespace med {
@@ -35,6 +37,24 @@ struct field_t : FIELD
 	using meta_info = meta::append_t<get_meta_info_t<META_INFO>..., get_meta_info_t<FIELD>>;
 };
 
+namespace sl {
+
+//size of external storage (allocator space) needed to copy the field
+template <class IE>
+constexpr std::size_t field_ext_size(IE const& ie)
+{
+	if constexpr (requires { ie.external_size(); })
+	{
+		return ie.is_set() ? ie.external_size() : 0;
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+} //end: namespace sl
+
 namespace detail {
 
 template <std::size_t MIN, class CMAX>
@@ -66,11 +86,13 @@ public:
 	using ie_type = typename FIELD::ie_type;
 	using field_type = field_t<FIELD, FIELD_META_INFO...>;
 
+	//NOTE: links are self-relative if FIELD::links is relocatable
 	struct field_value
 	{
-		field_type   value;
-		field_value* next;
+		field_type                  value;
+		link_t<FIELD, field_value>  next;
 	};
+	using link_type = link_t<FIELD, field_value>;
 
 	static constexpr std::size_t min = MIN;
 	static constexpr std::size_t max = CMAX::value;
@@ -79,6 +101,16 @@ public:
 	multi_field(multi_field const&) = delete;
 	multi_field& operator= (multi_field const&) = delete;
 	multi_field() = default;
+	multi_field(multi_field&& rhs) noexcept                 { take(rhs); }
+	multi_field& operator= (multi_field&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			clear();
+			take(rhs);
+		}
+		return *this;
+	}
 
 private:
 	template <class T>
@@ -121,6 +153,7 @@ public:
 	{
 		for (auto& v : *this) { v.clear(); }
 		m_head = m_tail = nullptr;
+		m_num_spare = 0;
 		m_count = 0;
 	}
 	bool is_set() const                                     { return not empty() && m_head->value.is_set(); }
@@ -137,14 +170,51 @@ public:
 	//NOTE: check for max is done during encode/decode
 	template <class CTX> field_type* push_back(CTX& ctx)
 	{
-		auto* pf = get_free_inplace(); //try inplace 1st then external
+		auto* pf = get_free_inplace(); //try inplace 1st then reserved then external
+		if (!pf) { pf = pop_spare(); }
 		return append(pf ? pf : create<field_value>(get_allocator(ctx)));
 	}
 
+	/**
+	 * Reserves external storage to hold num fields in total by single allocation.
+	 * @details The storage is only reserved when inplace one is not enough and
+	 * there is no reserved storage left. It's a hint thus failed allocation
+	 * (incl. out_of_memory thrown by allocator) is ignored and fields are
+	 * allocated one by one then.
+	 * NOTE: num should be known (e.g. count on the wire) since unused reserved
+	 * storage is not returned to allocator. It's dropped by clear.
+	 */
+	template <class CTX> void reserve(std::size_t num, CTX& ctx)
+	{
+		std::size_t const free_inplace = count() < inplace ? inplace - count() : 0;
+		if (m_num_spare || num <= count() + free_inplace) { return; }
+
+		auto& alloc = get_allocator(ctx);
+		if constexpr (not std::is_same_v<null_allocator, std::remove_cvref_t<decltype(alloc)>>)
+		{
+			std::size_t const num_nodes = num - count() - free_inplace;
+			CODEC_TRACE("%s(%s) %zu nodes", __FUNCTION__, name<field_type>(), num_nodes);
+			void* p = nullptr;
+			try
+			{
+				p = alloc.allocate(num_nodes * sizeof(field_value), alignof(field_value));
+			}
+			catch (out_of_memory const&)
+			{
+				CODEC_TRACE("%s(%s) no space for %zu nodes", __FUNCTION__, name<field_type>(), num_nodes);
+			}
+			if (p)
+			{
+				m_spare = static_cast<field_value*>(p);
+				m_num_spare = num_nodes;
+			}
+		}
+	}
+
 	//won't recover space if external storage was used
 	void pop_back()
 	{
-		if (auto* prev = m_head)
+		if (field_value* prev = m_head)
 		{
 			//clear the last
 			--m_count;
@@ -212,7 +282,57 @@ public:
 		return count() == rhs.count() && std::equal(begin(), end(), rhs.begin());
 	}
 
+	//size of external storage to copy this field (upper bound incl. alignment)
+	std::size_t external_size() const
+	{
+		std::size_t size = 0, index = 0;
+		for (auto const& v : *this)
+		{
+			size += sl::field_ext_size(v);
+			if (index++ >= inplace) { size += sizeof(field_value) + alignof(field_value) - 1; }
+		}
+		return size;
+	}
+
 private:
+	bool is_inplace(field_value const* p) const noexcept
+	{
+		return not std::less<>{}(p, m_fields) && std::less<>{}(p, m_fields + inplace);
+	}
+
+	//reserved nodes are constructed on demand
+	field_value* pop_spare() noexcept
+	{
+		if (0 == m_num_spare) { return nullptr; }
+		--m_num_spare;
+		field_value* pf = m_spare;
+		m_spare = pf + 1;
+		return new (pf) field_value{};
+	}
+
+	//steals external nodes of empty rhs while moving inplace ones
+	void take(multi_field& rhs) noexcept
+	{
+		std::size_t index = 0;
+		for (field_value* node = rhs.m_head; node; )
+		{
+			field_value* next = node->next;
+			if (rhs.is_inplace(node))
+			{
+				auto& slot = m_fields[index++];
+				slot.value = std::move(node->value);
+				node->value.clear();
+				node = &slot;
+			}
+			append(node);
+			node = next;
+		}
+		m_spare = rhs.m_spare;
+		m_num_spare = rhs.m_num_spare;
+		rhs.m_head = rhs.m_tail = nullptr;
+		rhs.m_count = rhs.m_num_spare = 0;
+	}
+
 	//find unset inplace slot
 	field_value* get_free_inplace()
 	{
@@ -239,10 +359,12 @@ private:
 		return &m_tail->value;
 	}
 
-	field_value* m_head {nullptr};
-	field_value* m_tail {nullptr};
-	std::size_t  m_count {0};
-	field_value  m_fields[inplace];
+	link_type   m_head {nullptr};
+	link_type   m_tail {nullptr};
+	link_type   m_spare {nullptr}; //1st of reserved external nodes
+	std::size_t m_num_spare {0};
+	std::size_t m_count {0};
+	field_value m_fields[inplace];
 };
 
 }	//end: namespace med
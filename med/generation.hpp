@@ -0,0 +1,153 @@
+/**
+@file
+containers for high-rate reuse with O(1) reset via generation counter
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "concepts.hpp"
+#include "sequence.hpp"
+#include "set.hpp"
+#include "meta/foreach.hpp"
+
+namespace med {
+
+/**
+ * IE of container stamped with generation it was last accessed for write.
+ * @details The field is stale when its stamp differs from the current
+ * generation of the container and reads as unset then. Actual reset of the
+ * field is deferred until write access (see ref_field) thus clear of the
+ * container only increments its generation.
+ * NOTE: the field can only live within the container OWNER.
+ */
+template <class IE, class OWNER>
+class generational : public IE
+{
+public:
+	bool stale() const noexcept         { return m_stamp != generation(); }
+	bool is_set() const                 { return not stale() && IE::is_set(); }
+	void clear()                        { IE::clear(); m_stamp = generation(); }
+
+	//resets stale IE to be accessed for write
+	void refresh()
+	{
+		if (stale()) { clear(); }
+	}
+
+	template <class FROM, class... ARGS>
+	void copy(FROM const& from, ARGS&&... args)
+	{
+		refresh();
+		IE::copy(from, std::forward<ARGS>(args)...);
+	}
+
+	//multi-field reads as empty when stale
+	std::size_t count() const requires AMultiField<IE>   { return stale() ? 0 : IE::count(); }
+	bool empty() const requires AMultiField<IE>          { return stale() || IE::empty(); }
+	auto begin() const requires AMultiField<IE>          { return stale() ? IE::end() : IE::begin(); }
+	auto end() const requires AMultiField<IE>            { return IE::end(); }
+	auto begin() requires AMultiField<IE>                { return stale() ? IE::end() : IE::begin(); }
+	auto end() requires AMultiField<IE>                  { return IE::end(); }
+	auto first() const requires AMultiField<IE>          { return stale() ? nullptr : IE::first(); }
+	auto last() const requires AMultiField<IE>           { return stale() ? nullptr : IE::last(); }
+
+	bool operator==(generational const& rhs) const
+	{
+		if (stale() || rhs.stale()) { return not is_set() && not rhs.is_set(); }
+		return static_cast<IE const&>(*this) == static_cast<IE const&>(rhs);
+	}
+
+private:
+	//NOTE: deferred till OWNER is complete
+	template <class O = OWNER>
+	generation_t generation() const noexcept
+	{
+		return static_cast<typename O::ies_t const&>(*this).m_generation;
+	}
+
+	generation_t m_stamp {0};
+};
+
+namespace detail {
+
+//IEs with setter are encoded from temporary copy thus kept plain
+template <class IE, class OWNER>
+struct gen_ie
+{
+	using type = generational<IE, OWNER>;
+};
+template <AHasSetterType IE, class OWNER>
+struct gen_ie<IE, OWNER>
+{
+	using type = IE;
+};
+
+} //end: namespace detail
+
+namespace sl {
+
+//stale IEs are reset on wrap-around of generation, plain ones on each clear
+struct gen_clear
+{
+	template <class IE, class IES>
+	static void apply(IES& ies, bool wrapped)
+	{
+		if constexpr (AStale<IE>)
+		{
+			if (wrapped) { static_cast<IE&>(ies).clear(); }
+		}
+		else
+		{
+			static_cast<IE&>(ies).clear();
+		}
+	}
+};
+
+} //end: namespace sl
+
+namespace detail {
+
+//container of generational IEs which is cleared by increment of its generation
+template <template <class...> class CONT, class OWNER, class... IES>
+class gen_container : public CONT<typename gen_ie<IES, OWNER>::type...>
+{
+	using base_t = CONT<typename gen_ie<IES, OWNER>::type...>;
+
+public:
+	using typename base_t::ies_t;
+
+	generation_t generation() const noexcept        { return this->m_ies.m_generation; }
+
+	//O(1) reset: all IEs become stale (each is reset on its next write)
+	void clear()
+	{
+		//wrapped around: stamps can't be trusted anymore
+		bool const wrapped = (0 == ++this->m_ies.m_generation);
+		meta::foreach<typename base_t::ies_types>(sl::gen_clear{}, this->m_ies, wrapped);
+	}
+	template <class FIELD>
+	void clear()                                    { base_t::template clear<FIELD>(); }
+};
+
+} //end: namespace detail
+
+/**
+ * Sequence and set to be decoded into repeatedly w/o full reset.
+ * @details Presence of each IE is tied to the generation of container thus
+ * clear() is a single increment regardless of the container size while
+ * the memory of IEs is only touched when they are accessed for write again.
+ * The cost is a stamp per IE. IEs with setter are cleared as usual.
+ */
+template <class... IES>
+struct gen_sequence : detail::gen_container<sequence, gen_sequence<IES...>, IES...> {};
+
+template <class... IES>
+struct gen_set : detail::gen_container<set, gen_set<IES...>, IES...> {};
+
+} //end: namespace med
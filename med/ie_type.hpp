@@ -75,6 +75,18 @@ constexpr bool explicit_meta_in()
 	return false;
 }
 
+//check if sequence starts with given IE (e.g. its tag or compound header)
+//thus the IE decoded beforehand is assigned and the rest is decoded after
+template <class CONT, class FIRST>
+constexpr bool leading_in()
+{
+	if constexpr (std::is_same_v<IE_SEQUENCE, typename CONT::ie_type>)
+	{
+		return std::is_same_v<FIRST, get_field_type_t<meta::list_first_t<typename CONT::ies_types>>>;
+	}
+	return false;
+}
+
 template <
 	class IE_TYPE,
 	class META_INFO = meta::typelist<>,
@@ -0,0 +1,95 @@
+/**
+@file
+multi-field with secondary index to find its fields by key
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <type_traits>
+
+#include "concepts.hpp"
+#include "offset_ptr.hpp"
+
+namespace med {
+
+/**
+ * Multi-field which fields can be found by the key extracted via KEY functor.
+ * @details The index is a sorted array of keys built on first lookup after
+ * the field was modified (push_back/pop_back/erase/clear) thus it's built once
+ * after decode and each lookup is a binary search then. With more than
+ * CAPACITY fields the lookup falls back to linear search.
+ * NOTE: change of a key via reference to the field is not tracked, use reindex.
+ * @tparam IE multi-field IE (e.g. optional<..., inf>)
+ * @tparam KEY functor returning the key of field
+ * @tparam CAPACITY max number of fields in the index
+ */
+template <AMultiField IE, class KEY, std::size_t CAPACITY = 32>
+class indexed : public IE
+{
+public:
+	using field_type = typename IE::field_type;
+	using key_type = std::remove_cvref_t<std::invoke_result_t<KEY, field_type const&>>;
+
+	indexed() = default;
+	indexed(indexed&& rhs) noexcept : IE(std::move(rhs))                 { }
+	indexed& operator=(indexed&& rhs) noexcept { IE::operator=(std::move(rhs)); reindex(); return *this; }
+
+	//first field with the key or nullptr
+	field_type const* find(key_type const& key) const
+	{
+		if (this->count() > CAPACITY)
+		{
+			auto it = std::find_if(this->begin(), this->end(), [&key](auto const& f) { return KEY{}(f) == key; });
+			return it == this->end() ? nullptr : &*it;
+		}
+
+		if (m_dirty) { build(); }
+		auto const end = m_index.begin() + m_size;
+		auto const it = std::lower_bound(m_index.begin(), end, key, [](entry const& e, key_type const& k) { return e.key < k; });
+		return (it != end && it->key == key) ? it->field : nullptr;
+	}
+	field_type* find(key_type const& key)    { return const_cast<field_type*>(std::as_const(*this).find(key)); }
+
+	//invalidates the index to rebuild it on next lookup
+	void reindex() noexcept                  { m_dirty = true; }
+
+	template <class... ARGS>
+	field_type* push_back(ARGS&&... args)    { reindex(); return IE::push_back(std::forward<ARGS>(args)...); }
+	void pop_back()                          { reindex(); IE::pop_back(); }
+	auto erase(typename IE::iterator pos)    { reindex(); return IE::erase(pos); }
+	void clear()                             { reindex(); IE::clear(); }
+
+private:
+	struct entry
+	{
+		key_type                             key;
+		link_t<field_type, field_type const> field;
+	};
+
+	//insertion sort (stable and w/o allocation) keeps the first of duplicate keys first
+	void build() const
+	{
+		m_size = 0;
+		for (auto const& f : *this)
+		{
+			entry e{KEY{}(f), &f};
+			auto i = m_size++;
+			for (; i && e.key < m_index[i - 1].key; --i) { m_index[i] = m_index[i - 1]; }
+			m_index[i] = e;
+		}
+		m_dirty = false;
+	}
+
+	mutable std::array<entry, CAPACITY> m_index;
+	mutable std::size_t                 m_size {0};
+	mutable bool                        m_dirty {true};
+};
+
+}	//end: namespace med
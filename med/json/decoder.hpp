@@ -0,0 +1,557 @@
+/**
+@file
+JSON (RFC 8259) decoder definition
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <charconv>
+#include <cstring>
+
+#include "debug.hpp"
+#include "name.hpp"
+#include "count.hpp"
+#include "decode.hpp"
+#include "choice.hpp"
+#include "octet_string.hpp"
+#include "json.hpp"
+
+namespace med::json {
+
+/**
+ * Decodes objects into sequence/set (members in any order, unknown ones are skipped)
+ * using compile-time table of member names, arrays into multi-fields and numbers
+ * via std::from_chars. Strings w/o escapes are not copied (for octets_var_extern)
+ * while the ones with escapes and hex strings are decoded into allocated space.
+ * NOTE: names of members are matched as is (i.e. w/o unescaping).
+ */
+template <class DEC_CTX>
+struct decoder : info
+{
+	using state_type = typename DEC_CTX::buffer_type::state_type;
+	using size_state = typename DEC_CTX::buffer_type::size_state;
+	using allocator_type = typename DEC_CTX::allocator_type;
+
+	explicit decoder(DEC_CTX& ctx_) : m_ctx{ ctx_ } { }
+	DEC_CTX& get_context() noexcept             { return m_ctx; }
+	allocator_type& get_allocator()             { return get_context().get_allocator(); }
+
+	//containers are decoded from objects here
+	struct container_decoder
+	{
+		template <class IE>
+		void operator()(decoder& me, IE& ie)    { me.decode_container(ie); }
+	};
+
+	//IE_NULL
+	template <class IE> void operator() (IE&, IE_NULL)
+	{
+		skip_ws();
+		if (not accept("null"))
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), 0, get_context().buffer())
+		}
+	}
+
+	//IE_VALUE
+	template <class IE> void operator() (IE& ie, IE_VALUE)
+	{
+		if constexpr (AMultiField<IE>)
+		{
+			decode_multi(ie);
+		}
+		else
+		{
+			using value_type = typename IE::value_type;
+			skip_ws();
+			value_type v;
+			if constexpr (std::is_same_v<bool, value_type>)
+			{
+				if (accept("true")) { v = true; }
+				else if (accept("false")) { v = false; }
+				else
+				{
+					MED_THROW_EXCEPTION(invalid_value, name<IE>(), 0, get_context().buffer())
+				}
+			}
+			else
+			{
+				static_assert(std::is_arithmetic_v<value_type>, "NUMERIC VALUE EXPECTED");
+				auto& buf = get_context().buffer();
+				auto const* first = reinterpret_cast<char const*>(buf.begin());
+				auto const [last, ec] = std::from_chars(first, reinterpret_cast<char const*>(buf.end()), v);
+				if (ec != std::errc{})
+				{
+					MED_THROW_EXCEPTION(invalid_value, name<IE>(), 0, buf)
+				}
+				buf.template advance<IE>(int(last - first));
+			}
+
+			if constexpr (std::is_same_v<bool, decltype(ie.set_encoded(v))>)
+			{
+				if (not ie.set_encoded(v))
+				{
+					MED_THROW_EXCEPTION(invalid_value, name<IE>(), std::size_t(v), get_context().buffer())
+				}
+			}
+			else
+			{
+				ie.set_encoded(v);
+			}
+			CODEC_TRACE("VAL[%s]: %s", name<IE>(), get_context().buffer().toString());
+		}
+	}
+
+	//IE_OCTET_STRING
+	template <class IE> void operator() (IE& ie, IE_OCTET_STRING)
+	{
+		skip_ws();
+		auto const str = get_string<IE>();
+		std::string_view s = str.raw;
+		if constexpr (AText<IE>)
+		{
+			if (str.escaped) { s = unescape<IE>(s); }
+		}
+		else
+		{
+			s = unhex<IE>(s);
+		}
+		if (not ie.set_encoded(s.size(), s.data(), *this))
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), s.size(), get_context().buffer())
+		}
+		CODEC_TRACE("STR[%s] %zu octets: %s", name<IE>(), s.size(), get_context().buffer().toString());
+	}
+
+#ifndef UNIT_TEST
+private:
+#endif
+	struct string_type
+	{
+		std::string_view raw;     //w/o quotes as is
+		bool             escaped; //has escapes
+	};
+
+	struct seq_dec
+	{
+		template <class IE, class SEQ>
+		static constexpr bool check(SEQ const&, std::size_t index, decoder&)
+		{
+			return index == meta::list_index_of_v<IE, typename SEQ::ies_types>;
+		}
+
+		template <class IE, class SEQ>
+		static void apply(SEQ& seq, std::size_t, decoder& me)
+		{
+			using field_t = get_field_type_t<IE>;
+			if constexpr (AOptional<IE>)
+			{
+				//null stands for absent optional
+				if (me.accept("null")) { return; }
+			}
+			if constexpr (AMultiField<IE>)
+			{
+				me.decode_multi(seq.template ref<field_t>());
+			}
+			else
+			{
+				med::decode(me, seq.template ref<field_t>());
+			}
+		}
+
+		//unknown members are skipped
+		template <class SEQ>
+		static void apply(SEQ&, std::size_t, decoder& me)
+		{
+			CODEC_TRACE("OBJ[%s] skip unknown", name<SEQ>());
+			me.template skip<SEQ>(0);
+		}
+	};
+
+	struct seq_check
+	{
+		template <class IE, class SEQ>
+		static void apply(SEQ const& seq, decoder& me)
+		{
+			using field_t = get_field_type_t<IE>;
+			if constexpr (AMultiField<IE>)
+			{
+				check_arity(me, seq.template get<field_t>());
+			}
+			else if constexpr (AMandatory<IE>)
+			{
+				if (not seq.template get<field_t>().is_set())
+				{
+					MED_THROW_EXCEPTION(missing_ie, name<field_t>(), 1, 0, me.get_context().buffer())
+				}
+			}
+		}
+	};
+
+	struct choice_dec
+	{
+		template <class IE, class CHOICE>
+		static constexpr bool check(CHOICE const&, std::size_t index, decoder&)
+		{
+			return index == meta::list_index_of_v<IE, typename CHOICE::ies_types>;
+		}
+
+		template <class IE, class CHOICE>
+		static void apply(CHOICE& ie, std::size_t, decoder& me)
+		{
+			med::decode(me, ie.template ref<get_field_type_t<IE>>(me));
+		}
+
+		template <class CHOICE>
+		static void apply(CHOICE&, std::size_t index, decoder& me)
+		{
+			MED_THROW_EXCEPTION(unknown_tag, name<CHOICE>(), index, me.get_context().buffer())
+		}
+	};
+
+	template <class IE>
+	void decode_container(IE& ie)
+	{
+		if constexpr (AMultiField<IE>)
+		{
+			decode_multi(ie);
+		}
+		else
+		{
+			using ies = typename IE::ies_types;
+			skip_ws();
+			expect<IE>('{');
+			CODEC_TRACE("OBJ[%s]: %s", name<IE>(), get_context().buffer().toString());
+			if constexpr (std::is_same_v<IE_CHOICE, typename IE::ie_type>)
+			{
+				//choice is object of exactly one member
+				ie.clear();
+				meta::for_if<ies>(choice_dec{}, ie, get_key<IE, ies>(), *this);
+				skip_ws();
+				expect<IE>('}');
+			}
+			else
+			{
+				skip_ws();
+				if (not accept("}"))
+				{
+					do
+					{
+						meta::for_if<ies>(seq_dec{}, ie, get_key<IE, ies>(), *this);
+						skip_ws();
+					}
+					while (next<IE>('}'));
+				}
+				meta::foreach<ies>(seq_check{}, ie, *this);
+			}
+		}
+	}
+
+	template <class IE>
+	void decode_multi(IE& ie)
+	{
+		skip_ws();
+		expect<IE>('[');
+		CODEC_TRACE("ARRAY[%s]: %s", name<IE>(), get_context().buffer().toString());
+		skip_ws();
+		if (not accept("]"))
+		{
+			do
+			{
+				if (ie.count() >= IE::max)
+				{
+					MED_THROW_EXCEPTION(extra_ie, name<IE>(), IE::max, ie.count() + 1, get_context().buffer())
+				}
+				auto* field = ie.push_back(*this);
+				med::decode(*this, *field);
+				skip_ws();
+			}
+			while (next<IE>(']'));
+		}
+		check_arity(*this, ie);
+	}
+
+	//index of the member in IES named by key (IES size if unknown) followed by colon
+	template <class IE, class IES>
+	std::size_t get_key()
+	{
+		skip_ws();
+		auto const key = get_string<IE>().raw;
+		auto hval = key_hash::init;
+		for (char const c : key) { hval = key_hash::update(c, hval); }
+		skip_ws();
+		expect<IE>(':');
+		skip_ws();
+		return detail::key_table<IES>::find(key, hval);
+	}
+
+	void skip_ws()
+	{
+		auto& buf = get_context().buffer();
+		auto const* p = buf.begin();
+		for (auto const* end = buf.end(); p != end; ++p)
+		{
+			if (*p != ' ' && *p != '\n' && *p != '\r' && *p != '\t') { break; }
+		}
+		buf.offset(int(p - buf.begin()));
+	}
+
+	//consumes the literal if it's next
+	template <std::size_t N>
+	bool accept(char const (&s)[N])
+	{
+		auto& buf = get_context().buffer();
+		if (buf.size() >= N - 1 && 0 == std::memcmp(buf.begin(), s, N - 1))
+		{
+			buf.offset(int(N - 1));
+			return true;
+		}
+		return false;
+	}
+
+	template <class IE>
+	void expect(char c)
+	{
+		if (auto const v = get_context().buffer().template pop<IE>(); v != uint8_t(c))
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), v, get_context().buffer())
+		}
+	}
+
+	//true if a comma is next or false if the closing char
+	template <class IE>
+	bool next(char closing)
+	{
+		auto const v = get_context().buffer().template pop<IE>();
+		if (v == ',') { return true; }
+		if (v == uint8_t(closing)) { return false; }
+		MED_THROW_EXCEPTION(invalid_value, name<IE>(), v, get_context().buffer())
+	}
+
+	template <class IE>
+	string_type get_string()
+	{
+		expect<IE>('"');
+		auto& buf = get_context().buffer();
+		auto const* start = buf.begin();
+		auto const* p = start;
+		auto const* end = buf.end();
+		bool escaped = false;
+		for (; p != end && *p != '"'; ++p)
+		{
+			if (*p == '\\')
+			{
+				escaped = true;
+				if (++p == end) { break; }
+			}
+			else if (*p < 0x20)
+			{
+				MED_THROW_EXCEPTION(invalid_value, name<IE>(), *p, buf)
+			}
+		}
+		if (p == end)
+		{
+			MED_THROW_EXCEPTION(overflow, name<IE>(), std::size_t(p - start) + 1, buf)
+		}
+		buf.offset(int(p - start) + 1);
+		return {std::string_view{reinterpret_cast<char const*>(start), std::size_t(p - start)}, escaped};
+	}
+
+	template <class IE>
+	char* allocate(std::size_t len)
+	{
+		auto* p = static_cast<char*>(get_allocator().allocate(len, 1));
+		if (!p) { MED_THROW_EXCEPTION(out_of_memory, name<IE>(), len) }
+		return p;
+	}
+
+	static constexpr int from_hex(char c)
+	{
+		if (c >= '0' && c <= '9') { return c - '0'; }
+		if (c >= 'a' && c <= 'f') { return c - 'a' + 10; }
+		if (c >= 'A' && c <= 'F') { return c - 'A' + 10; }
+		return -1;
+	}
+
+	template <class IE>
+	std::uint32_t get_u4(char const* p)
+	{
+		std::uint32_t v = 0;
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			auto const d = from_hex(p[i]);
+			if (d < 0)
+			{
+				MED_THROW_EXCEPTION(invalid_value, name<IE>(), std::size_t(p[i]), get_context().buffer())
+			}
+			v = (v << 4) | std::uint32_t(d);
+		}
+		return v;
+	}
+
+	//RFC 8259 7 escapes into UTF-8 (never longer than escaped)
+	template <class IE>
+	std::string_view unescape(std::string_view s)
+	{
+		char* const out = allocate<IE>(s.size());
+		char* o = out;
+		for (auto const* p = s.data(), *end = p + s.size(); p != end; ++p)
+		{
+			if (*p != '\\') { *o++ = *p; continue; }
+			//the escaped char is present as checked by get_string
+			switch (*++p)
+			{
+			case '"':  *o++ = '"'; break;
+			case '\\': *o++ = '\\'; break;
+			case '/':  *o++ = '/'; break;
+			case 'b':  *o++ = '\b'; break;
+			case 'f':  *o++ = '\f'; break;
+			case 'n':  *o++ = '\n'; break;
+			case 'r':  *o++ = '\r'; break;
+			case 't':  *o++ = '\t'; break;
+			case 'u':
+				{
+					if (end - p < 5)
+					{
+						MED_THROW_EXCEPTION(invalid_value, name<IE>(), std::size_t(end - p), get_context().buffer())
+					}
+					std::uint32_t cp = get_u4<IE>(p + 1);
+					p += 4;
+					//surrogate pair
+					if (cp >= 0xD800 && cp < 0xDC00 && end - p >= 7 && p[1] == '\\' && p[2] == 'u')
+					{
+						if (auto const lo = get_u4<IE>(p + 3); lo >= 0xDC00 && lo < 0xE000)
+						{
+							cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+							p += 6;
+						}
+					}
+					if (cp < 0x80)
+					{
+						*o++ = char(cp);
+					}
+					else if (cp < 0x800)
+					{
+						*o++ = char(0xC0 | (cp >> 6));
+						*o++ = char(0x80 | (cp & 0x3F));
+					}
+					else if (cp < 0x10000)
+					{
+						*o++ = char(0xE0 | (cp >> 12));
+						*o++ = char(0x80 | ((cp >> 6) & 0x3F));
+						*o++ = char(0x80 | (cp & 0x3F));
+					}
+					else
+					{
+						*o++ = char(0xF0 | (cp >> 18));
+						*o++ = char(0x80 | ((cp >> 12) & 0x3F));
+						*o++ = char(0x80 | ((cp >> 6) & 0x3F));
+						*o++ = char(0x80 | (cp & 0x3F));
+					}
+				}
+				break;
+			default:
+				MED_THROW_EXCEPTION(invalid_value, name<IE>(), std::size_t(*p), get_context().buffer())
+			}
+		}
+		return {out, std::size_t(o - out)};
+	}
+
+	template <class IE>
+	std::string_view unhex(std::string_view s)
+	{
+		if (s.size() % 2)
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), s.size(), get_context().buffer())
+		}
+		if (s.empty()) { return s; }
+		auto const len = s.size() / 2;
+		char* const out = allocate<IE>(len);
+		for (std::size_t i = 0; i < len; ++i)
+		{
+			auto const hi = from_hex(s[2 * i]);
+			auto const lo = from_hex(s[2 * i + 1]);
+			if (hi < 0 || lo < 0)
+			{
+				MED_THROW_EXCEPTION(invalid_value, name<IE>(), 2 * i, get_context().buffer())
+			}
+			out[i] = char((hi << 4) | lo);
+		}
+		return {out, len};
+	}
+
+	//skips a value of any type
+	template <class IE>
+	void skip(std::size_t depth)
+	{
+		auto& buf = get_context().buffer();
+		if (depth > MAX_DEPTH)
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), depth, buf)
+		}
+		skip_ws();
+		if (buf.empty())
+		{
+			MED_THROW_EXCEPTION(overflow, name<IE>(), 1, buf)
+		}
+		switch (*buf.begin())
+		{
+		case '"':
+			get_string<IE>();
+			break;
+		case '{':
+			expect<IE>('{');
+			skip_ws();
+			if (not accept("}"))
+			{
+				do
+				{
+					skip_ws();
+					get_string<IE>();
+					skip_ws();
+					expect<IE>(':');
+					skip<IE>(depth + 1);
+					skip_ws();
+				}
+				while (next<IE>('}'));
+			}
+			break;
+		case '[':
+			expect<IE>('[');
+			skip_ws();
+			if (not accept("]"))
+			{
+				do
+				{
+					skip<IE>(depth + 1);
+					skip_ws();
+				}
+				while (next<IE>(']'));
+			}
+			break;
+		default:
+			if (not accept("null") && not accept("true") && not accept("false"))
+			{
+				double v;
+				auto const* first = reinterpret_cast<char const*>(buf.begin());
+				auto const [last, ec] = std::from_chars(first, reinterpret_cast<char const*>(buf.end()), v);
+				if (ec != std::errc{})
+				{
+					MED_THROW_EXCEPTION(invalid_value, name<IE>(), 0, buf)
+				}
+				buf.offset(int(last - first));
+			}
+			break;
+		}
+	}
+
+	DEC_CTX& m_ctx;
+};
+
+template <class C> explicit decoder(C&) -> decoder<C>;
+
+}	//end: namespace med::json
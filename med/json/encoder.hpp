@@ -0,0 +1,284 @@
+/**
+@file
+JSON (RFC 8259) encoder definition
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <charconv>
+#include <cmath>
+#include <cstring>
+
+#include "debug.hpp"
+#include "name.hpp"
+#include "count.hpp"
+#include "encode.hpp"
+#include "choice.hpp"
+#include "octet_string.hpp"
+#include "json.hpp"
+
+namespace med::json {
+
+/**
+ * Encodes sequence/set as object with members named by IEs, choice as
+ * object of single member, multi-field as array, numbers via std::to_chars
+ * and octet strings as text (if printable) or hex strings.
+ * The output is compact (no whitespaces) and written directly to the buffer.
+ */
+template <class ENC_CTX>
+struct encoder : info
+{
+	using state_type = typename ENC_CTX::buffer_type::state_type;
+	using allocator_type = typename ENC_CTX::allocator_type;
+
+	explicit encoder(ENC_CTX& ctx_) : m_ctx{ ctx_ }   { }
+	ENC_CTX& get_context() noexcept                   { return m_ctx; }
+	allocator_type& get_allocator()                   { return get_context().get_allocator(); }
+
+	//containers are encoded as objects here
+	struct container_encoder
+	{
+		template <class IE>
+		void operator()(encoder& me, IE const& ie)    { me.encode_container(ie); }
+	};
+
+	//IE_NULL
+	template <class IE> void operator() (IE const&, IE_NULL)
+	{
+		put<IE>("null");
+	}
+
+	//IE_VALUE
+	template <class IE> void operator() (IE const& ie, IE_VALUE)
+	{
+		if constexpr (AMultiField<IE>)
+		{
+			encode_multi(ie);
+		}
+		else
+		{
+			using value_type = typename IE::value_type;
+			auto const v = ie.get_encoded();
+			if constexpr (std::is_same_v<bool, value_type>)
+			{
+				if (v) { put<IE>("true"); }
+				else { put<IE>("false"); }
+			}
+			else
+			{
+				static_assert(std::is_arithmetic_v<value_type>, "NUMERIC VALUE EXPECTED");
+				if constexpr (std::is_floating_point_v<value_type>)
+				{
+					//no representation of NaN and Infinity
+					if (not std::isfinite(v))
+					{
+						MED_THROW_EXCEPTION(invalid_value, name<IE>(), 0, get_context().buffer())
+					}
+				}
+				auto& buf = get_context().buffer();
+				auto* const first = reinterpret_cast<char*>(buf.begin());
+				auto const [last, ec] = std::to_chars(first, reinterpret_cast<char*>(buf.end()), v);
+				if (ec != std::errc{})
+				{
+					MED_THROW_EXCEPTION(overflow, name<IE>(), buf.size() + 1, buf)
+				}
+				buf.template advance<IE>(int(last - first));
+			}
+			CODEC_TRACE("VAL[%s]: %s", name<IE>(), get_context().buffer().toString());
+		}
+	}
+
+	//IE_OCTET_STRING
+	template <class IE> void operator() (IE const& ie, IE_OCTET_STRING)
+	{
+		if constexpr (AText<IE>)
+		{
+			put_string<IE>(ie.get());
+		}
+		else
+		{
+			static constexpr char hex[] = "0123456789abcdef";
+			auto const len = std::size_t(ie.size());
+			auto* out = get_context().buffer().template advance<IE>(2 * len + 2);
+			*out++ = '"';
+			for (auto* p = ie.data(), *end = p + len; p != end; ++p)
+			{
+				*out++ = hex[*p >> 4];
+				*out++ = hex[*p & 0xF];
+			}
+			*out = '"';
+		}
+		CODEC_TRACE("STR[%s] %zu octets: %s", name<IE>(), std::size_t(ie.size()), get_context().buffer().toString());
+	}
+
+#ifndef UNIT_TEST
+private:
+#endif
+	struct seq_enc
+	{
+		template <class IE, class SEQ>
+		static void apply(SEQ const& seq, encoder& me, char& delimiter)
+		{
+			using field_t = get_field_type_t<IE>;
+			if constexpr (AMultiField<IE>)
+			{
+				auto const& ie = seq.template get<field_t>();
+				if (AMandatory<IE> || not ie.empty())
+				{
+					me.template put_key<IE>(delimiter);
+					me.encode_multi(ie);
+				}
+			}
+			else if constexpr (AOptional<IE>)
+			{
+				if (auto const* pie = seq.template get<field_t>())
+				{
+					me.template put_key<IE>(delimiter);
+					med::encode(me, *pie);
+				}
+			}
+			else
+			{
+				auto const& ie = seq.template get<field_t>();
+				if (not ie.is_set())
+				{
+					MED_THROW_EXCEPTION(missing_ie, name<field_t>(), 1, 0, me.get_context().buffer())
+				}
+				me.template put_key<IE>(delimiter);
+				med::encode(me, ie);
+			}
+		}
+	};
+
+	struct choice_enc : sl::choice_if
+	{
+		template <class IE, class CHOICE>
+		static void apply(CHOICE const& ie, encoder& me)
+		{
+			char delimiter = '{';
+			me.template put_key<IE>(delimiter);
+			med::encode(me, *ie.template get<get_field_type_t<IE>>());
+		}
+
+		template <class CHOICE>
+		static void apply(CHOICE const& ie, encoder& me)
+		{
+			MED_THROW_EXCEPTION(unknown_tag, name<CHOICE>(), ie.index(), me.get_context().buffer())
+		}
+	};
+
+	template <class IE>
+	void encode_container(IE const& ie)
+	{
+		if constexpr (AMultiField<IE>)
+		{
+			encode_multi(ie);
+		}
+		else if constexpr (std::is_same_v<IE_CHOICE, typename IE::ie_type>)
+		{
+			if (not ie.is_set())
+			{
+				MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0, get_context().buffer())
+			}
+			meta::for_if<typename IE::ies_types>(choice_enc{}, ie, *this);
+			put<IE>('}');
+		}
+		else
+		{
+			char delimiter = '{';
+			meta::foreach<typename IE::ies_types>(seq_enc{}, ie, *this, delimiter);
+			//empty object
+			if (delimiter == '{') { put<IE>('{'); }
+			put<IE>('}');
+		}
+	}
+
+	template <class IE>
+	void encode_multi(IE const& ie)
+	{
+		check_arity(*this, ie);
+		char delimiter = '[';
+		for (auto& field : ie)
+		{
+			put<IE>(delimiter);
+			delimiter = ',';
+			med::encode(*this, field);
+		}
+		//empty array
+		if (delimiter == '[') { put<IE>('['); }
+		put<IE>(']');
+	}
+
+	//member name preceded by delimiter of object or members
+	template <class IE>
+	void put_key(char& delimiter)
+	{
+		constexpr auto key = detail::key_name<IE>();
+		auto* out = get_context().buffer().template advance<IE>(key.size() + 4);
+		out[0] = uint8_t(delimiter);
+		out[1] = '"';
+		std::memcpy(out + 2, key.data(), key.size());
+		out[key.size() + 2] = '"';
+		out[key.size() + 3] = ':';
+		delimiter = ',';
+	}
+
+	template <class IE>
+	void put(char c)
+	{
+		get_context().buffer().template push<IE>(uint8_t(c));
+	}
+
+	template <class IE, std::size_t N>
+	void put(char const (&s)[N])
+	{
+		std::memcpy(get_context().buffer().template advance<IE, N - 1>(), s, N - 1);
+	}
+
+	//string escaped per RFC 8259 7
+	template <class IE>
+	void put_string(std::string_view s)
+	{
+		put<IE>('"');
+		auto& buf = get_context().buffer();
+		auto* from = s.data();
+		for (auto* p = from, *end = p + s.size(); p != end; ++p)
+		{
+			auto const c = static_cast<unsigned char>(*p);
+			if (c >= 0x20 && c != '"' && c != '\\') { continue; }
+			//flush unescaped chunk
+			std::memcpy(buf.template advance<IE>(int(p - from)), from, p - from);
+			from = p + 1;
+			static constexpr char hex[] = "0123456789abcdef";
+			switch (c)
+			{
+			case '"':  put<IE>("\\\""); break;
+			case '\\': put<IE>("\\\\"); break;
+			case '\n': put<IE>("\\n"); break;
+			case '\r': put<IE>("\\r"); break;
+			case '\t': put<IE>("\\t"); break;
+			default:
+				{
+					auto* out = buf.template advance<IE, 6>();
+					std::memcpy(out, "\\u00", 4);
+					out[4] = hex[c >> 4];
+					out[5] = hex[c & 0xF];
+				}
+				break;
+			}
+		}
+		auto const rest = s.data() + s.size() - from;
+		std::memcpy(buf.template advance<IE>(int(rest)), from, rest);
+		put<IE>('"');
+	}
+
+	ENC_CTX& m_ctx;
+};
+
+template <class C> explicit encoder(C&) -> encoder<C>;
+
+}	//end: namespace med::json
@@ -0,0 +1,99 @@
+/**
+@file
+JSON (RFC 8259) definitions
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <utility>
+
+#include "../name.hpp"
+#include "../hash.hpp"
+#include "../traits.hpp"
+#include "../octet_string.hpp"
+
+namespace med::json {
+
+//max nesting of values skipped when unknown
+constexpr std::size_t MAX_DEPTH = 32;
+
+using key_hash = hash<uint32_t>;
+
+//octet string printable as text, otherwise it's written in hex
+template <class IE>
+concept AText = requires(IE const& ie)
+{
+	{ ie.get() } -> std::same_as<std::string_view>;
+};
+
+namespace detail {
+
+template <class IE>
+constexpr std::string_view key_name()
+{
+	using field_t = get_field_type_t<IE>;
+	static_assert(AHasName<field_t> || AHasFieldType<field_t>, "JSON KEY REQUIRES static constexpr name()");
+	return name<field_t>();
+}
+
+//compile-time lookup of field index by its name
+template <class IES>
+struct key_table;
+
+template <template <class...> class L, class... IEs>
+struct key_table<L<IEs...>>
+{
+	static constexpr std::size_t size = sizeof...(IEs);
+
+	struct entry
+	{
+		key_hash::value_type hash;
+		std::size_t          index;
+	};
+
+	static constexpr std::array<std::string_view, size> names{ key_name<IEs>()... };
+
+	static constexpr auto entries = []()
+	{
+		std::array<entry, size> table{};
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			table[i] = entry{key_hash::compute(names[i]), i};
+		}
+		std::sort(table.begin(), table.end(), [](entry const& l, entry const& r) { return l.hash < r.hash; });
+		return table;
+	}();
+
+	//index of the field named by key or size if none
+	static constexpr std::size_t find(std::string_view key, key_hash::value_type hval)
+	{
+		auto it = std::lower_bound(entries.begin(), entries.end(), hval,
+			[](entry const& e, key_hash::value_type h) { return e.hash < h; });
+		for (; it != entries.end() && it->hash == hval; ++it)
+		{
+			if (names[it->index] == key) { return it->index; }
+		}
+		return size;
+	}
+};
+
+} //end: namespace detail
+
+struct info
+{
+	//JSON members are named thus no meta-info of IEs is used
+	template <class IE>
+	static constexpr auto produce_meta_info()
+	{
+		return meta::wrap<meta::typelist<>>{};
+	}
+};
+
+} //end: namespace med::json
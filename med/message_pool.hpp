@@ -0,0 +1,214 @@
+/**
+@file
+lock-free pool of reusable message objects
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "exception.hpp"
+
+namespace med {
+
+/**
+ * Fixed number of pre-constructed messages handed out cleared and accepted
+ * back from any thread w/o heap allocations.
+ * @details Free messages are kept in a lock-free stack of indices. Its head
+ * is tagged with a counter incremented on each push to prevent ABA, the
+ * messages are never freed while the pool exists thus no hazard pointers.
+ * Threads with high rate of acquire/release can use own pool::cache to
+ * touch the shared head only when the cache is empty or full, taking or
+ * returning half of the cache at once.
+ * NOTE: the pool is to outlive all messages and caches taken from it.
+ */
+template <class MSG>
+class message_pool
+{
+	using index_t = uint32_t;
+	static constexpr index_t NIL = ~index_t(0);
+
+	static constexpr uint64_t make_head(uint64_t tag, index_t idx) { return (tag << 32) | idx; }
+	static constexpr index_t index_of(uint64_t head)                { return index_t(head); }
+
+public:
+	struct deleter
+	{
+		message_pool* pool;
+		void operator()(MSG* msg) const noexcept    { pool->release(msg); }
+	};
+	using pointer = std::unique_ptr<MSG, deleter>;
+
+	message_pool(message_pool const&) = delete;
+	message_pool& operator=(message_pool const&) = delete;
+
+	//throws invalid_value if capacity doesn't fit the index of the head
+	explicit message_pool(std::size_t capacity)
+		: m_msgs{new MSG[checked(capacity)]}
+		, m_next{new std::atomic<index_t>[capacity]}
+		, m_capacity{index_t(capacity)}
+	{
+		for (index_t i = 0; i < m_capacity; ++i)
+		{
+			m_next[i].store(i + 1 < m_capacity ? i + 1 : NIL, std::memory_order_relaxed);
+		}
+		m_head.store(make_head(0, m_capacity ? 0 : NIL), std::memory_order_release);
+	}
+
+	std::size_t capacity() const noexcept           { return m_capacity; }
+
+	/**
+	 * Takes cleared message from the pool
+	 * @return the message or empty pointer if all are in use
+	 */
+	pointer acquire() noexcept                      { return pointer{pop(), deleter{this}}; }
+
+	/**
+	 * Clears the message and returns it to the pool
+	 */
+	void release(MSG* msg) noexcept
+	{
+		msg->clear();
+		push(msg);
+	}
+
+	/**
+	 * Per-thread cache of free messages
+	 * @details Empty cache takes a batch of messages from the pool and full
+	 * one returns a batch, each by single update of the shared head.
+	 */
+	template <std::size_t SIZE = 16>
+	class cache
+	{
+		static_assert(SIZE > 0, "EMPTY CACHE");
+		static constexpr std::size_t BATCH = (SIZE + 1) / 2;
+
+	public:
+		cache(cache const&) = delete;
+		cache& operator=(cache const&) = delete;
+		explicit cache(message_pool& pool) noexcept : m_pool{pool} {}
+		~cache()                                    { m_pool.push(m_msgs, m_count); }
+
+		pointer acquire() noexcept
+		{
+			if (0 == m_count) { m_count = m_pool.pop(m_msgs, BATCH); }
+			return pointer{m_count ? m_msgs[--m_count] : nullptr, deleter{&m_pool}};
+		}
+
+		//returns message to the cache if released by the owning thread
+		void release(pointer msg) noexcept
+		{
+			auto* p = msg.release();
+			p->clear();
+			if (m_count == SIZE) //the oldest ones go back
+			{
+				m_pool.push(m_msgs, BATCH);
+				std::copy(m_msgs + BATCH, m_msgs + SIZE, m_msgs);
+				m_count -= BATCH;
+			}
+			m_msgs[m_count++] = p;
+		}
+
+		std::size_t size() const noexcept           { return m_count; }
+
+	private:
+		message_pool& m_pool;
+		MSG*          m_msgs[SIZE];
+		std::size_t   m_count {0};
+	};
+
+private:
+	static std::size_t checked(std::size_t capacity)
+	{
+		if (capacity >= NIL) { MED_THROW_EXCEPTION(invalid_value, "capacity", capacity) }
+		return capacity;
+	}
+
+	MSG* pop() noexcept
+	{
+		auto head = m_head.load(std::memory_order_acquire);
+		while (true)
+		{
+			auto const idx = index_of(head);
+			if (NIL == idx) { return nullptr; }
+			//the next is read from a message which could be taken meanwhile
+			//but then the tag of the head is changed and CAS fails
+			auto const next = m_next[idx].load(std::memory_order_relaxed);
+			if (m_head.compare_exchange_weak(head, make_head(head >> 32, next)
+				, std::memory_order_acquire, std::memory_order_acquire))
+			{
+				return &m_msgs[idx];
+			}
+		}
+	}
+
+	//takes up to num messages at once
+	std::size_t pop(MSG** msgs, std::size_t num) noexcept
+	{
+		auto head = m_head.load(std::memory_order_acquire);
+		while (true)
+		{
+			//the chain is read from messages which could be taken meanwhile
+			//but then the head is changed and CAS fails (see pop)
+			std::size_t count = 0;
+			auto next = index_of(head);
+			for (; count < num && NIL != next; ++count)
+			{
+				msgs[count] = &m_msgs[next];
+				next = m_next[next].load(std::memory_order_relaxed);
+			}
+			if (0 == count) { return 0; }
+
+			if (m_head.compare_exchange_weak(head, make_head(head >> 32, next)
+				, std::memory_order_acquire, std::memory_order_acquire))
+			{
+				return count;
+			}
+		}
+	}
+
+	//returns num messages at once linking them in the given order
+	void push(MSG* const* msgs, std::size_t num) noexcept
+	{
+		if (0 == num) { return; }
+		for (std::size_t i = 1; i < num; ++i)
+		{
+			m_next[msgs[i - 1] - m_msgs.get()].store(index_t(msgs[i] - m_msgs.get()), std::memory_order_relaxed);
+		}
+		auto const first = index_t(msgs[0] - m_msgs.get());
+		auto const last = index_t(msgs[num - 1] - m_msgs.get());
+		auto head = m_head.load(std::memory_order_relaxed);
+		do
+		{
+			m_next[last].store(index_of(head), std::memory_order_relaxed);
+		}
+		while (!m_head.compare_exchange_weak(head, make_head((head >> 32) + 1, first)
+			, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	void push(MSG* msg) noexcept
+	{
+		auto const idx = index_t(msg - m_msgs.get());
+		auto head = m_head.load(std::memory_order_relaxed);
+		do
+		{
+			m_next[idx].store(index_of(head), std::memory_order_relaxed);
+		}
+		while (!m_head.compare_exchange_weak(head, make_head((head >> 32) + 1, idx)
+			, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	std::unique_ptr<MSG[]>                 m_msgs;
+	std::unique_ptr<std::atomic<index_t>[]> m_next;
+	index_t const                          m_capacity;
+	alignas(64) std::atomic<uint64_t>      m_head;
+};
+
+} //end: namespace med
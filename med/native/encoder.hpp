@@ -0,0 +1,194 @@
+/**
+@file
+native (in-memory random-access) format encoder definition
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <limits>
+
+#include "debug.hpp"
+#include "name.hpp"
+#include "count.hpp"
+#include "encode.hpp"
+#include "choice.hpp"
+#include "octet_string.hpp"
+#include "native.hpp"
+
+namespace med::native {
+
+/**
+ * Lays out container into blocks with slots of fixed offsets (see native.hpp)
+ * to be accessed w/o decoding via native::view.
+ */
+template <class ENC_CTX>
+struct encoder : info
+{
+	using state_type = typename ENC_CTX::buffer_type::state_type;
+	using allocator_type = typename ENC_CTX::allocator_type;
+
+	explicit encoder(ENC_CTX& ctx_) : m_ctx{ ctx_ }   { }
+	ENC_CTX& get_context() noexcept                   { return m_ctx; }
+	allocator_type& get_allocator()                   { return get_context().get_allocator(); }
+
+	//only the root container is encoded via med::encode
+	struct container_encoder
+	{
+		template <class IE>
+		void operator()(encoder& me, IE const& ie)
+		{
+			static_assert(!AMultiField<IE>, "ROOT IS EXPECTED TO BE A CONTAINER");
+			me.m_base = me.get_context().buffer().begin();
+			me.encode_block(ie);
+		}
+	};
+
+	template <class IE, class IE_TYPE> void operator() (IE const&, IE_TYPE const&)
+	{
+		static_assert(std::is_void_v<IE>, "ROOT IS EXPECTED TO BE A CONTAINER");
+	}
+
+#ifndef UNIT_TEST
+private:
+#endif
+	struct seq_enc
+	{
+		template <class IE, class SEQ>
+		static void apply(SEQ const& seq, uint8_t* block, encoder& me)
+		{
+			using field_t = get_field_type_t<IE>;
+			using layout = detail::layout<SEQ>;
+			constexpr auto idx = meta::list_index_of_v<IE, typename SEQ::ies_types>;
+			uint8_t* const slot = block + layout::slots[idx];
+			bool present;
+			if constexpr (AMultiField<IE>)
+			{
+				auto const& ie = seq.template get<field_t>();
+				check_arity(me, ie);
+				present = not ie.empty();
+				if (present) { me.encode_array(ie, slot); }
+			}
+			else if constexpr (AOptional<IE>)
+			{
+				auto const* pie = seq.template get<field_t>();
+				present = (pie != nullptr);
+				if (present) { me.encode_slot(static_cast<field_t const&>(*pie), slot); }
+			}
+			else
+			{
+				auto const& ie = seq.template get<field_t>();
+				if (not ie.is_set())
+				{
+					MED_THROW_EXCEPTION(missing_ie, name<field_t>(), 1, 0, me.get_context().buffer())
+				}
+				present = true;
+				me.encode_slot(ie, slot);
+			}
+			if (present) { block[idx / 8] |= uint8_t(0x80 >> (idx % 8)); }
+		}
+	};
+
+	struct choice_enc : sl::choice_if
+	{
+		template <class IE, class CHOICE>
+		static void apply(CHOICE const& ie, uint8_t* block, encoder& me)
+		{
+			using field_t = get_field_type_t<IE>;
+			detail::store(block, offset_t(ie.index()));
+			me.encode_slot(static_cast<field_t const&>(*ie.template get<field_t>()), block + detail::layout<CHOICE>::slot);
+		}
+
+		template <class CHOICE>
+		static void apply(CHOICE const& ie, uint8_t*, encoder& me)
+		{
+			MED_THROW_EXCEPTION(unknown_tag, name<CHOICE>(), ie.index(), me.get_context().buffer())
+		}
+	};
+
+	//offset of the next octet to write
+	template <class IE>
+	offset_t offset()
+	{
+		auto const off = get_context().buffer().begin() - m_base;
+		if (off > std::numeric_limits<offset_t>::max())
+		{
+			MED_THROW_EXCEPTION(overflow, name<IE>(), std::size_t(off), get_context().buffer())
+		}
+		return offset_t(off);
+	}
+
+	//block of container at the end returning its offset
+	template <class IE>
+	offset_t encode_block(IE const& ie)
+	{
+		using layout = detail::layout<IE>;
+		auto const off = offset<IE>();
+		auto* block = get_context().buffer().template advance<IE, layout::size>();
+		std::memset(block, 0, layout::size);
+		if constexpr (detail::is_choice<IE>)
+		{
+			if (not ie.is_set())
+			{
+				MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0, get_context().buffer())
+			}
+			meta::for_if<typename IE::ies_types>(choice_enc{}, ie, block, *this);
+		}
+		else
+		{
+			meta::foreach<typename IE::ies_types>(seq_enc{}, ie, block, *this);
+		}
+		CODEC_TRACE("BLOCK[%s] @%u: %s", name<IE>(), off, get_context().buffer().toString());
+		return off;
+	}
+
+	template <class IE>
+	void encode_array(IE const& ie, uint8_t* slot)
+	{
+		using field_t = get_field_type_t<IE>;
+		constexpr auto size = detail::slot_size<field_t>();
+		auto const count = ie.count();
+		auto const off = offset<IE>();
+		auto* slots = get_context().buffer().template advance<IE>(size * count);
+		for (auto& field : ie)
+		{
+			encode_slot(field, slots);
+			slots += size;
+		}
+		detail::store(slot, off);
+		detail::store(slot + sizeof(offset_t), offset_t(count));
+	}
+
+	template <class IE>
+	void encode_slot(IE const& ie, uint8_t* slot)
+	{
+		using ie_type = typename IE::ie_type;
+		if constexpr (std::is_base_of_v<CONTAINER, ie_type>)
+		{
+			detail::store(slot, encode_block(ie));
+		}
+		else if constexpr (std::is_same_v<IE_OCTET_STRING, ie_type>)
+		{
+			auto const len = std::size_t(ie.size());
+			auto const off = offset<IE>();
+			auto* out = get_context().buffer().template advance<IE>(len);
+			if (len) { std::memcpy(out, ie.data(), len); }
+			detail::store(slot, off);
+			detail::store(slot + sizeof(offset_t), offset_t(len));
+		}
+		else if constexpr (std::is_same_v<IE_VALUE, ie_type>)
+		{
+			detail::store(slot, ie.get_encoded());
+		}
+	}
+
+	ENC_CTX& m_ctx;
+	typename ENC_CTX::buffer_type::pointer m_base {nullptr}; //start of root block
+};
+
+template <class C> explicit encoder(C&) -> encoder<C>;
+
+}	//end: namespace med::native
@@ -0,0 +1,151 @@
+/**
+@file
+native (in-memory random-access) format definitions
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "../ie_type.hpp"
+#include "../field.hpp"
+#include "../accessor.hpp"
+#include "../meta/typelist.hpp"
+
+/*
+Each container is a block of fixed size known at compile-time:
+	sequence/set: presence bitmap (1 bit per IE, MSB first) followed by slots of IEs;
+	choice: index of selected alternative followed by slot of max size of alternatives.
+Slot of IE:
+	value: value in host byte order;
+	null: nothing;
+	octet string: offset and length of octets;
+	container: offset of its block;
+	multi-field: offset and count of consecutive slots of its fields.
+Offsets are from the start of the root block, variable parts follow the blocks.
+NOTE: the format is for the same host (IPC) thus values are not portable.
+*/
+
+namespace med::native {
+
+using offset_t = uint32_t;
+
+namespace detail {
+
+template <class FIELD>
+constexpr std::size_t slot_size()
+{
+	using ie_type = typename FIELD::ie_type;
+	if constexpr (std::is_base_of_v<CONTAINER, ie_type>)
+	{
+		return sizeof(offset_t);
+	}
+	else if constexpr (std::is_same_v<IE_OCTET_STRING, ie_type>)
+	{
+		return 2 * sizeof(offset_t);
+	}
+	else if constexpr (std::is_same_v<IE_NULL, ie_type>)
+	{
+		return 0;
+	}
+	else
+	{
+		static_assert(std::is_same_v<IE_VALUE, ie_type>, "NOT SUPPORTED IE TYPE");
+		return sizeof(typename FIELD::value_type);
+	}
+}
+
+//slot of IE within container
+template <class IE>
+constexpr std::size_t ie_slot_size()
+{
+	if constexpr (AMultiField<IE>) { return 2 * sizeof(offset_t); }
+	else { return slot_size<get_field_type_t<IE>>(); }
+}
+
+template <class IE>
+constexpr bool is_choice = std::is_same_v<IE_CHOICE, typename IE::ie_type>;
+
+template <class IE, class IES = typename IE::ies_types>
+struct layout;
+
+//sequence/set
+template <class IE, template <class...> class L, class... IEs>
+struct layout<IE, L<IEs...>>
+{
+	static constexpr std::size_t num_ies = sizeof...(IEs);
+	static constexpr std::size_t bitmap_size = (num_ies + 7) / 8;
+	static constexpr std::size_t size = bitmap_size + (ie_slot_size<IEs>() + ... + 0);
+
+	static constexpr std::array<std::size_t, num_ies> slots = []()
+	{
+		std::array<std::size_t, num_ies> offs{};
+		std::size_t const sizes[] = {ie_slot_size<IEs>()..., 0};
+		std::size_t off = bitmap_size;
+		for (std::size_t i = 0; i < num_ies; ++i) { offs[i] = off; off += sizes[i]; }
+		return offs;
+	}();
+
+	template <class FIELD>
+	using ie_of = meta::find_t<L<IEs...>, sl::field_at<FIELD>>;
+
+	template <class FIELD>
+	static constexpr std::size_t index()
+	{
+		static_assert(!std::is_void_v<ie_of<FIELD>>, "NO SUCH FIELD");
+		return meta::list_index_of_v<ie_of<FIELD>, L<IEs...>>;
+	}
+};
+
+//choice
+template <class IE, template <class...> class L, class... IEs>
+requires is_choice<IE>
+struct layout<IE, L<IEs...>>
+{
+	static constexpr std::size_t num_ies = sizeof...(IEs);
+	static constexpr std::size_t slot = sizeof(offset_t);
+	static constexpr std::size_t size = slot + std::max({std::size_t(0), ie_slot_size<IEs>()...});
+
+	template <class FIELD>
+	using ie_of = meta::find_t<L<IEs...>, sl::field_at<FIELD>>;
+
+	template <class FIELD>
+	static constexpr std::size_t index()
+	{
+		static_assert(!std::is_void_v<ie_of<FIELD>>, "NO SUCH FIELD");
+		return meta::list_index_of_v<ie_of<FIELD>, L<IEs...>>;
+	}
+};
+
+template <typename T>
+inline void store(uint8_t* out, T v)                { std::memcpy(out, &v, sizeof(v)); }
+
+template <typename T>
+inline T load(uint8_t const* in)
+{
+	T v;
+	std::memcpy(&v, in, sizeof(v));
+	return v;
+}
+
+} //end: namespace detail
+
+struct info
+{
+	//layout is defined by the format thus no meta-info of IEs is used
+	template <class IE>
+	static constexpr auto produce_meta_info()
+	{
+		return meta::wrap<meta::typelist<>>{};
+	}
+};
+
+} //end: namespace med::native
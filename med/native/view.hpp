@@ -0,0 +1,195 @@
+/**
+@file
+read-only random-access view of native format
+
+@copyright Denis Priyomov 2018
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <optional>
+#include <span>
+
+#include "name.hpp"
+#include "exception.hpp"
+#include "native.hpp"
+
+namespace med::native {
+
+template <class IE> class view;
+template <class FIELD> class array_view;
+
+namespace detail {
+
+//bounds of the encoded message
+struct extent
+{
+	uint8_t const* base {nullptr};
+	std::size_t    size {0};
+
+	template <class IE>
+	uint8_t const* at(std::size_t off, std::size_t len) const
+	{
+		if (off > size || len > size - off)
+		{
+			MED_THROW_EXCEPTION(overflow, name<IE>(), off + len)
+		}
+		return base + off;
+	}
+};
+
+//field in the slot (present)
+template <class FIELD>
+auto slot_get(extent const& ext, uint8_t const* slot)
+{
+	using ie_type = typename FIELD::ie_type;
+	if constexpr (std::is_base_of_v<CONTAINER, ie_type>)
+	{
+		return view<FIELD>{ext, load<offset_t>(slot)};
+	}
+	else if constexpr (std::is_same_v<IE_OCTET_STRING, ie_type>)
+	{
+		auto const len = load<offset_t>(slot + sizeof(offset_t));
+		return std::span<uint8_t const>{ext.at<FIELD>(load<offset_t>(slot), len), len};
+	}
+	else if constexpr (std::is_same_v<IE_NULL, ie_type>)
+	{
+		return true;
+	}
+	else
+	{
+		return load<typename FIELD::value_type>(slot);
+	}
+}
+
+//field in the slot if present
+template <class FIELD, bool MANDATORY>
+auto slot_get(extent const& ext, uint8_t const* slot, bool present)
+{
+	using ie_type = typename FIELD::ie_type;
+	using result_t = decltype(slot_get<FIELD>(ext, slot));
+	if constexpr (std::is_same_v<IE_VALUE, ie_type>)
+	{
+		if constexpr (MANDATORY)
+		{
+			return slot_get<FIELD>(ext, slot);
+		}
+		else
+		{
+			return present ? std::optional<result_t>{slot_get<FIELD>(ext, slot)} : std::nullopt;
+		}
+	}
+	else
+	{
+		//empty view/span or false when absent
+		return present ? slot_get<FIELD>(ext, slot) : result_t{};
+	}
+}
+
+} //end: namespace detail
+
+/**
+ * Read-only view of container encoded in native format.
+ * @details Any field is accessed in O(1) via compile-time offset of its slot:
+ * - value: value_type if mandatory or std::optional<value_type>;
+ * - octet string: span of octets (empty if absent);
+ * - null: presence;
+ * - container: view (invalid if absent);
+ * - multi-field: array_view.
+ * Offsets are checked to be within the message on access.
+ */
+template <class IE>
+class view
+{
+public:
+	using ie_type = IE;
+	using layout = detail::layout<IE>;
+
+	constexpr view() noexcept = default;
+	view(void const* data, std::size_t size)
+		: view{detail::extent{static_cast<uint8_t const*>(data), size}, 0} {}
+	template <typename T>
+	explicit view(std::span<T> data) : view{data.data(), data.size_bytes()} {}
+	view(detail::extent const& ext, std::size_t off)
+		: m_ext{ext}, m_block{ext.at<IE>(off, layout::size)} {}
+
+	explicit operator bool() const noexcept     { return m_block != nullptr; }
+
+	//index of selected alternative in choice
+	std::size_t index() const requires detail::is_choice<IE>
+	{
+		return detail::load<offset_t>(m_block);
+	}
+
+	template <class FIELD>
+	bool has() const
+	{
+		constexpr auto idx = layout::template index<FIELD>();
+		if constexpr (detail::is_choice<IE>)
+		{
+			return index() == idx;
+		}
+		else
+		{
+			return m_block[idx / 8] & (0x80 >> (idx % 8));
+		}
+	}
+
+	template <class FIELD>
+	auto get() const
+	{
+		using ie_t = typename layout::template ie_of<FIELD>;
+		constexpr auto idx = layout::template index<FIELD>();
+		uint8_t const* slot;
+		if constexpr (detail::is_choice<IE>) { slot = m_block + layout::slot; }
+		else { slot = m_block + layout::slots[idx]; }
+
+		if constexpr (AMultiField<ie_t>)
+		{
+			return has<FIELD>() ? array_view<FIELD>{m_ext, slot} : array_view<FIELD>{};
+		}
+		else
+		{
+			constexpr bool mandatory = AMandatory<ie_t> && not detail::is_choice<IE>;
+			return detail::slot_get<FIELD, mandatory>(m_ext, slot, has<FIELD>());
+		}
+	}
+
+private:
+	detail::extent m_ext;
+	uint8_t const* m_block {nullptr};
+};
+
+//read-only view of multi-field
+template <class FIELD>
+class array_view
+{
+public:
+	static constexpr std::size_t slot_size = detail::slot_size<FIELD>();
+
+	constexpr array_view() noexcept = default;
+	array_view(detail::extent const& ext, uint8_t const* slot)
+		: m_ext{ext}
+		, m_count{detail::load<offset_t>(slot + sizeof(offset_t))}
+		, m_slots{ext.at<FIELD>(detail::load<offset_t>(slot), slot_size * m_count)}
+	{}
+
+	std::size_t size() const noexcept           { return m_count; }
+	bool empty() const noexcept                 { return 0 == m_count; }
+
+	//throws invalid_value if index is out of the array
+	auto operator[](std::size_t i) const
+	{
+		if (i >= m_count) { MED_THROW_EXCEPTION(invalid_value, name<FIELD>(), i) }
+		return detail::slot_get<FIELD>(m_ext, m_slots + i * slot_size);
+	}
+
+private:
+	detail::extent m_ext;
+	std::size_t    m_count {0};
+	uint8_t const* m_slots {nullptr};
+};
+
+}	//end: namespace med::native
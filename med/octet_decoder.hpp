@@ -19,7 +19,7 @@ Distributed under the MIT License
 
 namespace med {
 
-template <class DEC_CTX>
+template <class DEC_CTX, byte_order ORDER = byte_order::big>
 struct octet_decoder : sl::octet_info
 {
 	using state_type = typename DEC_CTX::buffer_type::state_type;
@@ -28,7 +28,7 @@ struct octet_decoder : sl::octet_info
 	template <class... PA>
 	using padder_type = octet_padder<PA...>;
 
-	explicit octet_decoder(DEC_CTX& c) : m_ctx{c} { }
+	explicit octet_decoder(DEC_CTX& c, endian<ORDER> = {}) : m_ctx{c} { }
 	DEC_CTX& get_context() noexcept             { return m_ctx; }
 	allocator_type& get_allocator()             { return get_context().get_allocator(); }
 
@@ -50,6 +50,29 @@ struct octet_decoder : sl::octet_info
 		(*this)(ie, typename as_writable_t<IE>::ie_type{});
 		return ie.get_encoded();
 	}
+	//tag w/o consuming: read in place if whole octets or decoded and rolled back
+	template <class IE> std::size_t operator() (PEEK_TAG, IE& ie, std::size_t& tag)
+	{
+		auto& buf = get_context().buffer();
+		if (buf.empty()) { return 0; }
+
+		using tag_t = as_writable_t<IE>;
+		if constexpr (tag_t::traits::offset == 0 && (tag_t::traits::bits % 8) == 0)
+		{
+			constexpr std::size_t NUM_BYTES = tag_t::traits::bits / 8;
+			if (buf.size() < NUM_BYTES) { MED_THROW_EXCEPTION(overflow, name<IE>(), NUM_BYTES, buf) }
+			tag = get_bytes<byte_order_of<tag_t, ORDER>(), NUM_BYTES, typename tag_t::value_type>(buf.begin());
+			return NUM_BYTES;
+		}
+		else
+		{
+			auto const st = buf.get_state();
+			tag = (*this)(ie, IE_TAG{});
+			std::size_t const size = buf.get_state() - st;
+			buf.set_state(st);
+			return size;
+		}
+	}
 	//IE_LEN
 	template <class IE> void operator() (IE& ie, IE_LEN)
 	{
@@ -74,7 +97,7 @@ struct octet_decoder : sl::octet_info
 		{
 			if constexpr (IE::traits::offset == 0 && (IE::traits::bits % 8) == 0)
 			{
-				return get_bytes<NUM_BYTES, value_t>(in);
+				return get_bytes<byte_order_of<IE, ORDER>(), NUM_BYTES, value_t>(in);
 			}
 			else
 			{
@@ -91,25 +114,34 @@ struct octet_decoder : sl::octet_info
 			}
 		}(pval);
 
-		if constexpr (std::is_same_v<bool, decltype(ie.set_encoded(val))>)
+		set_value(ie, val);
+		CODEC_TRACE("VAL=%zXh [%s]: %s", std::size_t(val), name<IE>(), get_context().buffer().toString());
+	}
+
+	//multi-field of fixed-size values w/o tag: bounds are checked once for all
+	struct bulk_decoder
+	{
+		template <class IE>
+		void operator()(octet_decoder& me, IE& ie, std::size_t count)
 		{
-			if (not ie.set_encoded(val))
+			using field_t = typename IE::field_type;
+			constexpr std::size_t NUM_BYTES = field_t::traits::bits / 8;
+			CODEC_TRACE("BULK[%s]*%zu: %s", name<IE>(), count, me.get_context().buffer().toString());
+			uint8_t const* in = me.get_context().buffer().template advance<IE>(int(count * NUM_BYTES));
+			ie.reserve(ie.count() + count, me);
+			for (; count; --count, in += NUM_BYTES)
 			{
-				MED_THROW_EXCEPTION(invalid_value, name<IE>(), val, get_context().buffer())
+				auto* field = ie.push_back(me);
+				me.set_value(*field, get_bytes<byte_order_of<field_t, ORDER>(), NUM_BYTES, typename field_t::value_type>(in));
 			}
 		}
-		else
-		{
-			ie.set_encoded(val);
-		}
-		CODEC_TRACE("VAL=%zXh [%s]: %s", std::size_t(val), name<IE>(), get_context().buffer().toString());
-	}
+	};
 
 	//IE_OCTET_STRING
 	template <class IE> void operator() (IE& ie, IE_OCTET_STRING)
 	{
 		CODEC_TRACE("STR[%s] <-(%zu bytes): %s", name<IE>(), get_context().buffer().size(), get_context().buffer().toString());
-		if (ie.set_encoded(get_context().buffer().size(), get_context().buffer().begin()))
+		if (ie.set_encoded(get_context().buffer().size(), get_context().buffer().begin(), *this))
 		{
 			CODEC_TRACE("STR[%s] -> len = %zu bytes", name<IE>(), std::size_t(ie.size()));
 			get_context().buffer().template advance<IE>(ie.size());
@@ -121,7 +153,28 @@ struct octet_decoder : sl::octet_info
 	}
 
 private:
+	template <class IE>
+	void set_value(IE& ie, typename IE::value_type val)
+	{
+		if constexpr (std::is_same_v<bool, decltype(ie.set_encoded(val))>)
+		{
+			if (not ie.set_encoded(val))
+			{
+				MED_THROW_EXCEPTION(invalid_value, name<IE>(), val, get_context().buffer())
+			}
+		}
+		else
+		{
+			ie.set_encoded(val);
+		}
+	}
+
 	DEC_CTX& m_ctx;
 };
 
+template <class C>
+explicit octet_decoder(C&) -> octet_decoder<C>;
+template <class C, byte_order ORDER>
+octet_decoder(C&, endian<ORDER>) -> octet_decoder<C, ORDER>;
+
 }	//end: namespace med
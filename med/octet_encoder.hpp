@@ -19,7 +19,7 @@ Distributed under the MIT License
 
 namespace med {
 
-template <class ENC_CTX>
+template <class ENC_CTX, byte_order ORDER = byte_order::big>
 struct octet_encoder : sl::octet_info
 {
 	//required for length_encoder
@@ -28,7 +28,7 @@ struct octet_encoder : sl::octet_info
 	using padder_type = octet_padder<PA...>;
 	using allocator_type = typename ENC_CTX::allocator_type;
 
-	explicit octet_encoder(ENC_CTX& ctx_) : m_ctx{ ctx_ } { }
+	explicit octet_encoder(ENC_CTX& ctx_, endian<ORDER> = {}) : m_ctx{ ctx_ } { }
 	ENC_CTX& get_context() noexcept                   { return m_ctx; }
 	allocator_type& get_allocator()                   { return get_context().get_allocator(); }
 
@@ -103,7 +103,7 @@ struct octet_encoder : sl::octet_info
 		uint8_t* out = get_context().buffer().template advance_bits<IE, NUM_BITS>();
 		if constexpr (IE::traits::offset == 0 && (IE::traits::bits % 8) == 0)
 		{
-			put_bytes<NUM_BYTES>(ie.get_encoded(), out);
+			put_bytes<byte_order_of<IE, ORDER>(), NUM_BYTES>(ie.get_encoded(), out);
 		}
 		else
 		{
@@ -118,6 +118,28 @@ struct octet_encoder : sl::octet_info
 		CODEC_TRACE("V=%zXh %zu@%zu bits[%s]: %s", std::size_t(ie.get_encoded()), IE::traits::bits, IE::traits::offset, name<IE>(), get_context().buffer().toString());
 	}
 
+	//multi-field of fixed-size values w/o tag: bounds are checked once for all
+	struct bulk_encoder
+	{
+		template <class IE>
+		void operator()(octet_encoder& me, IE const& ie)
+		{
+			using field_t = typename IE::field_type;
+			constexpr std::size_t NUM_BYTES = field_t::traits::bits / 8;
+			CODEC_TRACE("BULK[%s]*%zu: %s", name<IE>(), ie.count(), me.get_context().buffer().toString());
+			uint8_t* out = me.get_context().buffer().template advance<IE>(int(ie.count() * NUM_BYTES));
+			for (auto& field : ie)
+			{
+				if (not field.is_set())
+				{
+					MED_THROW_EXCEPTION(missing_ie, name<IE>(), ie.count(), ie.count() - 1)
+				}
+				put_bytes<byte_order_of<field_t, ORDER>(), NUM_BYTES>(field.get_encoded(), out);
+				out += NUM_BYTES;
+			}
+		}
+	};
+
 	//IE_OCTET_STRING
 	template <class IE> void operator() (IE const& ie, IE_OCTET_STRING)
 	{
@@ -130,4 +152,9 @@ private:
 	ENC_CTX& m_ctx;
 };
 
+template <class C>
+explicit octet_encoder(C&) -> octet_encoder<C>;
+template <class C, byte_order ORDER>
+octet_encoder(C&, endian<ORDER>) -> octet_encoder<C, ORDER>;
+
 }	//end: namespace med
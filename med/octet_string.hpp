@@ -15,6 +15,8 @@ Distributed under the MIT License
 #include "field.hpp"
 #include "debug.hpp"
 #include "value_traits.hpp"
+#include "allocator.hpp"
+#include "offset_ptr.hpp"
 
 namespace med {
 
@@ -104,6 +106,103 @@ private:
 	uint8_t     m_data[MAX_LEN];
 };
 
+/**
+ * Variable length octets stored inline up to INLINE_LEN (small buffer optimization).
+ * @details Longer ones are copied into space of the allocator if provided
+ * (e.g. on decode) unless VIEW is set, otherwise they refer to the source
+ * (also when the allocator is the default null_allocator).
+ * Thus decoded messages survive buffer reuse w/o reserving max length inline.
+ */
+template <std::size_t INLINE_LEN = 23, bool VIEW = false>
+class octets_var_sbo
+{
+public:
+	bool is_set() const                         { return m_is_set; }
+	bool is_inline() const                      { return m_size <= INLINE_LEN; }
+	//space taken from allocator to assign len octets
+	static constexpr std::size_t alloc_size(std::size_t len) { return (VIEW || len <= INLINE_LEN) ? 0 : len; }
+
+	std::size_t size() const                    { return m_size; }
+	uint8_t const* data() const                 { return is_set() ? (is_inline() ? m_inline : m_extern) : nullptr; }
+	void clear()                                { m_size = 0; m_is_set = false; }
+
+	//long value refers to the source
+	void assign(uint8_t const* beg_, uint8_t const* end_)
+	{
+		m_size = num_octs_t(end_ - beg_);
+		if (is_inline()) { octets<0, INLINE_LEN>::copy(m_inline, beg_, m_size); }
+		else { m_extern = beg_; }
+		m_is_set = true;
+	}
+
+	//long value is copied into allocated space unless VIEW or no allocator
+	template <class ALLOCATOR>
+	void assign(uint8_t const* beg_, uint8_t const* end_, ALLOCATOR& alloc)
+	{
+		assign(beg_, end_);
+		if constexpr (not VIEW && not std::is_same_v<null_allocator, std::remove_const_t<ALLOCATOR>>)
+		{
+			if (not is_inline())
+			{
+				auto* p = static_cast<uint8_t*>(alloc.allocate(m_size, 1));
+				if (!p) { MED_THROW_EXCEPTION(out_of_memory, "octets_var_sbo", m_size) }
+				std::memcpy(p, beg_, m_size);
+				m_extern = p;
+			}
+		}
+	}
+
+private:
+	union
+	{
+		uint8_t        m_inline[INLINE_LEN];
+		uint8_t const* m_extern;
+	};
+	num_octs_t  m_size {0};
+	bool        m_is_set {false};
+};
+
+/**
+ * Variable length octets referred by self-relative offset.
+ * @details The octets are copied into space of the allocator if provided
+ * (e.g. on decode) thus the message decoded within the same memory block as
+ * its allocator can be copied as a blob to another address.
+ */
+class octets_var_reloc
+{
+public:
+	bool is_set() const                         { return m_data.get() != nullptr; }
+	//space taken from allocator to assign len octets
+	static constexpr std::size_t alloc_size(std::size_t len) { return len; }
+
+	std::size_t size() const                    { return m_size; }
+	uint8_t const* data() const                 { return m_data.get(); }
+
+	void clear()                                { m_data = nullptr; m_size = 0; }
+	void assign(uint8_t const* beg_, uint8_t const* end_)
+	{
+		m_data = beg_;
+		m_size = num_octs_t(end_ - beg_);
+	}
+
+	template <class ALLOCATOR>
+	void assign(uint8_t const* beg_, uint8_t const* end_, ALLOCATOR& alloc)
+	{
+		assign(beg_, end_);
+		if (m_size)
+		{
+			auto* p = static_cast<uint8_t*>(alloc.allocate(m_size, 1));
+			if (!p) { MED_THROW_EXCEPTION(out_of_memory, "octets_var_reloc", m_size) }
+			std::memcpy(p, beg_, m_size);
+			m_data = p;
+		}
+	}
+
+private:
+	offset_ptr<uint8_t const> m_data;
+	num_octs_t                m_size {0};
+};
+
 //fixed length octets with external storage
 template <std::size_t LEN>
 class octets_fix_extern
@@ -170,10 +269,23 @@ struct octet_string_impl : IE<IE_OCTET_STRING>
 	void clear()                                { m_value.clear(); }
 
 	template <class... ARGS>
-	void copy(base_t const& from, ARGS&&...)
+	void copy(base_t const& from, ARGS&&... args)
 	{
 		clear();
-		m_value.assign(from.begin(), from.end());
+		if constexpr (sizeof...(ARGS) == 1 && requires { assign_with(from.begin(), from.end(), args...); })
+		{
+			assign_with(from.begin(), from.end(), args...);
+		}
+		else
+		{
+			m_value.assign(from.begin(), from.end());
+		}
+	}
+
+	//size of external storage to copy this string
+	std::size_t external_size() const requires requires { VALUE::alloc_size(0); }
+	{
+		return VALUE::alloc_size(size());
 	}
 
 	template <class T = VALUE> decltype(std::declval<T>().resize(0))
@@ -192,13 +304,47 @@ struct octet_string_impl : IE<IE_OCTET_STRING>
 
 	//NOTE: do not override!
 	bool set_encoded(std::size_t len, void const* data)
+	{
+		if (not is_valid_length(len)) { return false; }
+		auto it = static_cast<iterator>(data);
+		m_value.assign(it, it + len);
+		return is_set();
+	}
+
+	//the storage may use the allocator of context (e.g. octets_var_sbo)
+	template <class CTX>
+	bool set_encoded(std::size_t len, void const* data, CTX& ctx)
+	{
+		if (not is_valid_length(len)) { return false; }
+		auto it = static_cast<iterator>(data);
+		if constexpr (requires { assign_with(it, it + len, ctx); })
+		{
+			assign_with(it, it + len, ctx);
+		}
+		else
+		{
+			m_value.assign(it, it + len);
+		}
+		return is_set();
+	}
+
+	value_type const& get() const               { return m_value; }
+	bool is_set() const                         { return m_value.is_set(); }
+	explicit operator bool() const              { return is_set(); }
+
+	bool operator==(octet_string_impl const& rhs) const noexcept
+	{
+		return size() == rhs.size() && 0 == std::memcmp(data(), rhs.data(), size());
+	}
+
+protected:
+	static constexpr bool is_valid_length([[maybe_unused]] std::size_t len)
 	{
 		if constexpr (traits::min_octets != 0)
 		{
 			if (len < traits::min_octets)
 			{
 				CODEC_TRACE("ERROR: len=%zu < min=%zu", len, traits::min_octets);
-				//m_value.clear();
 				return false;
 			}
 		}
@@ -207,25 +353,19 @@ struct octet_string_impl : IE<IE_OCTET_STRING>
 			if (len > traits::max_octets)
 			{
 				CODEC_TRACE("ERROR: len=%zu > max=%zu", len, traits::max_octets);
-				//m_value.clear();
 				return false;
 			}
 		}
-		auto it = static_cast<iterator>(data);
-		m_value.assign(it, it + len);
-		return is_set();
+		return true;
 	}
 
-	value_type const& get() const               { return m_value; }
-	bool is_set() const                         { return m_value.is_set(); }
-	explicit operator bool() const              { return is_set(); }
-
-	bool operator==(octet_string_impl const& rhs) const noexcept
+	template <class CTX>
+	auto assign_with(elem_type const* beg, elem_type const* end, CTX& ctx)
+		-> decltype(std::declval<value_type&>().assign(beg, end, get_allocator(ctx)))
 	{
-		return size() == rhs.size() && 0 == std::memcmp(data(), rhs.data(), size());
+		return m_value.assign(beg, end, get_allocator(ctx));
 	}
 
-protected:
 	value_type  m_value;
 };
 
@@ -0,0 +1,92 @@
+/**
+@file
+self-relative pointer to keep decoded messages relocatable
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace med {
+
+/**
+ * Pointer stored as offset from its own address.
+ * @details The offset stays valid when the pointer and its pointee are moved
+ * together by the same displacement, e.g. a message decoded with an allocator
+ * within the same memory block is copied as a blob to another address
+ * (shared memory, other process). Copy of the pointer itself keeps the pointee.
+ * NOTE: offset 1 stands for nullptr since it points inside the pointer itself.
+ */
+template <class T>
+class offset_ptr
+{
+public:
+	using element_type = T;
+
+	constexpr offset_ptr() noexcept = default;
+	offset_ptr(std::nullptr_t) noexcept                 { }
+	offset_ptr(T* p) noexcept                           { set(p); }
+	offset_ptr(offset_ptr const& rhs) noexcept          { set(rhs.get()); }
+	offset_ptr& operator=(offset_ptr const& rhs) noexcept { set(rhs.get()); return *this; }
+	offset_ptr& operator=(T* p) noexcept                { set(p); return *this; }
+	offset_ptr& operator=(std::nullptr_t) noexcept      { m_offset = NIL; return *this; }
+
+	T* get() const noexcept
+	{
+		return m_offset != NIL ? reinterpret_cast<T*>(reinterpret_cast<uintptr_t>(this) + m_offset) : nullptr;
+	}
+	operator T*() const noexcept                        { return get(); }
+	T* operator->() const noexcept                      { return get(); }
+	T& operator*() const noexcept                       { return *get(); }
+	explicit operator bool() const noexcept             { return m_offset != NIL; }
+
+private:
+	void set(T* p) noexcept
+	{
+		m_offset = p ? reinterpret_cast<uintptr_t>(p) - reinterpret_cast<uintptr_t>(this) : NIL;
+	}
+
+	static constexpr uintptr_t NIL = 1;
+
+	uintptr_t m_offset {NIL}; //wraps around for pointee below this
+};
+
+/**
+ * Policy of links to external storage (multi-field nodes, out of line alternatives).
+ * @details Raw pointers are used by default. The relocatable links are
+ * self-relative thus valid only when the whole message incl. its external
+ * storage and octets (see octets_var_reloc) lives in one contiguous block
+ * which is moved as a unit. Otherwise the moved links refer to garbage.
+ */
+struct raw_links
+{
+	template <class T> using pointer = T*;
+};
+
+struct relocatable
+{
+	template <class T> using pointer = offset_ptr<T>;
+};
+
+//links of IE: IE::links if defined or raw ones otherwise
+template <class IE>
+struct get_links
+{
+	using type = raw_links;
+};
+
+template <class IE> requires requires { typename IE::links; }
+struct get_links<IE>
+{
+	using type = typename IE::links;
+};
+
+template <class IE, class T>
+using link_t = typename get_links<IE>::type::template pointer<T>;
+
+}	//end: namespace med
@@ -0,0 +1,164 @@
+/**
+@file
+containers keeping presence of their IEs in a bitmap
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <utility>
+
+#include "concepts.hpp"
+#include "sequence.hpp"
+#include "set.hpp"
+#include "meta/foreach.hpp"
+
+namespace med {
+
+/**
+ * IE which presence is kept by the bitmap of its container.
+ * @details Setting the field via set/set_encoded marks it present, clear
+ * resets the mark. Combined with IEs w/o own presence (e.g. packed_value)
+ * this shrinks the container.
+ * NOTE: the field can only live within the container OWNER.
+ */
+template <class IE, std::size_t INDEX, class OWNER>
+class packed_field : public IE
+{
+public:
+	static constexpr std::size_t packed_index = INDEX;
+
+	bool is_set() const                 { return presence().test(INDEX); }
+	explicit operator bool() const      { return is_set(); }
+	void clear()                        { IE::clear(); presence().reset(INDEX); }
+
+	template <class... ARGS>
+	decltype(auto) set_encoded(ARGS&&... args)
+	{
+		return mark([&]() { return IE::set_encoded(std::forward<ARGS>(args)...); });
+	}
+
+	template <class... ARGS>
+	decltype(auto) set(ARGS&&... args)
+	{
+		return mark([&]() { return IE::set(std::forward<ARGS>(args)...); });
+	}
+
+	template <class FROM, class... ARGS>
+	void copy(FROM const& from, ARGS&&... args)
+	{
+		IE::copy(from, std::forward<ARGS>(args)...);
+		presence().set(INDEX);
+	}
+
+	bool operator==(packed_field const& rhs) const
+	{
+		return is_set() == rhs.is_set()
+			&& (not is_set() || static_cast<IE const&>(*this) == static_cast<IE const&>(rhs));
+	}
+
+private:
+	//NOTE: deferred till OWNER is complete
+	template <class O = OWNER>
+	auto& presence()                    { return static_cast<typename O::ies_t&>(*this).m_presence; }
+	template <class O = OWNER>
+	auto const& presence() const        { return static_cast<typename O::ies_t const&>(*this).m_presence; }
+
+	template <class FUNC>
+	auto mark(FUNC&& func)
+	{
+		if constexpr (std::is_void_v<decltype(func())>)
+		{
+			func();
+			presence().set(INDEX);
+		}
+		else
+		{
+			auto const res = func();
+			if (res) { presence().set(INDEX); }
+			return res;
+		}
+	}
+};
+
+namespace detail {
+
+//single-instance IEs w/o predefined value or setter are packed
+template <class IE>
+concept APackable = !AMultiField<IE> && !AContainer<IE> && !APredefinedValue<IE> && !AHasSetterType<IE>;
+
+template <class IE, std::size_t INDEX, class OWNER>
+struct pack_ie
+{
+	using type = IE;
+};
+template <APackable IE, std::size_t INDEX, class OWNER>
+struct pack_ie<IE, INDEX, OWNER>
+{
+	using type = packed_field<IE, INDEX, OWNER>;
+};
+
+template <template <class...> class CONT, class OWNER, class SEQ, class... IES>
+struct packed_of;
+template <template <class...> class CONT, class OWNER, std::size_t... Is, class... IES>
+struct packed_of<CONT, OWNER, std::index_sequence<Is...>, IES...>
+{
+	using type = CONT<typename pack_ie<IES, Is, OWNER>::type...>;
+};
+
+} //end: namespace detail
+
+namespace sl {
+
+//non-packed IEs are checked for presence one by one
+struct packed_is
+{
+	static constexpr bool op(bool r1, bool r2)  { return r1 || r2; }
+
+	template <class IE, class IES>
+	static constexpr bool apply(IES const& ies)
+	{
+		if constexpr (APacked<IE>) { return false; }
+		else { return cont_is::apply<IE>(ies); }
+	}
+
+	template <class IES>
+	static constexpr bool apply(IES const&)     { return false; }
+};
+
+} //end: namespace sl
+
+namespace detail {
+
+template <template <class...> class CONT, class OWNER, class... IES>
+class packed_container : public packed_of<CONT, OWNER, std::index_sequence_for<IES...>, IES...>::type
+{
+	using base_t = typename packed_of<CONT, OWNER, std::index_sequence_for<IES...>, IES...>::type;
+
+public:
+	using typename base_t::ies_t;
+
+	bool is_set() const
+	{
+		return this->m_ies.m_presence.any() || meta::fold<typename base_t::ies_types>(sl::packed_is{}, this->m_ies);
+	}
+};
+
+} //end: namespace detail
+
+/**
+ * Sequence and set keeping presence of single-instance IEs in one bitmap.
+ * @details Presence check of the container and validation of mandatory IEs
+ * are done by mask compare. Use IEs w/o own presence (e.g. packed_value)
+ * to shrink the container.
+ */
+template <class... IES>
+struct packed_sequence : detail::packed_container<sequence, packed_sequence<IES...>, IES...> {};
+
+template <class... IES>
+struct packed_set : detail::packed_container<set, packed_set<IES...>, IES...> {};
+
+} //end: namespace med
@@ -0,0 +1,79 @@
+/**
+@file
+adapters between med allocators and std::pmr::memory_resource
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <memory_resource>
+#include <new>
+
+#include "allocator.hpp"
+
+namespace med {
+
+/**
+ * Allocator over any memory resource to be used as ALLOCATOR of contexts.
+ * NOTE: med never deallocates thus the space is reclaimed by the resource
+ * itself (e.g. on release of pool or monotonic buffer).
+ */
+class pmr_allocator
+{
+public:
+	explicit pmr_allocator(std::pmr::memory_resource* res = std::pmr::get_default_resource()) noexcept
+		: m_resource{res} {}
+
+	[[nodiscard]]
+	void* allocate(std::size_t bytes, std::size_t alignment) noexcept
+	{
+		try
+		{
+			return m_resource->allocate(bytes, alignment);
+		}
+		catch (std::bad_alloc const&)
+		{
+			return nullptr;
+		}
+	}
+
+	std::pmr::memory_resource* resource() const noexcept  { return m_resource; }
+
+private:
+	std::pmr::memory_resource* m_resource;
+};
+
+/**
+ * Memory resource view of med allocator (e.g. med::allocator or med::arena)
+ * to use it with std::pmr containers.
+ * NOTE: deallocation does nothing as space is reclaimed on release of allocator.
+ */
+template <AAllocator ALLOCATOR>
+class allocator_resource : public std::pmr::memory_resource
+{
+public:
+	explicit allocator_resource(ALLOCATOR& alloc) noexcept : m_alloc{alloc} {}
+
+	ALLOCATOR& get_allocator() const noexcept        { return m_alloc; }
+
+private:
+	void* do_allocate(std::size_t bytes, std::size_t alignment) override
+	{
+		if (void* p = m_alloc.allocate(bytes, alignment)) { return p; }
+		throw std::bad_alloc{};
+	}
+
+	void do_deallocate(void*, std::size_t, std::size_t) override { }
+
+	bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override
+	{
+		return this == &other;
+	}
+
+	ALLOCATOR& m_alloc;
+};
+
+} //end: namespace med
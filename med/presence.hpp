@@ -0,0 +1,94 @@
+/**
+@file
+presence of IEs within container: bitmap or generation
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "concepts.hpp"
+
+namespace med {
+
+using generation_t = uint32_t;
+
+} //end: namespace med
+
+namespace med::detail {
+
+//no IEs with presence in container
+struct no_presence
+{
+	static constexpr bool has_mandatory() noexcept  { return true; }
+};
+
+/**
+ * Presence flags of packed IEs stored by container (bit per IE index).
+ * @details The smallest word fitting all flags is used up to 64 IEs.
+ */
+template <class... IES>
+class presence
+{
+public:
+	static constexpr std::size_t num_bits = sizeof...(IES);
+	using word_type = conditional_t<(num_bits <= 8), uint8_t,
+		conditional_t<(num_bits <= 16), uint16_t,
+		conditional_t<(num_bits <= 32), uint32_t, uint64_t>>>;
+	static constexpr std::size_t word_bits = 8 * sizeof(word_type);
+	static constexpr std::size_t num_words = (num_bits + word_bits - 1) / word_bits;
+
+	constexpr bool test(std::size_t i) const noexcept   { return m_bits[i / word_bits] & bit(i); }
+	constexpr void set(std::size_t i) noexcept          { m_bits[i / word_bits] |= bit(i); }
+	constexpr void reset(std::size_t i) noexcept        { m_bits[i / word_bits] &= ~bit(i); }
+	constexpr void clear() noexcept                     { for (auto& w : m_bits) { w = 0; } }
+
+	//any of packed IEs is set
+	constexpr bool any() const noexcept
+	{
+		word_type r = 0;
+		for (auto w : m_bits) { r |= w; }
+		return r != 0;
+	}
+
+	//all of mandatory packed IEs are set
+	constexpr bool has_mandatory() const noexcept
+	{
+		for (std::size_t i = 0; i < num_words; ++i)
+		{
+			if ((m_bits[i] & mandatory_mask[i]) != mandatory_mask[i]) { return false; }
+		}
+		return true;
+	}
+
+private:
+	static constexpr word_type bit(std::size_t i) noexcept  { return word_type(word_type(1) << (i % word_bits)); }
+
+	static constexpr auto mandatory_mask = []()
+	{
+		std::array<word_type, num_words> mask{};
+		std::size_t i = 0;
+		((AMandatory<IES> && APacked<IES> ? (mask[i / word_bits] |= bit(i), ++i) : ++i), ...);
+		return mask;
+	}();
+
+	word_type m_bits[num_words] {};
+};
+
+template <class... IES>
+using presence_t = conditional_t<(APacked<IES> || ...), presence<IES...>, no_presence>;
+
+//no IEs stamped with generation in container
+struct no_generation {};
+
+//generation of container the stale IEs are checked against (see generational)
+template <class... IES>
+using generation_of_t = conditional_t<(AStale<IES> || ...), generation_t, no_generation>;
+
+} //end: namespace med::detail
@@ -50,6 +50,18 @@ struct decoder : sl::octet_info
 		return ie.get_encoded();
 	}
 
+	//tag w/o consuming: varint is decoded and rolled back
+	template <class IE> std::size_t operator() (PEEK_TAG, IE& ie, std::size_t& tag)
+	{
+		auto& buf = get_context().buffer();
+		if (buf.empty()) { return 0; }
+		auto const st = buf.get_state();
+		tag = (*this)(ie, IE_TAG{});
+		std::size_t const size = buf.get_state() - st;
+		buf.set_state(st);
+		return size;
+	}
+
 	//IE_VALUE
 	//Little Endian Base 128: https://en.wikipedia.org/wiki/LEB128
 	template <class IE>
@@ -96,7 +108,7 @@ struct decoder : sl::octet_info
 	void operator() (IE& ie, IE_OCTET_STRING)
 	{
 		CODEC_TRACE("STR[%s] <-(%zu bytes): %s", name<IE>(), get_context().buffer().size(), get_context().buffer().toString());
-		if (ie.set_encoded(get_context().buffer().size(), get_context().buffer().begin()))
+		if (ie.set_encoded(get_context().buffer().size(), get_context().buffer().begin(), *this))
 		{
 			CODEC_TRACE("STR[%s] -> len = %zu bytes", name<IE>(), std::size_t(ie.size()));
 			get_context().buffer().template advance<IE>(ie.size());
@@ -9,6 +9,8 @@ Distributed under the MIT License
 
 #pragma once
 
+#include <algorithm>
+
 #include "config.hpp"
 #include "exception.hpp"
 #include "optional.hpp"
@@ -23,16 +25,48 @@ namespace med {
 
 namespace sl {
 
-template <class FUNC, class IE>
+//compound header of set leading the field carries its tag
+template <class FIELD, class HEADER>
+constexpr bool header_in()
+{
+	if constexpr (std::is_void_v<HEADER>) { return false; }
+	else { return leading_in<FIELD, HEADER>(); }
+}
+
+//compound header of set precedes the field which can't contain it (not a container)
+template <class FIELD, class HEADER>
+constexpr bool header_before()
+{
+	if constexpr (std::is_void_v<HEADER>) { return false; }
+	else { return not AContainer<FIELD>; }
+}
+
+//header with tag of the field (and its length if header has one)
+template <class HEADER, class TAG, class CTX, class FUNC, class FIELD>
+constexpr void encode_header(FUNC& func, FIELD const& field)
+{
+	HEADER header;
+	header.set_tag(TAG{}.get());
+	if constexpr (AHasSetLength<HEADER>) { header.set_length(sl::ie_length<CTX>(field, func)); }
+	med::encode(func, header);
+}
+
+template <class HEADER, class FUNC, class IE>
 inline constexpr void encode_single(FUNC& func, IE const& ie)
 {
 	if (ie.is_set())
 	{
 		using mi = meta::produce_info_t<FUNC, IE>;
-		constexpr bool explicit_meta = explicit_meta_in<mi, get_field_type_t<IE>>();
+		constexpr bool explicit_meta = explicit_meta_in<mi, get_field_type_t<IE>>() || header_in<get_field_type_t<IE>, HEADER>();
 
 		CODEC_TRACE("[%s]%s: %s", name<IE>(), class_name<IE>(), class_name<mi>());
-		if constexpr (explicit_meta)
+		if constexpr (header_before<get_field_type_t<IE>, HEADER>())
+		{
+			using ctx = type_context<IE_SET, meta::list_rest_t<mi>>;
+			encode_header<HEADER, get_info_t<meta::list_first_t<mi>>, ctx>(func, ie);
+			sl::ie_encode<ctx>(func, ie);
+		}
+		else if constexpr (explicit_meta)
 		{
 			using ctx = type_context<IE_SET, meta::list_rest_t<mi>>;
 			sl::ie_encode<ctx>(func, ie);
@@ -72,9 +106,10 @@ struct set_name
 	}
 };
 
+//HEADER is compound header of the set or void
 struct set_enc
 {
-	template <class CTX, class PREV_IE, class IE, class TO, class ENCODER>
+	template <class HEADER, class PREV_IE, class IE, class TO, class ENCODER>
 	static constexpr void apply(TO const& to, ENCODER& encoder)
 	{
 		IE const& ie = to;
@@ -82,7 +117,7 @@ struct set_enc
 		if constexpr (AMultiField<IE>)
 		{
 			using mi = meta::produce_info_t<ENCODER, IE>;
-			constexpr bool explicit_meta = explicit_meta_in<mi, get_field_type_t<IE>>();
+			constexpr bool explicit_meta = explicit_meta_in<mi, get_field_type_t<IE>>() || header_in<get_field_type_t<IE>, HEADER>();
 
 			CODEC_TRACE("[%s]*%zu: %s", name<IE>(), ie.count(), class_name<mi>());
 			check_arity(encoder, ie);
@@ -92,7 +127,13 @@ struct set_enc
 				//field was pushed but not set... do we need a new error?
 				if (not field.is_set()) { MED_THROW_EXCEPTION(missing_ie, name<IE>(), ie.count(), ie.count()-1) }
 
-				if constexpr (explicit_meta)
+				if constexpr (header_before<get_field_type_t<IE>, HEADER>())
+				{
+					using ctx = type_context<IE_SET, meta::list_rest_t<mi>>;
+					encode_header<HEADER, get_info_t<meta::list_first_t<mi>>, ctx>(encoder, field);
+					sl::ie_encode<ctx>(encoder, field);
+				}
+				else if constexpr (explicit_meta)
 				{
 					using ctx = type_context<IE_SET, meta::list_rest_t<mi>, get_info_t<meta::list_first_t<mi>>>;
 					sl::ie_encode<ctx>(encoder, field);
@@ -124,11 +165,11 @@ struct set_enc
 				{
 					setter(ie, to);
 				}
-				encode_single(encoder, ie);
+				encode_single<HEADER>(encoder, ie);
 			}
 			else
 			{
-				encode_single(encoder, ie);
+				encode_single<HEADER>(encoder, ie);
 			}
 		}
 	}
@@ -146,15 +187,18 @@ struct set_dec
 	}
 
 	template <class IE, class TO, class DECODER, class HEADER, class... DEPS>
-	static constexpr void apply(TO& to, DECODER& decoder, HEADER const&, DEPS&... deps)
+	static constexpr void apply(TO& to, DECODER& decoder, HEADER const& header, DEPS&... deps)
 	{
 		using mi = meta::produce_info_t<DECODER, IE>;
-		//pop back the tag we've read as we have non-fixed tag inside
-		using tag_t = get_info_t<meta::list_first_t<mi>>;
-		if constexpr (!APredefinedValue<tag_t>) { decoder(POP_STATE{}); }
 
-		IE& ie = to;
-		if constexpr (AMultiField<IE>)
+		IE& ie = ref_field<IE>(to);
+		if constexpr (AMultiField<IE> && unselected<DECODER, IE>())
+		{
+			//not pushed thus skipped (or decoded and dropped if can't be skipped)
+			typename IE::field_type field;
+			decode_field<mi>(field, decoder, header, deps...);
+		}
+		else if constexpr (AMultiField<IE>)
 		{
 			CODEC_TRACE("[%s]*%zu", name<IE>(), ie.count());
 			if (ie.count() >= IE::max)
@@ -162,15 +206,14 @@ struct set_dec
 				MED_THROW_EXCEPTION(extra_ie, name<IE>(), IE::max, ie.count())
 			}
 			auto* field = ie.push_back(decoder);
-			sl::ie_decode<type_context<IE_SET, meta::list_rest_t<mi>>>(decoder, *field, deps...);
+			decode_field<mi>(*field, decoder, header, deps...);
 		}
 		else //single-instance field
 		{
 			CODEC_TRACE("%c[%s]", ie.is_set()?'+':'-', name<IE>());
 			if (not ie.is_set())
 			{
-				return sl::ie_decode<type_context<IE_SET, meta::list_rest_t<mi>>>(decoder, ie, deps...);
-				//return med::decode(decoder, ie);
+				return decode_field<mi>(ie, decoder, header, deps...);
 			}
 			MED_THROW_EXCEPTION(extra_ie, name<IE>(), 2, 1)
 		}
@@ -181,18 +224,73 @@ struct set_dec
 	{
 		MED_THROW_EXCEPTION(unknown_tag, name<TO>(), get_tag(header))
 	}
+
+private:
+	//the header read for dispatch is handed to the field leading with it,
+	//precedes the field which is not a container (limiting it by the length
+	//if header has one), otherwise the state is restored back for the field
+	//to decode it again
+	template <class MI, class FIELD, class DECODER, class HEADER, class... DEPS>
+	static constexpr void decode_field(FIELD& field, DECODER& decoder, HEADER const& header, DEPS&... deps)
+	{
+		using tag_t = get_info_t<meta::list_first_t<MI>>;
+		using field_t = get_field_type_t<FIELD>;
+
+		if constexpr (AHasGetTag<HEADER> && leading_in<field_t, HEADER>()) //compound header
+		{
+			field.template ref<HEADER>().copy(header);
+			sl::ie_decode<type_context<IE_SET, meta::list_rest_t<MI>, HEADER>>(decoder, field, deps...);
+		}
+		else if constexpr (AHasGetTag<HEADER> && header_before<field_t, HEADER>())
+		{
+			using ctx = type_context<IE_SET, meta::list_rest_t<MI>>;
+			if constexpr (requires { header.get_length(); })
+			{
+				auto end = decoder(PUSH_SIZE{header.get_length()});
+				sl::ie_decode<ctx>(decoder, field, deps...);
+				if (0 != end.size()) { MED_THROW_EXCEPTION(overflow, name<FIELD>(), end.size()); }
+			}
+			else
+			{
+				sl::ie_decode<ctx>(decoder, field, deps...);
+			}
+		}
+		else if constexpr (!AHasGetTag<HEADER> && !APredefinedValue<tag_t> && leading_in<field_t, tag_t>()) //non-fixed tag
+		{
+			field.template ref<tag_t>().set_encoded(get_tag(header));
+			sl::ie_decode<type_context<IE_SET, meta::list_rest_t<MI>, tag_t>>(decoder, field, deps...);
+		}
+		else
+		{
+			if constexpr (AHasGetTag<HEADER> || !APredefinedValue<tag_t>) { decoder(POP_STATE{}); }
+			sl::ie_decode<type_context<IE_SET, meta::list_rest_t<MI>>>(decoder, field, deps...);
+		}
+	}
 };
 
+//has_packed is the result of mask check of all mandatory packed IEs
 struct set_check
 {
 	template <class IE, class TO, class DECODER>
-	static constexpr void apply(TO const& to, DECODER& decoder)
+	static constexpr void apply(TO const& to, DECODER& decoder, bool has_packed)
 	{
 		IE const& ie = to;
-		if constexpr (AMultiField<IE>)
+		if constexpr (unselected<DECODER, IE>())
+		{
+			return; //skipped on decode
+		}
+		else if constexpr (AMultiField<IE>)
 		{
 			check_arity(decoder, ie);
 		}
+		else if constexpr (APacked<IE> && AMandatory<IE>)
+		{
+			//the missing one is looked up only if the mask check failed
+			if (not (has_packed || ie.is_set()))
+			{
+				MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0)
+			}
+		}
 		else //single-instance field
 		{
 			if (not (AOptional<IE> || ie.is_set()))
@@ -214,7 +312,7 @@ struct set_check
 	}
 
 	template <class TO, class DECODER>
-	static constexpr void apply(TO const&, DECODER&) {}
+	static constexpr void apply(TO const&, DECODER&, bool) {}
 };
 
 }	//end: namespace sl
@@ -232,6 +330,7 @@ struct set_container<L<HEADER, IEs...>> : container<IE_SET, IEs...>
 template <template <class...> class L, class IE1, class... IEs>
 struct set_container<L<IE1, IEs...>> : container<IE_SET, IE1, IEs...>
 {
+	using header_type = void;
 	static constexpr bool plain_header = true; //plain header e.g. a tag
 };
 
@@ -251,7 +350,8 @@ struct set : detail::set_container<meta::typelist<IEs...>>
 	template <class ENCODER>
 	void encode(ENCODER& encoder) const
 	{
-		meta::foreach_prev<ies_types, void>(sl::set_enc{}, this->m_ies, encoder);
+		using header_t = typename detail::set_container<meta::typelist<IEs...>>::header_type;
+		meta::foreach_prev<ies_types, header_t>(sl::set_enc{}, this->m_ies, encoder);
 	}
 
 	template <class DECODER, class... DEPS>
@@ -282,12 +382,62 @@ struct set : detail::set_container<meta::typelist<IEs...>>
 			{
 				header_type header;
 				med::decode(decoder, header, deps...);
-				decoder(POP_STATE{}); //restore back for IE to decode itself (?TODO: better to copy instead)
 				CODEC_TRACE("tag=%#zX hdr=%s", std::size_t(get_tag(header)), class_name<header_type>());
 				meta::for_if<ies_types>(sl::set_dec{}, this->m_ies, decoder, header, deps...);
 			}
 		}
-		meta::foreach<ies_types>(sl::set_check{}, this->m_ies, decoder);
+		meta::foreach<ies_types>(sl::set_check{}, this->m_ies, decoder, this->m_ies.m_presence.has_mandatory());
+	}
+
+	/**
+	 * Decodes IEs dispatched by tags from the index (see tlv_index) instead
+	 * of reading their headers from the buffer.
+	 * @details The index is built over the buffer at the current state of
+	 * decoder. TLVs dropped from the index are skipped, the state is left
+	 * after the last decoded one. Each IE is decoded within its TLV.
+	 * The index only pays off for a subset of TLVs: dispatching all of them
+	 * from the index is slower than reading their headers (see benchmark
+	 * BM_tlv_indexed vs BM_tlv_decode) so a complete index falls back to
+	 * the plain decode of the scanned buffer, leaving the scan as its cost.
+	 * @throw invalid_value if TLV of the index is behind the decoded ones
+	 */
+	template <class DECODER, class INDEX, class... DEPS>
+	void decode_indexed(DECODER&& decoder, INDEX const& index, DEPS&... deps)
+	{
+		static_assert(set::plain_header, "INDEXED DECODE IS FOR SET WITH PLAIN TAG");
+		using IE = meta::list_first_t<ies_types>;
+		using mi = meta::produce_info_t<std::remove_cvref_t<DECODER>, IE>;
+		using tag_t = get_info_t<meta::list_first_t<mi>>;
+		constexpr int tag_bytes = int(INDEX::header_type::tag_bytes);
+		static_assert(tag_t::traits::bits == 8 * tag_bytes, "TAG OF INDEX DIFFERS FROM TAG OF SET");
+
+		auto const end = decoder(PUSH_SIZE{index.scanned_size()}); //TLVs are within the buffer scanned
+		if (index.complete())
+		{
+			decode(decoder, deps...);
+			return;
+		}
+
+		auto const start = decoder(GET_STATE{});
+		for (auto const& tlv : index)
+		{
+			auto const pos = std::size_t(decoder(GET_STATE{}) - start);
+			if (pos > tlv.offset) { MED_THROW_EXCEPTION(invalid_value, "TLV offset", tlv.offset) }
+			if (auto const delta = tlv.offset - pos)
+			{
+				decoder(ADVANCE_STATE{int(delta)}); //padding or skipped TLVs
+			}
+			//padding of the last TLV may be omitted
+			auto const size = std::min(INDEX::header_type::padded(tlv.length), index.scanned_size() - tlv.offset);
+			auto const tlv_end = decoder(PUSH_SIZE{size});
+			decoder(PUSH_STATE{}, *this);
+			decoder(ADVANCE_STATE{tag_bytes});
+			value<std::size_t> header;
+			header.set_encoded(tlv.tag);
+			CODEC_TRACE("tag=%#zX at %u", std::size_t(tlv.tag), tlv.offset);
+			meta::for_if<ies_types>(sl::set_dec{}, this->m_ies, decoder, header, deps...);
+		}
+		meta::foreach<ies_types>(sl::set_check{}, this->m_ies, decoder, this->m_ies.m_presence.has_mandatory());
 	}
 };
 
@@ -21,6 +21,7 @@ constexpr void field_copy(IE& to, IE const& from, ARGS&&... args)
 		if constexpr (AMultiField<IE>)
 		{
 			to.clear();
+			if constexpr (sizeof...(ARGS) == 1) { to.reserve(from.count(), args...); }
 			for (auto const& rhs : from)
 			{
 				auto* p = to.push_back(std::forward<ARGS>(args)...);
@@ -30,6 +30,9 @@ struct ADVANCE_STATE
 	int     delta;
 };
 
+//Read tag of IE w/o consuming it: returns its size in codec units (0 at the end of buffer).
+struct PEEK_TAG {};
+
 //Get length of IE in codec units
 struct GET_LENGTH {};
 //Set end of buffer (its size).
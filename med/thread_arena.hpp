@@ -0,0 +1,190 @@
+/**
+@file
+per-thread arena of bump chunks with per-message reset
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <new>
+
+namespace med {
+
+/**
+ * Bump allocator over chain of heap chunks owned by a thread.
+ * @details Allocation is a bump within the current chunk, a new chunk is taken
+ * from the heap only when it's exhausted. The chunks are kept between messages
+ * while the high-water mark (max space used by a message) is tracked: once a
+ * message spans several chunks they are replaced on release by a single chunk
+ * fitting the mark, thus the size adapts to the traffic w/o guessing.
+ * NOTE: not thread-safe by design - use thread_arena::local() per thread.
+ */
+class thread_arena
+{
+	struct alignas(std::max_align_t) chunk
+	{
+		chunk*      next;
+		std::size_t size;
+
+		uint8_t* data() noexcept                      { return reinterpret_cast<uint8_t*>(this + 1); }
+	};
+
+	struct position
+	{
+		chunk*      cur {nullptr};
+		void*       begin {nullptr};
+		std::size_t size {0};  //free in the chunk
+		std::size_t prev {0};  //used in previous chunks
+	};
+
+public:
+	static constexpr std::size_t DEFAULT_CHUNK = 4096;
+
+	thread_arena(thread_arena const&) = delete;
+	thread_arena& operator=(thread_arena const&) = delete;
+	explicit thread_arena(std::size_t chunk_size = DEFAULT_CHUNK) noexcept : m_chunk_size{chunk_size} {}
+	~thread_arena()                                   { free_chunks(); }
+
+	/**
+	 * Arena of the calling thread
+	 */
+	static thread_arena& local() noexcept
+	{
+		thread_local thread_arena arena;
+		return arena;
+	}
+
+	/**
+	 * Resets scope of a message: the arena is released when the outermost scope
+	 * is over while nested ones only rewind to the state on their construction
+	 */
+	class scope
+	{
+	public:
+		scope(scope const&) = delete;
+		scope& operator=(scope const&) = delete;
+		explicit scope(thread_arena& arena = thread_arena::local()) noexcept
+			: m_arena{arena}, m_mark{arena.m_pos}
+		{
+			++m_arena.m_depth;
+		}
+		~scope() noexcept
+		{
+			if (0 == --m_arena.m_depth) { m_arena.release(); }
+			else { m_arena.rewind(m_mark); }
+		}
+
+	private:
+		thread_arena& m_arena;
+		position      m_mark;
+	};
+
+	[[nodiscard]]
+	void* allocate(std::size_t bytes, std::size_t alignment) noexcept
+	{
+		if (void* p = bump(bytes, alignment)) { return p; }
+		return allocate_slow(bytes, alignment);
+	}
+
+	/**
+	 * Resets to the 1st chunk adapting its size to the high-water mark
+	 */
+	void release() noexcept
+	{
+		update_mark();
+		if (m_head && m_head->next)
+		{
+			//last message didn't fit into single chunk
+			free_chunks();
+			m_chunk_size = std::bit_ceil(std::max(m_chunk_size, m_hwm));
+		}
+		m_pos = m_head ? position{m_head, m_head->data(), m_head->size, 0} : position{};
+	}
+
+	//space used since release incl. alignment gaps
+	std::size_t used() const noexcept                 { return m_pos.cur ? m_pos.prev + m_pos.cur->size - m_pos.size : 0; }
+	//max space used by a message
+	std::size_t high_water_mark() const noexcept      { return std::max(m_hwm, used()); }
+	//size of new chunk
+	std::size_t chunk_size() const noexcept           { return m_chunk_size; }
+	std::size_t num_chunks() const noexcept
+	{
+		std::size_t num = 0;
+		for (auto* p = m_head; p; p = p->next) { ++num; }
+		return num;
+	}
+
+private:
+	void* bump(std::size_t bytes, std::size_t alignment) noexcept
+	{
+		auto const addr = reinterpret_cast<uintptr_t>(m_pos.begin);
+		auto const pad = (alignment - (addr & (alignment - 1))) & (alignment - 1);
+		if (pad + bytes > m_pos.size) { return nullptr; }
+		m_pos.begin = reinterpret_cast<uint8_t*>(addr + pad + bytes);
+		m_pos.size -= pad + bytes;
+		return reinterpret_cast<void*>(addr + pad);
+	}
+
+	void update_mark() noexcept                       { m_hwm = high_water_mark(); }
+
+	void rewind(position const& mark) noexcept
+	{
+		update_mark();
+		if (mark.cur) { m_pos = mark; }
+		else { m_pos = m_head ? position{m_head, m_head->data(), m_head->size, 0} : position{}; }
+	}
+
+	void* allocate_slow(std::size_t bytes, std::size_t alignment) noexcept
+	{
+		//try the chunks kept after release
+		while (m_pos.cur && m_pos.cur->next)
+		{
+			auto* next = m_pos.cur->next;
+			m_pos = position{next, next->data(), next->size, m_pos.prev + m_pos.cur->size};
+			if (void* p = bump(bytes, alignment)) { return p; }
+		}
+
+		auto const size = std::max(m_chunk_size, bytes + alignment);
+		auto* c = static_cast<chunk*>(::operator new(sizeof(chunk) + size, std::nothrow));
+		if (!c) { return nullptr; }
+		c->next = nullptr;
+		c->size = size;
+		if (m_pos.cur)
+		{
+			m_pos.cur->next = c;
+			m_pos = position{c, c->data(), size, m_pos.prev + m_pos.cur->size};
+		}
+		else
+		{
+			m_head = c;
+			m_pos = position{c, c->data(), size, 0};
+		}
+		return bump(bytes, alignment);
+	}
+
+	void free_chunks() noexcept
+	{
+		for (auto* p = m_head; p; )
+		{
+			auto* next = p->next;
+			::operator delete(p);
+			p = next;
+		}
+		m_head = nullptr;
+		m_pos = position{};
+	}
+
+	chunk*      m_head {nullptr};
+	position    m_pos;
+	std::size_t m_chunk_size;
+	std::size_t m_hwm {0};
+	std::size_t m_depth {0};
+};
+
+} //end: namespace med
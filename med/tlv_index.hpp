@@ -0,0 +1,167 @@
+/**
+@file
+index of TLV boundaries in octet buffer built before decode
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "exception.hpp"
+#include "padding.hpp"
+
+namespace med {
+
+/**
+ * Layout of TLV header (tag and length are big-endian).
+ * @tparam TAG_BYTES   size of tag at the start of header
+ * @tparam LEN_BYTES   size of length
+ * @tparam PAD         padding of TLV (e.g. med::padding<uint32_t>) or void
+ * @tparam LEN_OFFSET  offset of length from the start of header
+ * @tparam HDR_BYTES   size of header
+ * @tparam HDR_IN_LEN  length includes the header
+ * E.g. Diameter AVP: tlv_header<4, 3, med::padding<uint32_t>, 5, 8, true>
+ */
+template <std::size_t TAG_BYTES, std::size_t LEN_BYTES, class PAD = void
+	, std::size_t LEN_OFFSET = TAG_BYTES, std::size_t HDR_BYTES = LEN_OFFSET + LEN_BYTES, bool HDR_IN_LEN = false>
+	requires (TAG_BYTES > 0 && TAG_BYTES <= 4 && LEN_BYTES > 0 && LEN_BYTES <= 4 && LEN_OFFSET + LEN_BYTES <= HDR_BYTES)
+struct tlv_header
+{
+	static constexpr std::size_t tag_bytes = TAG_BYTES;
+	static constexpr std::size_t len_bytes = LEN_BYTES;
+	static constexpr std::size_t len_offset = LEN_OFFSET;
+	static constexpr std::size_t size = HDR_BYTES;
+	static constexpr bool header_in_length = HDR_IN_LEN;
+
+	static constexpr std::size_t pad_bytes = []
+	{
+		if constexpr (std::is_void_v<PAD>) { return std::size_t(1); }
+		else { return std::size_t(get_padding<PAD>::type::pad_bits / 8); }
+	}();
+
+	//length of TLV rounded up to padding
+	static constexpr std::size_t padded(std::size_t len)
+	{
+		return pad_bytes > 1 ? (len + pad_bytes - 1) / pad_bytes * pad_bytes : len;
+	}
+
+	template <std::size_t N>
+	static constexpr uint32_t load(uint8_t const* p)
+	{
+		uint32_t res = 0;
+		for (std::size_t i = 0; i < N; ++i) { res = (res << 8) | p[i]; }
+		return res;
+	}
+};
+
+//TLV found in buffer: offset and length (w/o padding) of whole TLV with its header
+struct tlv_entry
+{
+	uint32_t    tag;
+	uint32_t    offset;
+	uint32_t    length;
+};
+
+/**
+ * Boundaries of TLVs in octet buffer found in one pass over their headers.
+ * @details Lengths are validated against the buffer before decode thus
+ * the TLVs can be dispatched from the index (see set::decode_indexed),
+ * looked up by tag or dropped w/o parsing their headers again.
+ * @tparam HEADER layout of TLV header (see tlv_header)
+ * @tparam CAPACITY max number of TLVs in the index
+ */
+template <class HEADER, std::size_t CAPACITY = 128>
+class tlv_index
+{
+public:
+	using header_type = HEADER;
+	using const_iterator = tlv_entry const*;
+
+	/**
+	 * Builds the index of TLVs in buffer.
+	 * @param data buffer starting with TLV header
+	 * @return number of TLVs found
+	 * @throw overflow if TLV exceeds the buffer
+	 * @throw invalid_value if length is less than header
+	 * @throw extra_ie if more than CAPACITY TLVs
+	 */
+	std::size_t scan(std::span<uint8_t const> data)
+	{
+		//NOTE: locals since octets may alias the members
+		uint8_t const* const start = data.data();
+		std::size_t const size = data.size();
+		std::size_t count = 0;
+		std::size_t pos = 0;
+		m_size = 0;
+		m_scanned = size;
+		while (pos < size)
+		{
+			auto const rest = size - pos;
+			if (rest < HEADER::size) { MED_THROW_EXCEPTION(overflow, "TLV header", HEADER::size - rest) }
+
+			uint8_t const* p = start + pos;
+			std::size_t len = HEADER::template load<HEADER::len_bytes>(p + HEADER::len_offset);
+			if constexpr (HEADER::header_in_length)
+			{
+				if (len < HEADER::size) { MED_THROW_EXCEPTION(invalid_value, "TLV length", len) }
+			}
+			else
+			{
+				len += HEADER::size;
+			}
+			if (len > rest) { MED_THROW_EXCEPTION(overflow, "TLV", len - rest) }
+			if (count == CAPACITY) { MED_THROW_EXCEPTION(extra_ie, "TLV", CAPACITY, count + 1) }
+
+			m_entries[count++] = {HEADER::template load<HEADER::tag_bytes>(p), uint32_t(pos), uint32_t(len)};
+			pos += HEADER::padded(len); //padding of the last TLV may be omitted
+		}
+		m_size = count;
+		m_found = count;
+		return count;
+	}
+
+	//first TLV with the tag or nullptr
+	tlv_entry const* find(uint32_t tag) const
+	{
+		for (auto& e : *this) { if (e.tag == tag) { return &e; } }
+		return nullptr;
+	}
+
+	//drops TLVs not to be decoded keeping the order of the rest
+	template <class PRED>
+	void remove_if(PRED pred)
+	{
+		std::size_t n = 0;
+		for (std::size_t i = 0; i < m_size; ++i)
+		{
+			if (not pred(m_entries[i])) { m_entries[n++] = m_entries[i]; }
+		}
+		m_size = n;
+	}
+
+	void clear() noexcept                           { m_size = 0; m_found = 0; m_scanned = 0; }
+	//no TLV was dropped since the scan
+	bool complete() const noexcept                  { return m_size == m_found; }
+	//size of buffer the index was built for
+	std::size_t scanned_size() const noexcept       { return m_scanned; }
+	std::size_t size() const noexcept               { return m_size; }
+	bool empty() const noexcept                     { return 0 == m_size; }
+	tlv_entry const& operator[](std::size_t i) const { return m_entries[i]; }
+	const_iterator begin() const noexcept           { return m_entries.data(); }
+	const_iterator end() const noexcept             { return m_entries.data() + m_size; }
+
+private:
+	std::array<tlv_entry, CAPACITY> m_entries;
+	std::size_t                     m_size {0};
+	std::size_t                     m_found {0};
+	std::size_t                     m_scanned {0};
+};
+
+}	//end: namespace med
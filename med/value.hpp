@@ -87,6 +87,37 @@ private:
 	value_type m_value{};
 };
 
+/**
+ * numeric value w/o presence flag thus always set by itself
+ * its presence is kept by packed container (see packed.hpp)
+ * NOTE: not for multi-fields which rely on presence of the field
+ */
+template <class TRAITS>
+struct bare_value : IE<IE_VALUE>
+{
+	using traits     = TRAITS;
+	using value_type = typename traits::value_type;
+	using base_t     = bare_value;
+
+	value_type get() const noexcept                 { return get_encoded(); }
+	void set(value_type v) noexcept                 { set_encoded(v); }
+
+	//NOTE: do not override!
+	static constexpr bool is_defined = false;
+	value_type get_encoded() const noexcept         { return m_value; }
+	void set_encoded(value_type v) noexcept         { m_value = v; }
+	void clear() noexcept                           { }
+	static constexpr bool is_set() noexcept         { return true; }
+	explicit operator bool() const noexcept         { return is_set(); }
+	template <class... ARGS>
+	void copy(base_t const& from, ARGS&&...)noexcept{ m_value = from.m_value; }
+
+	bool operator==(bare_value const& rhs) const noexcept { return get_encoded() == rhs.get_encoded(); }
+
+private:
+	value_type m_value{};
+};
+
 /**
  * plain fixed integral value
  * gives error if decoded value doesn't match the fixed one
@@ -206,4 +237,10 @@ template<std::size_t N, std::size_t OFS, class... EXT_TRAITS>
 struct value<bits<N, OFS>, EXT_TRAITS...>
 		: detail::numeric_value<value_traits<bits<N, OFS>, EXT_TRAITS...>> {};
 
+/**
+ * numeric value w/o own presence flag to be used in packed containers
+ */
+template <class T, class... EXT_TRAITS>
+struct packed_value : detail::bare_value<value_traits<T, EXT_TRAITS...>> {};
+
 } //namespace med
@@ -0,0 +1,191 @@
+#include <thread>
+
+#include "ut.hpp"
+#include "thread_arena.hpp"
+#include "arena.hpp"
+
+namespace ar {
+
+struct byte : med::value<uint8_t> {};
+struct word : med::value<uint16_t> {};
+
+struct msg : med::sequence<
+	M< T<0xF1>, byte, med::inf >, //<TV>*[1,*)
+	O< T<0xF2>, word >
+>{};
+
+} //end: namespace ar
+
+TEST(arena, adaptive_chunk)
+{
+	med::thread_arena arena{64};
+	EXPECT_EQ(0, arena.num_chunks());
+	{
+		med::thread_arena::scope scope{arena};
+		for (int i = 0; i < 3; ++i) { ASSERT_NE(nullptr, arena.allocate(40, 8)); }
+		EXPECT_EQ(3, arena.num_chunks());
+		EXPECT_EQ(64 + 64 + 40, arena.used());
+	}
+	//the message didn't fit: chunk is adapted to the mark
+	EXPECT_EQ(168, arena.high_water_mark());
+	EXPECT_EQ(0, arena.num_chunks());
+	EXPECT_EQ(256, arena.chunk_size());
+	EXPECT_EQ(0, arena.used());
+
+	for (int n = 0; n < 2; ++n)
+	{
+		med::thread_arena::scope scope{arena};
+		for (int i = 0; i < 3; ++i) { ASSERT_NE(nullptr, arena.allocate(40, 8)); }
+		EXPECT_EQ(1, arena.num_chunks());
+	}
+	EXPECT_EQ(1, arena.num_chunks());
+}
+
+TEST(arena, nested_scope)
+{
+	med::thread_arena arena{128};
+	med::thread_arena::scope outer{arena};
+	auto* p1 = arena.allocate(8, 8);
+	void* p2;
+	{
+		med::thread_arena::scope inner{arena};
+		p2 = arena.allocate(16, 8);
+		EXPECT_NE(p1, p2);
+	}
+	//rewound to the state before inner
+	EXPECT_EQ(p2, arena.allocate(16, 8));
+	//alignment
+	EXPECT_NE(nullptr, arena.allocate(1, 1));
+	auto* p = arena.allocate(8, 8);
+	EXPECT_EQ(0, reinterpret_cast<uintptr_t>(p) % 8);
+}
+
+TEST(arena, thread_local)
+{
+	med::thread_arena* main_arena = &med::thread_arena::local();
+	med::thread_arena* other_arena = nullptr;
+	std::thread t{[&other_arena]{ other_arena = &med::thread_arena::local(); }};
+	t.join();
+	EXPECT_NE(main_arena, other_arena);
+	EXPECT_EQ(main_arena, &med::thread_arena::local());
+}
+
+TEST(arena, decode)
+{
+	uint8_t const encoded[] = {
+		0xF1, 0x01,
+		0xF1, 0x02,
+		0xF1, 0x03,
+		0xF2, 0x12, 0x34,
+	};
+
+	auto& arena = med::thread_arena::local();
+	for (int i = 0; i < 2; ++i)
+	{
+		med::thread_arena::scope scope;
+		med::decoder_context<med::thread_arena> ctx{ encoded, &arena };
+		ar::msg msg;
+		decode(med::octet_decoder{ctx}, msg);
+		EXPECT_EQ(3, msg.count<ar::byte>());
+		EXPECT_LT(0, arena.used());
+	}
+	EXPECT_EQ(0, arena.used());
+	EXPECT_LT(0, arena.high_water_mark());
+}
+
+namespace {
+
+//counts chunks taken from upstream
+struct counting_resource : std::pmr::memory_resource
+{
+	std::size_t allocated {0};
+	std::size_t deallocated {0};
+
+	void* do_allocate(std::size_t bytes, std::size_t align) override
+	{
+		++allocated;
+		return std::pmr::new_delete_resource()->allocate(bytes, align);
+	}
+	void do_deallocate(void* p, std::size_t bytes, std::size_t align) override
+	{
+		++deallocated;
+		std::pmr::new_delete_resource()->deallocate(p, bytes, align);
+	}
+	bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override { return this == &other; }
+};
+
+} //end: namespace
+
+TEST(arena, chained)
+{
+	counting_resource upstream;
+	{
+		uint8_t mem[32];
+		med::arena arena{mem, med::arena::UNLIMITED, &upstream};
+		//initial buffer first
+		auto* p = arena.allocate(32, 1);
+		EXPECT_EQ(mem, p);
+		EXPECT_EQ(0, upstream.allocated);
+		//then chunks growing twice
+		ASSERT_NE(nullptr, arena.allocate(32, 1));
+		ASSERT_NE(nullptr, arena.allocate(40, 1));
+		EXPECT_EQ(2, arena.num_chunks());
+		EXPECT_EQ(2, upstream.allocated);
+		EXPECT_EQ(32 + 33 + 64, arena.capacity());
+
+		arena.release();
+		EXPECT_EQ(0, arena.num_chunks());
+		EXPECT_EQ(2, upstream.deallocated);
+		EXPECT_EQ(mem, arena.allocate(8, 1));
+	}
+
+	upstream.allocated = upstream.deallocated = 0;
+	{
+		//initial chunk from upstream is kept on release
+		med::arena arena{64, 128, &upstream};
+		EXPECT_EQ(0, arena.capacity());
+		auto* p = arena.allocate(64, 1);
+		EXPECT_EQ(64 + 1, arena.capacity());
+		EXPECT_EQ(0, arena.num_chunks());
+		//limited by max size
+		EXPECT_NE(nullptr, arena.allocate(32, 1));
+		EXPECT_EQ(nullptr, arena.allocate(64, 1));
+		arena.release();
+		EXPECT_EQ(1, upstream.deallocated);
+		EXPECT_EQ(p, arena.allocate(8, 1));
+	}
+	EXPECT_EQ(2, upstream.allocated);
+	EXPECT_EQ(2, upstream.deallocated);
+}
+
+TEST(arena, chained_decode)
+{
+	//more IEs than fit initial buffer
+	uint8_t encoded[2 * 32];
+	for (std::size_t i = 0; i < sizeof(encoded); i += 2) { encoded[i] = 0xF1; encoded[i + 1] = uint8_t(i); }
+
+	uint8_t mem[64];
+	med::arena arena{mem};
+	med::decoder_context<med::arena> ctx{ encoded, &arena };
+	ar::msg msg;
+	decode(med::octet_decoder{ctx}, msg);
+	EXPECT_EQ(32, msg.count<ar::byte>());
+	EXPECT_LT(0, arena.num_chunks());
+
+	//limited to initial buffer
+	med::arena limited{mem, sizeof(mem), sizeof(mem)};
+	med::decoder_context<med::arena> lctx{ encoded, &limited };
+	msg.clear();
+	EXPECT_THROW(decode(med::octet_decoder{lctx}, msg), med::out_of_memory);
+}
+
+#if defined(__linux__)
+TEST(arena, hugepage)
+{
+	med::arena arena{64, med::arena::UNLIMITED, med::hugepage_resource::instance()};
+	auto* p = static_cast<uint8_t*>(arena.allocate(1000, 8));
+	ASSERT_NE(nullptr, p);
+	std::memset(p, 0xA5, 1000);
+	EXPECT_EQ(0xA5, p[999]);
+}
+#endif
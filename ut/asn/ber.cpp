@@ -528,6 +528,24 @@ END
 #endif
 }
 
+TEST(asn_ber, octet_string_sbo)
+{
+	//octet string kept inline up to 4 octets
+	struct sbo_octets : med::octet_string<med::octets_var_sbo<4>>
+		, med::add_meta_info<med::add_tag<med::asn::traits<med::asn::tg_value::OCTET_STRING>>> {};
+	uint8_t encoded[] = {0x04, 6, 1, 2, 3, 4, 5, 6};
+	uint8_t mem[64];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> ctx{encoded, sizeof(encoded), &alloc};
+	sbo_octets s;
+	decode(med::asn::ber::decoder{ctx}, s);
+	//long value is copied thus survives reuse of the input buffer
+	std::memset(encoded, 0, sizeof(encoded));
+	uint8_t const exp[] = {1, 2, 3, 4, 5, 6};
+	ASSERT_EQ(sizeof(exp), s.size());
+	EXPECT_TRUE(Matches(exp, s.data()));
+}
+
 //8.8 Encoding of a null value
 TEST(asn_ber, null)
 {
@@ -0,0 +1,276 @@
+#include "../ut.hpp"
+
+#include "asn/asn.hpp"
+#include "asn/ber/ber_encoder.hpp"
+#include "asn/ber/ber_decoder.hpp"
+#include "asn/oer/oer_encoder.hpp"
+#include "asn/oer/oer_decoder.hpp"
+
+using namespace std::literals;
+
+namespace {
+
+template <class IE>
+char const* encoded(IE const& enc)
+{
+	uint8_t enc_buf[1024] = {};
+	med::encoder_context<> ectx{ enc_buf };
+	encode(med::asn::oer::encoder{ectx}, enc);
+
+	med::decoder_context<> dctx{ectx.buffer().get_start(), ectx.buffer().get_offset()};
+	IE dec;
+	decode(med::asn::oer::decoder{dctx}, dec);
+	EXPECT_EQ(ectx.buffer().get_offset(), dctx.buffer().get_offset());
+
+	//re-encoding of decoded is to match the original
+	uint8_t dec_buf[1024] = {};
+	med::encoder_context<> rctx{ dec_buf };
+	encode(med::asn::oer::encoder{rctx}, dec);
+	EXPECT_EQ(ectx.buffer().get_offset(), rctx.buffer().get_offset());
+	EXPECT_EQ(0, std::memcmp(enc_buf, dec_buf, ectx.buffer().get_offset()));
+
+	return as_string(ectx.buffer());
+}
+
+template <class IE, class... ARGS>
+char const* encoded(ARGS&&... args)
+{
+	IE ie;
+	ie.set(std::forward<ARGS>(args)...);
+	return encoded(ie);
+}
+
+//BER -> OER -> BER
+template <class IE, std::size_t N>
+char const* transcoded(uint8_t const (&ber)[N])
+{
+	IE from_ber;
+	med::decoder_context<> bctx{ ber };
+	decode(med::asn::ber::decoder{bctx}, from_ber);
+
+	char const* oer = encoded(from_ber);
+
+	uint8_t enc_buf[1024] = {};
+	med::encoder_context<> ectx{ enc_buf };
+	encode(med::asn::ber::encoder{ectx}, from_ber);
+	EXPECT_EQ(N, ectx.buffer().get_offset());
+	EXPECT_TRUE(Matches(ber, enc_buf));
+
+	return oer;
+}
+
+} //end: namespace
+
+//X.696 9 Encoding of boolean values
+TEST(asn_oer, boolean)
+{
+	EXPECT_STREQ("FF ", encoded<med::asn::boolean>(true));
+	EXPECT_STREQ("00 ", encoded<med::asn::boolean>(false));
+}
+
+//X.696 10 Encoding of integer values
+TEST(asn_oer, integer)
+{
+	EXPECT_STREQ("01 00 ", encoded<med::asn::integer>(0));
+	EXPECT_STREQ("01 7F ", encoded<med::asn::integer>(127));
+	EXPECT_STREQ("02 00 80 ", encoded<med::asn::integer>(128));
+	EXPECT_STREQ("01 80 ", encoded<med::asn::integer>(-128));
+	EXPECT_STREQ("02 FF 7F ", encoded<med::asn::integer>(-129));
+}
+
+TEST(asn_oer, constrained_integer)
+{
+	using int_0_255 = med::asn::ranged<0, 255>;
+	using int_0_64k = med::asn::ranged<0, 65535>;
+	using int_0_100k = med::asn::ranged<0, 100000>;
+	using int_m3_4 = med::asn::ranged<-3, 4>;
+	using int_m1k_1k = med::asn::ranged<-1000, 1000>;
+
+	EXPECT_STREQ("C8 ", encoded<int_0_255>(200));
+	EXPECT_STREQ("03 E8 ", encoded<int_0_64k>(1000));
+	EXPECT_STREQ("00 00 03 E8 ", encoded<int_0_100k>(1000));
+	EXPECT_STREQ("FD ", encoded<int_m3_4>(-3));
+	EXPECT_STREQ("FF FE ", encoded<int_m1k_1k>(-2));
+
+	uint8_t enc_buf[8];
+	med::encoder_context<> ectx{ enc_buf };
+	int_m3_4 ie;
+	ie.set(5);
+	EXPECT_THROW(encode(med::asn::oer::encoder{ectx}, ie), med::invalid_value);
+
+	//out of range
+	uint8_t const encoded[] = {0x05};
+	med::decoder_context<> dctx{ encoded };
+	EXPECT_THROW(decode(med::asn::oer::decoder{dctx}, ie), med::invalid_value);
+}
+
+//X.696 11 Encoding of enumerated values
+TEST(asn_oer, enumerated)
+{
+	EXPECT_STREQ("05 ", encoded<med::asn::enumerated>(5));
+	EXPECT_STREQ("82 00 C8 ", encoded<med::asn::enumerated>(200));
+	EXPECT_STREQ("81 FF ", encoded<med::asn::enumerated>(-1));
+}
+
+//X.696 Encoding of bitstring values
+TEST(asn_oer, bit_string)
+{
+	uint8_t const none[] = {0};
+	EXPECT_STREQ("01 00 ", encoded<med::asn::bit_string>(0, none));
+	uint8_t const small[] = {0x0A,0x3B,0x5F,0x29,0x1C,0xD0};
+	EXPECT_STREQ("07 04 0A 3B 5F 29 1C D0 ", encoded<med::asn::bit_string>(11*4, small));
+	//BIT STRING (SIZE(12))
+	using fixed_bits = med::bit_string<med::min<12>, med::max<12>>;
+	EXPECT_STREQ("0A 30 ", encoded<fixed_bits>(12, small));
+}
+
+//X.696 Encoding of octetstring values
+TEST(asn_oer, octet_string)
+{
+	uint8_t const small[] = {1, 2, 3};
+	EXPECT_STREQ("03 01 02 03 ", encoded<med::asn::octet_string>(std::size(small), small));
+
+	std::vector<uint8_t> big(333);
+	for (std::size_t i = 0; i < big.size(); ++i) { big[i] = uint8_t(i); }
+	EXPECT_EQ(0, std::strncmp("82 01 4D 00 01 02 ", encoded<med::asn::octet_string>(big.size(), big.data()), 18));
+}
+
+TEST(asn_oer, octet_string_sbo)
+{
+	//octet string kept inline up to 4 octets
+	struct sbo_octets : med::octet_string<med::octets_var_sbo<4>>
+		, med::add_meta_info<med::add_tag<med::asn::traits<med::asn::tg_value::OCTET_STRING>>> {};
+	uint8_t encoded[] = {6, 1, 2, 3, 4, 5, 6};
+	uint8_t mem[64];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> ctx{encoded, sizeof(encoded), &alloc};
+	sbo_octets s;
+	decode(med::asn::oer::decoder{ctx}, s);
+	//long value is copied thus survives reuse of the input buffer
+	std::memset(encoded, 0, sizeof(encoded));
+	uint8_t const exp[] = {1, 2, 3, 4, 5, 6};
+	ASSERT_EQ(sizeof(exp), s.size());
+	EXPECT_TRUE(Matches(exp, s.data()));
+}
+
+namespace ao {
+
+template <typename ...T>
+using M = med::mandatory<T...>;
+template <typename ...T>
+using O = med::optional<T...>;
+
+struct moct : med::asn::octet_string_t<med::asn::traits<0, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+struct ooct : med::asn::octet_string_t<med::asn::traits<1, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+struct mint : med::asn::value_t<int, med::asn::traits<2, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+struct oint : med::asn::value_t<int, med::asn::traits<3, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+
+struct Seq : med::asn::sequence<
+	M<moct>,
+	O<ooct>,
+	M<mint>,
+	O<oint>
+>
+{};
+
+struct Set : med::asn::set<
+	M<moct>,
+	O<ooct>,
+	M<mint>,
+	O<oint>
+>
+{};
+
+struct one : med::asn::octet_string_t<med::asn::traits<0, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+struct two : med::asn::value_t<int, med::asn::traits<1, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+struct far : med::asn::value_t<int, med::asn::traits<1024, med::asn::tg_class::APPLICATION>> {};
+
+struct Choice : med::asn::choice<
+	O<one>,
+	O<two>,
+	O<far>
+>
+{};
+
+//alternative stored out of line
+struct Compact : med::asn::choice<
+	O<two>,
+	med::out_of_line< O<one> >
+>
+{};
+
+} //end: namespace ao
+
+//X.696 Encoding of sequence values (BER examples of asn_ber.sequence)
+TEST(asn_oer, sequence)
+{
+	uint8_t const full[] = {0x30, 0x12, 0x80, 0x02, 0x12, 0x34, 0x81, 0x03, 0x45, 0x67, 0x89, 0x82, 0x01, 0x07, 0x83, 0x04, 0x3A, 0xDE, 0x68, 0xB1};
+	EXPECT_STREQ("C0 02 12 34 03 45 67 89 01 07 04 3A DE 68 B1 ", transcoded<ao::Seq>(full));
+
+	uint8_t const mandatory[] = {0x30, 0x07, 0x80, 0x02, 0x12, 0x34, 0x82, 0x01, 0x07};
+	EXPECT_STREQ("00 02 12 34 01 07 ", transcoded<ao::Seq>(mandatory));
+
+	ao::Seq s;
+	uint8_t enc_buf[32];
+	med::encoder_context<> ectx{ enc_buf };
+	EXPECT_THROW(encode(med::asn::oer::encoder{ectx}, s), med::missing_ie);
+}
+
+//X.696 Encoding of set values (BER examples of asn_ber.set)
+TEST(asn_oer, set)
+{
+	uint8_t const full[] = {0x31, 0x12, 0x80, 0x02, 0x12, 0x34, 0x81, 0x03, 0x45, 0x67, 0x89, 0x82, 0x01, 0x07, 0x83, 0x04, 0x3A, 0xDE, 0x68, 0xB1};
+	EXPECT_STREQ("C0 02 12 34 03 45 67 89 01 07 04 3A DE 68 B1 ", transcoded<ao::Set>(full));
+}
+
+//X.696 Encoding of sequence-of values (BER example of asn_ber.sequence_of)
+TEST(asn_oer, sequence_of)
+{
+	using seqof = med::asn::sequence_of<med::asn::integer, med::max<5>>;
+	uint8_t const ber[] = {0x30, 0x0F, 0x02, 0x01, 0x01, 0x02, 0x01, 0x02, 0x02, 0x01, 0x03, 0x02, 0x01, 0x04, 0x02, 0x01, 0x05};
+	EXPECT_STREQ("01 05 01 01 01 02 01 03 01 04 01 05 ", transcoded<seqof>(ber));
+}
+
+//X.696 Encoding of choice values (BER examples of asn_ber.choice)
+TEST(asn_oer, choice)
+{
+	uint8_t const one[] = {0x80, 0x02, 0x12, 0x34};
+	EXPECT_STREQ("80 02 12 34 ", transcoded<ao::Choice>(one));
+	uint8_t const two[] = {0x81, 0x01, 0x07};
+	EXPECT_STREQ("81 01 07 ", transcoded<ao::Choice>(two));
+
+	ao::Choice s;
+	//tag number above 62 is encoded in subsequent octets
+	s.ref<ao::far>().set(7);
+	EXPECT_STREQ("7F 88 00 01 07 ", encoded(s));
+
+	uint8_t const unknown[] = {0x82, 0x01, 0x07};
+	med::decoder_context<> dctx{ unknown };
+	EXPECT_THROW(decode(med::asn::oer::decoder{dctx}, s), med::unknown_tag);
+}
+
+TEST(asn_oer, choice_out_of_line)
+{
+	uint8_t mem[256];
+	med::allocator alloc{mem};
+	ao::Compact s;
+	uint8_t const oct_val[] = {0x12, 0x34};
+	s.ref<ao::one>(alloc).set(sizeof(oct_val), oct_val);
+
+	uint8_t enc_buf[32];
+	med::encoder_context<> ectx{ enc_buf };
+	encode(med::asn::oer::encoder{ectx}, s);
+
+	ao::Compact d;
+	//no allocator to place it
+	med::decoder_context<> nctx{ectx.buffer().get_start(), ectx.buffer().get_offset()};
+	EXPECT_THROW(decode(med::asn::oer::decoder{nctx}, d), med::out_of_memory);
+
+	d.clear();
+	med::decoder_context<med::allocator> dctx{ectx.buffer().get_start(), ectx.buffer().get_offset(), &alloc};
+	decode(med::asn::oer::decoder{dctx}, d);
+	EXPECT_EQ(ectx.buffer().get_offset(), dctx.buffer().get_offset());
+	auto const* one = d.get<ao::one>();
+	ASSERT_NE(nullptr, one);
+	EXPECT_TRUE(Matches(oct_val, one->data()));
+}
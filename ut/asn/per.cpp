@@ -0,0 +1,329 @@
+#include "../ut.hpp"
+
+#include "asn/asn.hpp"
+#include "asn/per/per_encoder.hpp"
+#include "asn/per/per_decoder.hpp"
+
+using namespace std::literals;
+using med::asn::per::aligned;
+using med::asn::per::unaligned;
+
+namespace {
+
+template <class VARIANT, class IE>
+char const* encoded(IE const& enc)
+{
+	uint8_t enc_buf[1024] = {};
+	med::encoder_context<> ectx{ enc_buf };
+
+	encode(med::asn::per::encoder{ectx, VARIANT{}}, enc);
+
+	//UNALIGNED strings are not zero-copy thus need the memory to decode
+	uint8_t mem[1024];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> dctx{ectx.buffer().get_start(), ectx.buffer().get_offset(), &alloc};
+	IE dec;
+	decode(med::asn::per::decoder{dctx, VARIANT{}}, dec);
+	EXPECT_EQ(ectx.buffer().get_offset(), dctx.buffer().get_offset());
+
+	//re-encoding of decoded is to match the original
+	uint8_t dec_buf[1024] = {};
+	med::encoder_context<> rctx{ dec_buf };
+	encode(med::asn::per::encoder{rctx, VARIANT{}}, dec);
+	EXPECT_EQ(ectx.buffer().get_offset(), rctx.buffer().get_offset());
+	EXPECT_EQ(0, std::memcmp(enc_buf, dec_buf, ectx.buffer().get_offset()));
+
+	return as_string(ectx.buffer());
+}
+
+template <class IE, class... ARGS>
+char const* aper(ARGS&&... args)
+{
+	IE ie;
+	ie.set(std::forward<ARGS>(args)...);
+	return encoded<aligned>(ie);
+}
+
+template <class IE, class... ARGS>
+char const* uper(ARGS&&... args)
+{
+	IE ie;
+	ie.set(std::forward<ARGS>(args)...);
+	return encoded<unaligned>(ie);
+}
+
+} //end: namespace
+
+//X.691 12 Encoding the boolean type
+TEST(asn_per, boolean)
+{
+	EXPECT_STREQ("80 ", aper<med::asn::boolean>(true));
+	EXPECT_STREQ("00 ", aper<med::asn::boolean>(false));
+	EXPECT_STREQ("80 ", uper<med::asn::boolean>(true));
+}
+
+//X.691 13 Encoding the integer type
+TEST(asn_per, integer)
+{
+	//unconstrained
+	EXPECT_STREQ("01 00 ", aper<med::asn::integer>(0));
+	EXPECT_STREQ("01 7F ", aper<med::asn::integer>(127));
+	EXPECT_STREQ("02 00 80 ", aper<med::asn::integer>(128));
+	EXPECT_STREQ("01 80 ", aper<med::asn::integer>(-128));
+	EXPECT_STREQ("02 FF 7F ", aper<med::asn::integer>(-129));
+	EXPECT_STREQ("04 3A DE 68 B1 ", uper<med::asn::integer>(987654321));
+}
+
+TEST(asn_per, constrained_integer)
+{
+	using int_0_7 = med::asn::ranged<0, 7>;
+	using int_m3_4 = med::asn::ranged<-3, 4>;
+	using int_0_255 = med::asn::ranged<0, 255>;
+	using int_0_64k = med::asn::ranged<0, 65535>;
+	using int_0_100k = med::asn::ranged<0, 100000>;
+	using int_5_5 = med::asn::ranged<5, 5>;
+
+	//INTEGER (0..7) - bit-field
+	EXPECT_STREQ("A0 ", aper<int_0_7>(5));
+	//INTEGER (-3..4) - offset from lower bound
+	EXPECT_STREQ("00 ", aper<int_m3_4>(-3));
+	EXPECT_STREQ("E0 ", aper<int_m3_4>(4));
+	//INTEGER (0..255) - one-octet
+	EXPECT_STREQ("C8 ", aper<int_0_255>(200));
+	//INTEGER (0..65535) - two-octet
+	EXPECT_STREQ("03 E8 ", aper<int_0_64k>(1000));
+	//INTEGER (0..100000) - indefinite length
+	EXPECT_STREQ("40 03 E8 ", aper<int_0_100k>(1000));
+	//same in UNALIGNED is just 17 bits
+	EXPECT_STREQ("01 F4 00 ", uper<int_0_100k>(1000));
+
+	uint8_t enc_buf[8];
+	med::encoder_context<> ectx{ enc_buf };
+	//INTEGER (5..5) - no bits at all
+	int_5_5 single;
+	single.set(5);
+	encode(med::asn::per::encoder{ectx}, single);
+	EXPECT_EQ(0, ectx.buffer().get_offset());
+
+	int_0_7 ie;
+	ie.set(8);
+	EXPECT_THROW(encode(med::asn::per::encoder{ectx}, ie), med::invalid_value);
+}
+
+//X.691 16 Encoding the bitstring type
+TEST(asn_per, bit_string)
+{
+	uint8_t const bits[] = {0b1010'0000};
+	//BIT STRING
+	EXPECT_STREQ("03 A0 ", aper<med::asn::bit_string>(3, bits));
+	//BIT STRING (SIZE(4))
+	using fixed_bits = med::bit_string<med::min<4>, med::max<4>>;
+	EXPECT_STREQ("A0 ", aper<fixed_bits>(4, bits));
+}
+
+//X.691 17 Encoding the octetstring type
+TEST(asn_per, octet_string)
+{
+	uint8_t const small[] = {1, 2, 3};
+	EXPECT_STREQ("03 01 02 03 ", aper<med::asn::octet_string>(std::size(small), small));
+	EXPECT_STREQ("03 01 02 03 ", uper<med::asn::octet_string>(std::size(small), small));
+
+	std::vector<uint8_t> big(333);
+	for (std::size_t i = 0; i < big.size(); ++i) { big[i] = uint8_t(i); }
+	EXPECT_EQ(0, std::strncmp("81 4D 00 01 02 ", aper<med::asn::octet_string>(big.size(), big.data()), 15));
+}
+
+TEST(asn_per, octet_string_sbo)
+{
+	//octet string kept inline up to 4 octets
+	struct sbo_octets : med::octet_string<med::octets_var_sbo<4>>
+		, med::add_meta_info<med::add_tag<med::asn::traits<med::asn::tg_value::OCTET_STRING>>> {};
+	uint8_t encoded[] = {6, 1, 2, 3, 4, 5, 6};
+	uint8_t mem[64];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> ctx{encoded, sizeof(encoded), &alloc};
+	sbo_octets s;
+	decode(med::asn::per::decoder{ctx, aligned{}}, s);
+	//long value is copied thus survives reuse of the input buffer
+	std::memset(encoded, 0, sizeof(encoded));
+	uint8_t const exp[] = {1, 2, 3, 4, 5, 6};
+	ASSERT_EQ(sizeof(exp), s.size());
+	EXPECT_TRUE(Matches(exp, s.data()));
+}
+
+namespace ap {
+
+template <typename ...T>
+using M = med::mandatory<T...>;
+template <typename ...T>
+using O = med::optional<T...>;
+
+struct moct : med::asn::octet_string_t<med::asn::traits<0, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+struct ooct : med::asn::octet_string_t<med::asn::traits<1, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+struct mint : med::asn::value_t<int, med::asn::traits<2, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+struct oint : med::asn::value_t<int, med::asn::traits<3, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+
+/*
+World-Schema DEFINITIONS AUTOMATIC TAGS ::=
+BEGIN
+	Seq ::= SEQUENCE
+	{
+		moct	OCTET STRING,
+		ooct	OCTET STRING OPTIONAL,
+		mint	INTEGER,
+		oint	INTEGER OPTIONAL
+	}
+END
+*/
+struct Seq : med::asn::sequence<
+	M<moct>,
+	O<ooct>,
+	M<mint>,
+	O<oint>
+>
+{};
+
+/*
+World-Schema DEFINITIONS AUTOMATIC TAGS ::=
+BEGIN
+	Choice ::= CHOICE
+	{
+		one OCTET STRING,
+		two INTEGER
+	}
+END
+*/
+struct one : med::asn::octet_string_t<med::asn::traits<0, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+struct two : med::asn::value_t<int, med::asn::traits<1, med::asn::tg_class::CONTEXT_SPECIFIC>> {};
+
+struct Choice : med::asn::choice<
+	O<one>,
+	O<two>
+>
+{};
+
+//alternative stored out of line
+struct Compact : med::asn::choice<
+	O<two>,
+	med::out_of_line< O<one> >
+>
+{};
+
+} //end: namespace ap
+
+//X.691 19 Encoding the sequence type
+TEST(asn_per, sequence)
+{
+	ap::Seq s;
+	{
+		/*
+		value Seq ::= {
+			moct '1234'H,
+			ooct '456789'H,
+			mint 7,
+			oint 987654321
+		}
+		*/
+		uint8_t const moct_val[] = {0x12, 0x34};
+		uint8_t const ooct_val[] = {0x45, 0x67, 0x89};
+		s.ref<ap::moct>().set(sizeof(moct_val), moct_val);
+		s.ref<ap::ooct>().set(sizeof(ooct_val), ooct_val);
+		s.ref<ap::mint>().set(7);
+		s.ref<ap::oint>().set(987654321);
+		EXPECT_STREQ("C0 02 12 34 03 45 67 89 01 07 04 3A DE 68 B1 ", encoded<aligned>(s));
+		EXPECT_STREQ("C0 84 8D 00 D1 59 E2 40 41 C1 0E B7 9A 2C 40 ", encoded<unaligned>(s));
+	}
+
+	s.clear();
+	{
+		/*
+		value Seq ::= {
+			moct '1234'H,
+			mint 7
+		}
+		*/
+		uint8_t const moct_val[] = {0x12, 0x34};
+		s.ref<ap::moct>().set(sizeof(moct_val), moct_val);
+		s.ref<ap::mint>().set(7);
+		EXPECT_STREQ("00 02 12 34 01 07 ", encoded<aligned>(s));
+		EXPECT_STREQ("00 84 8D 00 41 C0 ", encoded<unaligned>(s));
+	}
+
+	s.clear();
+	uint8_t enc_buf[32];
+	med::encoder_context<> ectx{ enc_buf };
+	EXPECT_THROW(encode(med::asn::per::encoder{ectx}, s), med::missing_ie);
+}
+
+//X.691 20 Encoding the sequence-of type
+TEST(asn_per, sequence_of)
+{
+	/*
+	World-Schema DEFINITIONS AUTOMATIC TAGS ::=
+	BEGIN
+		Seqof ::= SEQUENCE (SIZE(1..5)) OF INTEGER (0..15)
+	END
+	*/
+	using seqof = med::asn::sequence_of<med::asn::ranged<0, 15>, med::max<5>>;
+
+	//value Seqof ::= {1,2,3,4,5}
+	seqof s;
+	s.push_back()->set(1);
+	s.push_back()->set(2);
+	s.push_back()->set(3);
+	s.push_back()->set(4);
+	s.push_back()->set(5);
+	EXPECT_STREQ("82 46 8A ", encoded<aligned>(s));
+	EXPECT_STREQ("82 46 8A ", encoded<unaligned>(s));
+}
+
+//X.691 23 Encoding the choice type
+TEST(asn_per, choice)
+{
+	ap::Choice s;
+	//value Choice ::= one '1234'H
+	uint8_t const oct_val[] = {0x12, 0x34};
+	s.ref<ap::one>().set(sizeof(oct_val), oct_val);
+	EXPECT_STREQ("00 02 12 34 ", encoded<aligned>(s));
+	EXPECT_STREQ("01 09 1A 00 ", encoded<unaligned>(s));
+
+	s.clear();
+	//value Choice ::= two 7
+	s.ref<ap::two>().set(7);
+	EXPECT_STREQ("80 01 07 ", encoded<aligned>(s));
+	EXPECT_STREQ("80 83 80 ", encoded<unaligned>(s));
+}
+
+TEST(asn_per, decode_truncated)
+{
+	uint8_t const truncated[] = {0xC0, 0x02, 0x12, 0x34, 0x03, 0x45};
+	med::decoder_context<> ctx{ truncated };
+	ap::Seq s;
+	EXPECT_THROW(decode(med::asn::per::decoder{ctx}, s), med::overflow);
+}
+
+TEST(asn_per, choice_out_of_line)
+{
+	uint8_t mem[256];
+	med::allocator alloc{mem};
+	ap::Compact s;
+	uint8_t const oct_val[] = {0x12, 0x34};
+	s.ref<ap::one>(alloc).set(sizeof(oct_val), oct_val);
+
+	uint8_t enc_buf[32];
+	med::encoder_context<> ectx{ enc_buf };
+	encode(med::asn::per::encoder{ectx, aligned{}}, s);
+
+	ap::Compact d;
+	//no allocator to place it
+	med::decoder_context<> nctx{ectx.buffer().get_start(), ectx.buffer().get_offset()};
+	EXPECT_THROW(decode(med::asn::per::decoder{nctx, aligned{}}, d), med::out_of_memory);
+
+	d.clear();
+	med::decoder_context<med::allocator> dctx{ectx.buffer().get_start(), ectx.buffer().get_offset(), &alloc};
+	decode(med::asn::per::decoder{dctx, aligned{}}, d);
+	EXPECT_EQ(ectx.buffer().get_offset(), dctx.buffer().get_offset());
+	auto const* one = d.get<ap::one>();
+	ASSERT_NE(nullptr, one);
+	EXPECT_TRUE(Matches(oct_val, one->data()));
+}
@@ -1,5 +1,7 @@
 #include "ut.hpp"
 #include "bit_string.hpp"
+#include "bit_encoder.hpp"
+#include "bit_decoder.hpp"
 
 
 constexpr std::size_t MIXED = 0b1110'1110'0111'0111'0011'0011'0101'0101;
@@ -95,3 +97,127 @@ TEST(bits, bit_string)
 	}
 }
 
+
+namespace bc {
+
+template <std::size_t N>
+struct F : med::value<med::bits<N>> {};
+
+struct SEQ : med::sequence<
+	med::mandatory< F<3> >,
+	med::mandatory< F<12> >,
+	med::mandatory< F<1> >,
+	med::mandatory< med::value<uint8_t> >,
+	med::mandatory< F<36> >
+>{};
+
+} //end: namespace bc
+
+TEST(bits, cursor)
+{
+	uint8_t buf[32] = {};
+	med::buffer<uint8_t> wbuf;
+	wbuf.reset(buf);
+	med::bit_writer writer{wbuf};
+
+	//widths crossing octet and accumulator boundaries
+	constexpr std::size_t widths[] = {1, 3, 7, 12, 64, 5, 33, 57, 8, 3};
+	std::size_t total = 0;
+	for (auto n : widths)
+	{
+		writer.put<void>(MIXED * (n + 1), n);
+		total += n;
+		EXPECT_EQ(total, writer.bit_offset());
+	}
+	EXPECT_FALSE(writer.is_aligned());
+	//buffer space is reserved for all bits written
+	EXPECT_EQ(med::bits_to_bytes(total), wbuf.get_offset());
+	writer.align();
+	EXPECT_TRUE(writer.is_aligned());
+	EXPECT_EQ(8 * wbuf.get_offset(), writer.bit_offset());
+
+	med::buffer<uint8_t const> rbuf;
+	rbuf.reset(buf, wbuf.get_offset());
+	med::bit_reader reader{rbuf};
+	total = 0;
+	for (auto n : widths)
+	{
+		EXPECT_EQ(MIXED * (n + 1) & med::detail::lsb_mask(n), reader.get<void>(n));
+		total += n;
+		EXPECT_EQ(total, reader.bit_offset());
+		//buffer cursor follows the octet the last bit was read from
+		EXPECT_EQ(med::bits_to_bytes(total), rbuf.get_offset());
+	}
+	reader.align();
+	EXPECT_TRUE(rbuf.empty());
+	EXPECT_THROW(reader.get<void>(1), med::overflow);
+}
+
+TEST(bits, cursor_align)
+{
+	uint8_t buf[16] = {};
+	med::buffer<uint8_t> wbuf;
+	wbuf.reset(buf, 3);
+	med::bit_writer writer{wbuf};
+	writer.put<void>(0b101, 3);
+	writer.align();
+	//octet aligned access of buffer
+	wbuf.push<void>(0x5A);
+	writer.put<void>(0b11, 2);
+	writer.flush();
+	EXPECT_EQ(3, wbuf.get_offset());
+	EXPECT_STREQ("A0 5A C0 ", as_string(wbuf));
+
+	writer.put<void>(0x1F, 6);
+	EXPECT_THROW(writer.put<void>(0xFF, 8), med::overflow);
+
+	med::buffer<uint8_t const> rbuf;
+	rbuf.reset(buf, 3);
+	med::bit_reader reader{rbuf};
+	EXPECT_EQ(0b1, reader.get<void>(1));
+	reader.align();
+	EXPECT_EQ(8, reader.bit_offset());
+	EXPECT_EQ(0x5A, rbuf.pop<void>());
+	EXPECT_EQ(0xC0, reader.get<void>(8));
+}
+
+TEST(bits, codec)
+{
+	bc::SEQ msg;
+	msg.ref<bc::F<3>>().set(5);
+	msg.ref<bc::F<12>>().set(0xABC);
+	msg.ref<bc::F<1>>().set(1);
+	msg.ref<med::value<uint8_t>>().set(0x7E);
+	msg.ref<bc::F<36>>().set(0x9'8765'4321);
+
+	uint8_t buf[16] = {};
+	med::encoder_context<> ctx{ buf };
+	encode(med::bit_encoder{ctx}, msg);
+	//101 1010'1011'1100 1 0111'1110 1001'...'0001 (0000)
+	EXPECT_STREQ("B5 79 7E 98 76 54 32 10 ", as_string(ctx.buffer()));
+
+	bc::SEQ dmsg;
+	med::decoder_context<> dctx{ ctx.buffer().get_start(), ctx.buffer().get_offset() };
+	decode(med::bit_decoder{dctx}, dmsg);
+	EXPECT_EQ(5, dmsg.get<bc::F<3>>().get());
+	EXPECT_EQ(0xABC, dmsg.get<bc::F<12>>().get());
+	EXPECT_EQ(1, dmsg.get<bc::F<1>>().get());
+	EXPECT_EQ(0x7E, dmsg.get<med::value<uint8_t>>().get());
+	EXPECT_EQ(0x9'8765'4321, dmsg.get<bc::F<36>>().get());
+}
+
+TEST(bits, octet_string_sbo)
+{
+	using sbo_octets = med::octet_string<med::octets_var_sbo<4>>;
+	uint8_t encoded[] = {1, 2, 3, 4, 5, 6};
+	uint8_t mem[64];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> ctx{encoded, sizeof(encoded), &alloc};
+	sbo_octets s;
+	decode(med::bit_decoder{ctx}, s);
+	//long value is copied thus survives reuse of the input buffer
+	std::memset(encoded, 0, sizeof(encoded));
+	uint8_t const exp[] = {1, 2, 3, 4, 5, 6};
+	ASSERT_EQ(sizeof(exp), s.size());
+	EXPECT_TRUE(Matches(exp, s.data()));
+}
@@ -0,0 +1,221 @@
+#include "ut.hpp"
+
+#include "cbor/encoder.hpp"
+#include "cbor/decoder.hpp"
+
+namespace {
+
+template <class IE>
+char const* encoded(IE const& enc)
+{
+	uint8_t enc_buf[1024] = {};
+	med::encoder_context<> ectx{ enc_buf };
+	encode(med::cbor::encoder{ectx}, enc);
+
+	med::decoder_context<> dctx{ectx.buffer().get_start(), ectx.buffer().get_offset()};
+	IE dec;
+	decode(med::cbor::decoder{dctx}, dec);
+	EXPECT_EQ(ectx.buffer().get_offset(), dctx.buffer().get_offset());
+
+	//re-encoding of decoded is to match the original
+	uint8_t dec_buf[1024] = {};
+	med::encoder_context<> rctx{ dec_buf };
+	encode(med::cbor::encoder{rctx}, dec);
+	EXPECT_EQ(ectx.buffer().get_offset(), rctx.buffer().get_offset());
+	EXPECT_EQ(0, std::memcmp(enc_buf, dec_buf, ectx.buffer().get_offset()));
+
+	return as_string(ectx.buffer());
+}
+
+template <class IE, class... ARGS>
+char const* encoded(ARGS&&... args)
+{
+	IE ie;
+	ie.set(std::forward<ARGS>(args)...);
+	return encoded(ie);
+}
+
+template <class IE, std::size_t N>
+void decoded(IE& ie, uint8_t const (&cbor)[N])
+{
+	med::decoder_context<> dctx{ cbor };
+	decode(med::cbor::decoder{dctx}, ie);
+	EXPECT_EQ(N, dctx.buffer().get_offset());
+}
+
+} //end: namespace
+
+namespace cb {
+
+template <uint8_t TAG>
+using T = med::value<med::fixed<TAG, uint8_t>>;
+
+struct A : med::value<uint8_t> { static constexpr char const* name() { return "a"; } };
+struct B : med::value<uint8_t> { static constexpr char const* name() { return "b"; } };
+
+//{"a": 1, "b": [2, 3]}
+struct NAMED : med::sequence<
+	M< A >,
+	M< B, med::max<3> >
+>{};
+
+struct U8 : med::value<uint8_t> {};
+struct I32 : med::value<int32_t> {};
+struct STR : med::octet_string<med::octets_var_extern, med::max<16>> {};
+struct FLAG : med::value<bool> {};
+
+struct INNER : med::sequence<
+	M< T<1>, U8 >,
+	O< T<2>, STR >
+>{};
+
+struct MSG : med::set<
+	M< T<1>, I32 >,
+	O< T<2>, STR >,
+	O< T<3>, INNER, med::max<2> >,
+	O< T<4>, FLAG >
+>{};
+
+struct CHOICE : med::choice<
+	M< T<1>, U8 >,
+	M< T<2>, STR >
+>{};
+
+struct BIG : med::octet_string<med::octets_var_intern<256>> {};
+
+//large alternative stored out of line
+struct COMPACT : med::choice<
+	M< T<1>, U8 >,
+	med::out_of_line< M< T<2>, BIG > >
+>{};
+
+} //end: namespace cb
+
+//RFC 8949 Appendix A examples
+TEST(cbor, integer)
+{
+	EXPECT_STREQ("00 ", encoded<med::value<uint8_t>>(0));
+	EXPECT_STREQ("17 ", encoded<med::value<uint8_t>>(23));
+	EXPECT_STREQ("18 18 ", encoded<med::value<uint8_t>>(24));
+	EXPECT_STREQ("18 64 ", encoded<med::value<uint16_t>>(100));
+	EXPECT_STREQ("19 03 E8 ", encoded<med::value<uint16_t>>(1000));
+	EXPECT_STREQ("1A 00 0F 42 40 ", encoded<med::value<uint32_t>>(1000000));
+	EXPECT_STREQ("1B 00 00 00 E8 D4 A5 10 00 ", encoded<med::value<uint64_t>>(1000000000000));
+	EXPECT_STREQ("20 ", encoded<med::value<int8_t>>(-1));
+	EXPECT_STREQ("29 ", encoded<med::value<int8_t>>(-10));
+	EXPECT_STREQ("38 63 ", encoded<med::value<int8_t>>(-100));
+	EXPECT_STREQ("39 03 E7 ", encoded<med::value<int16_t>>(-1000));
+	EXPECT_STREQ("3B 7F FF FF FF FF FF FF FF ", encoded<med::value<int64_t>>(std::numeric_limits<int64_t>::min()));
+
+	med::value<uint8_t> u8;
+	//out of range of value type
+	uint8_t const big[] = {0x19, 0x01, 0x00};
+	EXPECT_THROW(decoded(u8, big), med::invalid_value);
+	uint8_t const neg[] = {0x20};
+	EXPECT_THROW(decoded(u8, neg), med::invalid_value);
+	//reserved additional information
+	uint8_t const reserved[] = {0x1C};
+	EXPECT_THROW(decoded(u8, reserved), med::invalid_value);
+}
+
+TEST(cbor, simple)
+{
+	EXPECT_STREQ("F4 ", encoded<med::value<bool>>(false));
+	EXPECT_STREQ("F5 ", encoded<med::value<bool>>(true));
+	EXPECT_STREQ("FB 3F F8 00 00 00 00 00 00 ", encoded<med::value<double>>(1.5));
+	EXPECT_STREQ("FA 47 C3 50 00 ", encoded<med::value<float>>(100000.0f));
+}
+
+TEST(cbor, bytes)
+{
+	uint8_t const data[] = {1, 2, 3, 4};
+	EXPECT_STREQ("44 01 02 03 04 ", encoded<cb::STR>(sizeof(data), data));
+
+	//zero-copy decode of byte and text strings
+	uint8_t const bytes[] = {0x44, 1, 2, 3, 4};
+	cb::STR str;
+	decoded(str, bytes);
+	EXPECT_EQ(bytes + 1, str.data());
+	uint8_t const text[] = {0x64, 0x49, 0x45, 0x54, 0x46};
+	decoded(str, text);
+	EXPECT_EQ(text + 1, str.data());
+	EXPECT_EQ(4, str.size());
+
+	uint8_t const truncated[] = {0x45, 1, 2, 3, 4};
+	EXPECT_THROW(decoded(str, truncated), med::overflow);
+}
+
+TEST(cbor, named)
+{
+	cb::NAMED msg;
+	msg.ref<cb::A>().set(1);
+	msg.ref<cb::B>().push_back()->set(2);
+	msg.ref<cb::B>().push_back()->set(3);
+	EXPECT_STREQ("A2 61 61 01 61 62 82 02 03 ", encoded(msg));
+}
+
+TEST(cbor, map)
+{
+	uint8_t const data[] = {'a', 'b', 'c'};
+	cb::MSG msg;
+	msg.ref<cb::I32>().set(-2);
+	msg.ref<cb::STR>().set(sizeof(data), data);
+	auto* inner = msg.ref<cb::INNER>().push_back();
+	inner->ref<cb::U8>().set(7);
+	inner = msg.ref<cb::INNER>().push_back();
+	inner->ref<cb::U8>().set(8);
+	inner->ref<cb::STR>().set(1, data);
+	EXPECT_STREQ("A3 01 21 02 43 61 62 63 03 82 A1 01 07 A2 01 08 02 41 61 ", encoded(msg));
+
+	//any order of entries and unknown ones are skipped
+	uint8_t const shuffled[] = {0xA4
+		, 0x04, 0xF5
+		, 0x18, 0x63, 0x82, 0xA1, 0x61, 0x78, 0x80, 0xC1, 0x00 //99: [{"x": []}, 1(0)]
+		, 0x01, 0x20
+		, 0x02, 0x41, 0x7A
+	};
+	cb::MSG dmsg;
+	decoded(dmsg, shuffled);
+	EXPECT_EQ(-1, dmsg.get<cb::I32>().get());
+	ASSERT_NE(nullptr, dmsg.get<cb::FLAG>());
+	EXPECT_TRUE(dmsg.get<cb::FLAG>()->get());
+	ASSERT_NE(nullptr, dmsg.get<cb::STR>());
+	EXPECT_EQ(shuffled + 16, dmsg.get<cb::STR>()->data());
+	EXPECT_TRUE(dmsg.get<cb::INNER>().empty());
+
+	//mandatory is missing
+	uint8_t const missing[] = {0xA1, 0x04, 0xF5};
+	dmsg.clear();
+	EXPECT_THROW(decoded(dmsg, missing), med::missing_ie);
+	//not a map
+	uint8_t const array[] = {0x81, 0x01};
+	EXPECT_THROW(decoded(dmsg, array), med::invalid_value);
+}
+
+TEST(cbor, choice)
+{
+	cb::CHOICE msg;
+	msg.ref<cb::U8>().set(5);
+	EXPECT_STREQ("A1 01 05 ", encoded(msg));
+
+	uint8_t const unknown[] = {0xA1, 0x03, 0x05};
+	EXPECT_THROW(decoded(msg, unknown), med::unknown_tag);
+}
+
+TEST(cbor, choice_out_of_line)
+{
+	uint8_t const cbor[] = {0xA1, 0x02, 0x43, 'b', 'i', 'g'};
+	cb::COMPACT msg;
+	//no allocator to place it
+	EXPECT_THROW(decoded(msg, cbor), med::out_of_memory);
+
+	uint8_t mem[1024];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> dctx{cbor, sizeof(cbor), &alloc};
+	msg.clear();
+	decode(med::cbor::decoder{dctx}, msg);
+	EXPECT_EQ(sizeof(cbor), dctx.buffer().get_offset());
+	auto const* big = msg.get<cb::BIG>();
+	ASSERT_NE(nullptr, big);
+	EXPECT_TRUE(Matches("big", big->data(), big->size()));
+}
@@ -124,6 +124,15 @@ struct plain : med::choice<
 
 using PLAIN = M<L, plain>;
 
+struct BIG : med::octet_string<med::octets_var_intern<1024>>{};
+
+//large alternative stored out of line
+struct compact : med::choice<
+	M< C<0x00>, L, U8 >,
+	med::out_of_line< M< C<0x01>, L, BIG > >
+>
+{};
+
 } //end: namespace cho
 
 using namespace std::string_view_literals;
@@ -214,4 +223,44 @@ TEST(choice, nibble_tag)
 	EXPECT_FALSE(pf->is_set());
 }
 #endif
+TEST(choice, out_of_line)
+{
+	EXPECT_GE(2 * sizeof(void*), sizeof(compact));
+
+	compact msg;
+	//no allocator to place it
+	med::null_allocator none;
+	EXPECT_THROW(msg.ref<BIG>(none), med::out_of_memory);
+
+	uint8_t mem[4096];
+	med::allocator alloc{mem};
+	msg.ref<BIG>(alloc).set("big"sv);
+	//already selected
+	EXPECT_EQ(3, msg.ref<BIG>(none).size());
+
+	uint8_t buffer[32];
+	med::encoder_context<> ctx{ buffer };
+	encode(med::octet_encoder{ctx}, msg);
+	EXPECT_STRCASEEQ("01 03 62 69 67 ", as_string(ctx.buffer()));
+
+	compact dmsg;
+	med::decoder_context<med::allocator> dctx{ctx.buffer().get_start(), ctx.buffer().get_offset(), &alloc};
+	decode(med::octet_decoder{dctx}, dmsg);
+	ASSERT_NE(nullptr, dmsg.get<BIG>());
+	EXPECT_TRUE(msg == dmsg);
+
+	//inline alternative w/o allocator
+	uint8_t const small[] = {0, 1, 7};
+	med::decoder_context<> sctx{ small };
+	decode(med::octet_decoder{sctx}, dmsg);
+	ASSERT_NE(nullptr, dmsg.get<U8>());
+	EXPECT_EQ(7, dmsg.get<U8>()->get());
+	EXPECT_EQ(nullptr, dmsg.get<BIG>());
+
+	compact copy;
+	EXPECT_THROW(copy.copy(msg, none), med::out_of_memory);
+	copy.copy(msg, alloc);
+	EXPECT_TRUE(msg == copy);
+}
+
 //NOTE: choice compound is tested in length.cpp ppp::proto
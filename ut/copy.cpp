@@ -1,4 +1,5 @@
 #include "ut.hpp"
+#include "deep_copy.hpp"
 
 namespace cp {
 
@@ -52,6 +53,16 @@ struct seq_r : med::sequence<
 	M< med::counter_t<byte>, word, med::min<2>, med::inf >
 >{};
 
+struct text : med::octet_string<med::octets_var_reloc, med::max<32>> {};
+struct big : med::sequence<
+	M< T<1>, L, text >,
+	M< T<2>, word, med::max<4> >
+>{};
+struct ool : med::choice<
+	M<C<1>, byte>,
+	med::out_of_line< M<C<2>, big> >
+>{};
+
 } //end: namespace cp
 
 TEST(copy, seq_same)
@@ -177,3 +188,112 @@ TEST(copy, choice_hdr)
 	ASSERT_NE(nullptr, pv);
 	//EXPECT_EQ(0xABBA, pw->get());
 }
+
+TEST(copy, move_seq)
+{
+	uint8_t const encoded[] = {
+		0xF1, 0x13, 0xF1, 0x37, 0xF1, 0x7F, //3 TVs => 1 node from allocator
+		0xF2, 2, 0xFE, 0xE1,
+		0xF2, 2, 0xAB, 0xBA,
+		1, 0xDE, 0xAD, 0xBE, 0xEF,
+	};
+
+	uint8_t dec_buf[128];
+	med::allocator alloc{dec_buf};
+	med::decoder_context<med::allocator> ctx{ encoded, &alloc };
+	cp::seq src;
+	decode(med::octet_decoder{ctx}, src);
+	auto const* external = &*std::next(src.get<cp::byte>().begin(), 2);
+
+	cp::seq dst{std::move(src)};
+	EXPECT_FALSE(src.is_set());
+	EXPECT_EQ(0, src.count<cp::byte>());
+	ASSERT_EQ(3, dst.count<cp::byte>());
+	//external node is stolen while inplace ones are moved
+	EXPECT_EQ(external, &*std::next(dst.get<cp::byte>().begin(), 2));
+	EXPECT_EQ(0x13, dst.get<cp::byte>().begin()->get());
+
+	cp::seq other;
+	other = std::move(dst);
+	EXPECT_FALSE(dst.is_set());
+
+	uint8_t buffer[128];
+	med::encoder_context<> ectx{ buffer };
+	encode(med::octet_encoder{ectx}, other);
+	EXPECT_EQ(sizeof(encoded), ectx.buffer().get_offset());
+	EXPECT_TRUE(Matches(encoded, buffer));
+}
+
+TEST(copy, move_choice)
+{
+	uint8_t const encoded[] = { 2, 1, 3, 'a','b','c', 2, 0x12, 0x34 };
+
+	uint8_t dec_buf[256];
+	med::allocator alloc{dec_buf};
+	med::decoder_context<med::allocator> ctx{ encoded, &alloc };
+	cp::ool src;
+	decode(med::octet_decoder{ctx}, src);
+	auto const* alt = src.get<cp::big>();
+	ASSERT_NE(nullptr, alt);
+
+	cp::ool dst{std::move(src)};
+	EXPECT_FALSE(src.is_set());
+	EXPECT_EQ(alt, dst.get<cp::big>());
+
+	//out of line case isn't shared by copy but only moved
+	static_assert(!std::is_copy_constructible_v<cp::ool>);
+	static_assert(!std::is_copy_assignable_v<cp::ool>);
+	cp::ool other;
+	other.ref<cp::byte>().set(1);
+	other = std::move(dst);
+	EXPECT_FALSE(dst.is_set());
+	EXPECT_EQ(alt, other.get<cp::big>());
+
+	//deep copy doesn't alias the source
+	uint8_t copy_buf[256];
+	med::allocator copy_alloc{copy_buf};
+	cp::ool copied;
+	copied.copy(other, copy_alloc);
+	auto* copied_alt = copied.get<cp::big>();
+	ASSERT_NE(nullptr, copied_alt);
+	EXPECT_NE(alt, copied_alt);
+	EXPECT_TRUE(copied == other);
+	copied.ref<cp::big>(copy_alloc).ref<cp::word>().begin()->set(0x5678);
+	EXPECT_EQ(0x1234, other.get<cp::big>()->get<cp::word>().begin()->get());
+}
+
+TEST(copy, deep_copy)
+{
+	uint8_t const encoded[] = {
+		2, //out of line
+		1, 5, 'h','e','l','l','o',
+		2, 0x00, 0x01,
+		2, 0x00, 0x02,
+		2, 0x00, 0x03,
+	};
+
+	uint8_t dec_buf[256];
+	med::allocator src_alloc{dec_buf};
+	med::decoder_context<med::allocator> ctx{ encoded, &src_alloc };
+	cp::ool src;
+	decode(med::octet_decoder{ctx}, src);
+
+	uint8_t copy_buf[256];
+	med::allocator dst_alloc{copy_buf};
+	counting_allocator alloc{dst_alloc};
+	cp::ool dst;
+	med::deep_copy(dst, src, alloc);
+	EXPECT_EQ(1, alloc.calls);
+	EXPECT_TRUE(dst == src);
+
+	auto const* alt = dst.get<cp::big>();
+	ASSERT_NE(nullptr, alt);
+	EXPECT_NE(src.get<cp::big>(), alt);
+	auto const* txt = alt->get<cp::text>().data();
+	EXPECT_TRUE(txt >= copy_buf && txt < copy_buf + sizeof(copy_buf));
+
+	//fails when doesn't fit
+	uint8_t small_buf[16];
+	med::allocator small{small_buf};
+	EXPECT_THROW(med::deep_copy(dst, src, small), med::out_of_memory);
+}
@@ -1,4 +1,8 @@
+#include <vector>
+
 #include "ut.hpp"
+#include "tlv_index.hpp"
+#include "decode_only.hpp"
 
 namespace diameter {
 
@@ -289,6 +293,40 @@ struct ANY : med::set<
 	static constexpr auto name() { return "Diameter-Message"; }
 };
 
+struct app_vendor : med::value<uint32_t>
+{
+	static constexpr char const* name() { return "Vendor-Id"; }
+};
+
+struct auth_app : med::value<uint32_t>
+{
+	static constexpr char const* name() { return "Auth-Application-Id"; }
+};
+
+//structured AVP
+//NOTE: grouped AVPs of explicit length aren't supported
+struct vendor_app_ids : med::sequence<
+	M< app_vendor >,
+	M< auth_app >
+>{};
+
+struct vendor_app : avp<vendor_app_ids, 260, avp_flags::M>
+{
+	static constexpr char const* name() { return "Vendor-Specific-Application-Id"; }
+};
+
+//subset of CEA AVPs
+struct CEA : med::set<
+	M< result_code >,
+	M< origin_host >,
+	O< vendor_app >,
+	O< any_avp, med::inf >
+>
+{
+	static constexpr std::size_t code = 257;
+	static constexpr char const* name() { return "Capabilities-Exchange-Answer"; }
+};
+
 template <class MSG>
 using request = M<med::value<med::fixed<REQUEST | MSG::code, uint32_t>>, MSG>;
 template <class MSG>
@@ -311,6 +349,7 @@ struct msg_len : med::value<med::bytes<3>>
 struct base : med::choice< header
 	, request<DPR>
 	, answer<DPA>
+	, answer<CEA>
 	, M<cmd_code, ANY>
 >,
 	med::add_meta_info<
@@ -590,3 +629,226 @@ TEST(diameter, any_msg)
 	EXPECT_EQ(sizeof(dwa), ectx.buffer().get_offset());
 	ASSERT_TRUE(Matches(dwa, buffer));
 }
+
+namespace diameter {
+
+//index w/ arbitrary entries to check malformed ones
+template <class HEADER, std::size_t N>
+struct raw_index
+{
+	using header_type = HEADER;
+	std::array<med::tlv_entry, N> entries;
+	std::size_t scanned_size() const { return sizeof(dpr) - 20; }
+	auto begin() const               { return entries.begin(); }
+	auto end() const                 { return entries.end(); }
+	bool complete() const            { return false; }
+};
+
+} //end: namespace diameter
+
+TEST(diameter, tlv_index)
+{
+	using avp_header = med::tlv_header<4, 3, med::padding<uint32_t>, 5, 8, true>;
+	std::span<uint8_t const> const avps{diameter::dpr + 20, sizeof(diameter::dpr) - 20};
+
+	med::tlv_index<avp_header, 8> index;
+	ASSERT_EQ(3, index.scan(avps));
+	EXPECT_EQ(264, index[0].tag);
+	EXPECT_EQ(0, index[0].offset);
+	EXPECT_EQ(17, index[0].length);
+	EXPECT_EQ(296, index[1].tag);
+	EXPECT_EQ(20, index[1].offset);
+	EXPECT_EQ(22, index[1].length);
+	ASSERT_NE(nullptr, index.find(273));
+	EXPECT_EQ(44, index.find(273)->offset);
+	EXPECT_EQ(nullptr, index.find(268));
+	EXPECT_TRUE(index.complete());
+
+	med::decoder_context<> ctx{ avps };
+	diameter::DPR dpr;
+	dpr.decode_indexed(med::octet_decoder{ctx}, index);
+	auto const* msg = &dpr;
+	EQ_STRING_M(diameter::origin_host, "Orig.Host");
+	EQ_STRING_M(diameter::origin_realm, "orig.realm.net");
+	EXPECT_EQ(2, msg->get<diameter::disconnect_cause>().body().get());
+
+	//decode only AVPs of interest
+	index.remove_if([](auto const& tlv) { return tlv.tag != 296; });
+	ASSERT_EQ(1, index.size());
+	EXPECT_FALSE(index.complete());
+	ctx.reset(avps.data(), avps.size());
+	diameter::ANY any;
+	any.decode_indexed(med::octet_decoder{ctx}, index);
+	EXPECT_EQ(nullptr, any.get<diameter::origin_host>());
+	ASSERT_NE(nullptr, any.get<diameter::origin_realm>());
+	EXPECT_EQ(0, any.count<diameter::any_avp>());
+
+	using bad_index = diameter::raw_index<avp_header, 2>;
+	//TLV behind the decoded one
+	bad_index const behind{{{ {296, 20, 22}, {264, 0, 17} }}};
+	ctx.reset(avps.data(), avps.size());
+	any.clear();
+	EXPECT_THROW(any.decode_indexed(med::octet_decoder{ctx}, behind), med::invalid_value);
+	//IE is not decoded beyond its TLV
+	bad_index const shorter{{{ {264, 0, 12}, {296, 20, 22} }}};
+	ctx.reset(avps.data(), avps.size());
+	any.clear();
+	EXPECT_THROW(any.decode_indexed(med::octet_decoder{ctx}, shorter), med::overflow);
+
+	//length beyond the buffer
+	EXPECT_THROW(index.scan(avps.first(40)), med::overflow);
+	//length less than header
+	uint8_t const bad_len[] = {0, 0, 1, 0x11, 0x40, 0, 0, 4};
+	EXPECT_THROW(index.scan(bad_len), med::invalid_value);
+}
+
+TEST(diameter, decode_only)
+{
+	med::decoder_context<> ctx{ diameter::dpr };
+	diameter::base base;
+	med::decode_only<diameter::origin_host>(med::octet_decoder{ctx}, base);
+	EXPECT_EQ(sizeof(diameter::dpr), ctx.buffer().get_offset());
+
+	ASSERT_EQ(0x22222222, base.header().hop_id());
+	auto const* msg = base.get<diameter::DPR>();
+	ASSERT_NE(nullptr, msg);
+	EQ_STRING_M(diameter::origin_host, "Orig.Host");
+	//skipped thus not set despite mandatory
+	EXPECT_FALSE(msg->get<diameter::origin_realm>().is_set());
+	EXPECT_FALSE(msg->get<diameter::disconnect_cause>().is_set());
+
+	ctx.reset();
+	base.clear();
+	med::decode_only<diameter::origin_realm, diameter::disconnect_cause>(med::octet_decoder{ctx}, base);
+	msg = base.get<diameter::DPR>();
+	ASSERT_NE(nullptr, msg);
+	EXPECT_FALSE(msg->get<diameter::origin_host>().is_set());
+	EQ_STRING_M(diameter::origin_realm, "orig.realm.net");
+	EXPECT_EQ(2, msg->get<diameter::disconnect_cause>().body().get());
+}
+
+namespace diameter {
+
+uint8_t const cea[] = {
+	0x01, 0x00, 0x00, 23*4, //VER(1), LEN(3)
+	0x00, 0x00, 0x01, 0x01, //R.P.E.T(1), CMD(3) = 257
+	0x00, 0x00, 0x00, 0x00, //APP-ID
+	0x22, 0x22, 0x22, 0x22, //H2H-ID
+	0x55, 0x55, 0x55, 0x55, //E2E-ID
+
+	0x00, 0x00, 0x01, 0x0C, //AVP = 268 Result Code
+	0x40, 0x00, 0x00, 0x0C, //V.M.P(1), LEN(3) = 12
+	0x00, 0x00, 0x07, 0xD1, //result = 2001
+
+	0x00, 0x00, 0x01, 0x04, //AVP = 260 Vendor-Specific-Application-Id (structured)
+	0x40, 0x00, 0x00, 0x10, //V.M.P(1), LEN(3) = 16
+	0x00, 0x00, 0x28, 0xAF, //vendor = 10415
+	0x01, 0x00, 0x00, 0x23, //id = S6a
+
+	0x00, 0x00, 0x01, 0x0B, //AVP = 267 Firmware-Revision (any)
+	0x00, 0x00, 0x00, 0x0C, //V.M.P(0), LEN(3) = 12
+	0x00, 0x00, 0x00, 0x01,
+
+	0x00, 0x00, 0x01, 0x0A, //AVP = 266 Vendor-Id (any)
+	0x40, 0x00, 0x00, 0x0C, //V.M.P(1), LEN(3) = 12
+	0x00, 0x00, 0x28, 0xAF,
+
+	0x00, 0x00, 0x01, 0x08, //AVP = 264 OrigHost
+	0x40, 0x00, 0x00, 0x14, //V.M.P(1), LEN(3) = 20
+	'h', 'o', 's', 't',
+	'.', 'e', 'x', 'a',
+	'm', 'p', 'l', 'e',
+};
+
+//records buffer offset after each skip
+template <class CTX>
+struct skip_tracer : med::octet_decoder<CTX>
+{
+	using base_t = med::octet_decoder<CTX>;
+	using base_t::operator();
+
+	skip_tracer(CTX& ctx, std::vector<std::size_t>& offsets) : base_t{ctx}, m_offsets{&offsets} { }
+
+	void operator() (med::ADVANCE_STATE ss)
+	{
+		base_t::operator()(ss);
+		m_offsets->push_back(this->get_context().buffer().get_offset());
+	}
+
+	std::vector<std::size_t>* m_offsets;
+};
+
+} //end: namespace diameter
+
+TEST(diameter, decode_only_nested)
+{
+	using offsets = std::vector<std::size_t>;
+	offsets skips;
+	med::decoder_context<> ctx{ diameter::cea };
+	diameter::base base;
+	diameter::CEA const* msg = nullptr;
+
+	//structured AVP is skipped as whole
+	med::decode_only<diameter::origin_host>(diameter::skip_tracer{ctx, skips}, base);
+	EXPECT_EQ(sizeof(diameter::cea), ctx.buffer().get_offset());
+	msg = base.get<diameter::CEA>();
+	ASSERT_NE(nullptr, msg);
+	EXPECT_EQ((offsets{32, 48, 60, 72}), skips);
+	EXPECT_EQ("host.example"sv, as_sv(msg->get<diameter::origin_host>()));
+	EXPECT_FALSE(msg->get<diameter::result_code>().is_set());
+	EXPECT_EQ(nullptr, msg->get<diameter::vendor_app>());
+	EXPECT_EQ(0, msg->count<diameter::any_avp>());
+
+	//nested IE is reached by walking into its AVP
+	skips.clear();
+	ctx.reset();
+	base.clear();
+	med::decode_only<diameter::auth_app>(diameter::skip_tracer{ctx, skips}, base);
+	EXPECT_EQ(sizeof(diameter::cea), ctx.buffer().get_offset());
+	msg = base.get<diameter::CEA>();
+	ASSERT_NE(nullptr, msg);
+	EXPECT_EQ((offsets{32, 60, 72, 92}), skips);
+	auto const* app = msg->get<diameter::vendor_app>();
+	ASSERT_NE(nullptr, app);
+	EXPECT_EQ(0x01000023, app->body().get<diameter::auth_app>().get());
+	EXPECT_FALSE(msg->get<diameter::result_code>().is_set());
+	EXPECT_FALSE(msg->get<diameter::origin_host>().is_set());
+	EXPECT_EQ(0, msg->count<diameter::any_avp>());
+}
+
+TEST(diameter, decode_only_multi)
+{
+	using offsets = std::vector<std::size_t>;
+	offsets skips;
+	uint8_t dec_buf[256];
+	med::allocator alloc{dec_buf};
+	med::decoder_context<med::allocator> ctx{ diameter::cea, &alloc };
+	diameter::base base;
+	diameter::CEA const* msg = nullptr;
+
+	//unselected multi-field is skipped w/o push
+	med::decode_only<diameter::result_code, diameter::origin_host>(diameter::skip_tracer{ctx, skips}, base);
+	EXPECT_EQ(sizeof(diameter::cea), ctx.buffer().get_offset());
+	msg = base.get<diameter::CEA>();
+	ASSERT_NE(nullptr, msg);
+	EXPECT_EQ((offsets{48, 60, 72}), skips);
+	EXPECT_EQ(2001, msg->get<diameter::result_code>().body().get());
+	EXPECT_EQ("host.example"sv, as_sv(msg->get<diameter::origin_host>()));
+	EXPECT_EQ(nullptr, msg->get<diameter::vendor_app>());
+	EXPECT_EQ(0, msg->count<diameter::any_avp>());
+
+	//selected multi-field is decoded in full
+	skips.clear();
+	ctx.reset();
+	base.clear();
+	med::decode_only<diameter::any_avp>(diameter::skip_tracer{ctx, skips}, base);
+	EXPECT_EQ(sizeof(diameter::cea), ctx.buffer().get_offset());
+	msg = base.get<diameter::CEA>();
+	ASSERT_NE(nullptr, msg);
+	EXPECT_EQ((offsets{32, 48, 92}), skips);
+	ASSERT_EQ(2, msg->count<diameter::any_avp>());
+	auto it = msg->get<diameter::any_avp>().begin();
+	EXPECT_EQ(267, it->get<diameter::avp_code>().get());
+	EXPECT_EQ(266, (++it)->get<diameter::avp_code>().get());
+	EXPECT_FALSE(msg->get<diameter::origin_host>().is_set());
+}
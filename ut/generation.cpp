@@ -0,0 +1,126 @@
+#include "ut.hpp"
+#include "generation.hpp"
+
+namespace gn {
+
+struct byte : med::value<uint8_t> {};
+struct word : med::value<uint16_t> {};
+struct item : med::value<uint16_t> {};
+struct text : med::octet_string<med::octets_var_intern<64>> {};
+
+struct seq : med::gen_sequence<
+	M< T<1>, byte >,
+	O< T<2>, word >,
+	O< T<3>, L, text >,
+	O< T<4>, item, med::max<4> >
+>{};
+
+struct plain_seq : med::sequence<
+	M< T<1>, byte >,
+	O< T<2>, word >,
+	O< T<3>, L, text >,
+	O< T<4>, item, med::max<4> >
+>{};
+
+struct set : med::gen_set<
+	M< T<1>, byte >,
+	O< T<2>, word >,
+	O< T<4>, L, text, med::max<4> >
+>{};
+
+} //end: namespace gn
+
+TEST(generation, size)
+{
+	//only a stamp (w/ alignment) per IE, generation is kept by container
+	EXPECT_LE(sizeof(gn::seq), sizeof(gn::plain_seq) + 4 * 2 * sizeof(med::generation_t));
+}
+
+TEST(generation, clear)
+{
+	gn::seq msg;
+	EXPECT_FALSE(msg.is_set());
+	msg.ref<gn::byte>().set(1);
+	msg.ref<gn::word>().set(2);
+	msg.ref<gn::text>().set("abc"sv);
+	msg.ref<gn::item>().push_back()->set(3);
+	EXPECT_TRUE(msg.is_set());
+	EXPECT_EQ(1, msg.count<gn::item>());
+
+	auto const gen = msg.generation();
+	msg.clear();
+	EXPECT_EQ(gen + 1, msg.generation());
+	//stale fields read as unset
+	EXPECT_FALSE(msg.is_set());
+	EXPECT_FALSE(msg.get<gn::byte>().is_set());
+	EXPECT_EQ(nullptr, msg.get<gn::word>());
+	EXPECT_EQ(nullptr, msg.get<gn::text>());
+	EXPECT_EQ(0, msg.count<gn::item>());
+	EXPECT_TRUE(msg.get<gn::item>().empty());
+	EXPECT_EQ(msg.get<gn::item>().end(), msg.get<gn::item>().begin());
+
+	//reset on write access
+	msg.ref<gn::byte>().set(4);
+	EXPECT_EQ(4, msg.get<gn::byte>().get());
+	EXPECT_EQ(nullptr, msg.get<gn::word>());
+	msg.ref<gn::item>().push_back()->set(5);
+	check_seqof<gn::item>(msg, {5});
+}
+
+TEST(generation, decode_sequence)
+{
+	uint8_t const full[] = {1, 0x11, 2, 0x22, 0x22, 3, 2, 'a', 'b', 4, 0, 1, 4, 0, 2};
+	uint8_t const part[] = {1, 0x33, 4, 0, 3};
+
+	gn::seq msg;
+	med::decoder_context<> ctx{ full };
+	decode(med::octet_decoder{ctx}, msg);
+	ASSERT_NE(nullptr, msg.get<gn::text>());
+	check_seqof<gn::item>(msg, {1, 2});
+
+	//decode into the reused object
+	msg.clear();
+	ctx.reset(part, sizeof(part));
+	decode(med::octet_decoder{ctx}, msg);
+	EXPECT_EQ(0x33, msg.get<gn::byte>().get());
+	EXPECT_EQ(nullptr, msg.get<gn::word>());
+	EXPECT_EQ(nullptr, msg.get<gn::text>());
+	check_seqof<gn::item>(msg, {3});
+
+	//re-encoded w/o stale fields
+	uint8_t buffer[32];
+	med::encoder_context<> ectx{ buffer };
+	encode(med::octet_encoder{ectx}, msg);
+	EXPECT_EQ(sizeof(part), ectx.buffer().get_offset());
+	EXPECT_TRUE(Matches(part, buffer));
+
+	//stale mandatory is missing
+	msg.clear();
+	ectx.reset();
+	EXPECT_THROW(encode(med::octet_encoder{ectx}, msg), med::missing_ie);
+}
+
+TEST(generation, decode_set)
+{
+	uint8_t const full[] = {2, 0x22, 0x22, 1, 0x11, 4, 1, 'a', 4, 2, 'b', 'c'};
+	uint8_t const part[] = {1, 0x33};
+
+	gn::set msg;
+	med::decoder_context<> ctx{ full };
+	decode(med::octet_decoder{ctx}, msg);
+	ASSERT_NE(nullptr, msg.get<gn::word>());
+	EXPECT_EQ(2, msg.count<gn::text>());
+
+	msg.clear();
+	ctx.reset(part, sizeof(part));
+	decode(med::octet_decoder{ctx}, msg);
+	EXPECT_EQ(0x33, msg.get<gn::byte>().get());
+	EXPECT_EQ(nullptr, msg.get<gn::word>());
+	EXPECT_EQ(0, msg.count<gn::text>());
+
+	//mandatory is checked against current generation
+	msg.clear();
+	uint8_t const missing[] = {2, 0x22, 0x22};
+	ctx.reset(missing, sizeof(missing));
+	EXPECT_THROW(decode(med::octet_decoder{ctx}, msg), med::missing_ie);
+}
@@ -0,0 +1,261 @@
+#include "ut.hpp"
+
+#include "json/encoder.hpp"
+#include "json/decoder.hpp"
+
+namespace {
+
+template <class IE>
+std::string encoded(IE const& enc)
+{
+	uint8_t enc_buf[1024] = {};
+	med::encoder_context<> ectx{ enc_buf };
+	encode(med::json::encoder{ectx}, enc);
+
+	uint8_t mem[1024];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> dctx{ectx.buffer().get_start(), ectx.buffer().get_offset(), &alloc};
+	IE dec;
+	decode(med::json::decoder{dctx}, dec);
+	EXPECT_EQ(ectx.buffer().get_offset(), dctx.buffer().get_offset());
+
+	//re-encoding of decoded is to match the original
+	uint8_t dec_buf[1024] = {};
+	med::encoder_context<> rctx{ dec_buf };
+	encode(med::json::encoder{rctx}, dec);
+	EXPECT_EQ(ectx.buffer().get_offset(), rctx.buffer().get_offset());
+	EXPECT_EQ(0, std::memcmp(enc_buf, dec_buf, ectx.buffer().get_offset()));
+
+	return std::string{(char const*)enc_buf, ectx.buffer().get_offset()};
+}
+
+template <class IE, class... ARGS>
+std::string encoded(ARGS&&... args)
+{
+	IE ie;
+	ie.set(std::forward<ARGS>(args)...);
+	return encoded(ie);
+}
+
+template <class IE>
+void decoded(IE& ie, std::string_view json)
+{
+	static uint8_t mem[1024];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> dctx{json.data(), json.size(), &alloc};
+	decode(med::json::decoder{dctx}, ie);
+	EXPECT_EQ(json.size(), dctx.buffer().get_offset());
+}
+
+} //end: namespace
+
+namespace js {
+
+template <uint8_t TAG>
+using T = med::value<med::fixed<TAG, uint8_t>>;
+
+struct U8 : med::value<uint8_t> { static constexpr char const* name() { return "u8"; } };
+struct I32 : med::value<int32_t> { static constexpr char const* name() { return "i32"; } };
+struct REAL : med::value<double> { static constexpr char const* name() { return "real"; } };
+struct FLAG : med::value<bool> { static constexpr char const* name() { return "flag"; } };
+struct TEXT : med::ascii_string<med::octets_var_extern, med::max<32>> { static constexpr char const* name() { return "text"; } };
+struct BLOB : med::octet_string<med::octets_var_extern, med::max<8>> { static constexpr char const* name() { return "blob"; } };
+
+struct INNER : med::sequence<
+	M< U8 >,
+	O< TEXT >
+>{ static constexpr char const* name() { return "inner"; } };
+
+struct MSG : med::sequence<
+	M< I32 >,
+	O< FLAG >,
+	O< REAL >,
+	O< BLOB >,
+	O< INNER, med::max<2> >
+>{};
+
+struct SET : med::set<
+	M< T<1>, U8 >,
+	O< T<2>, TEXT >
+>{};
+
+struct CHOICE : med::choice<
+	M< U8 >,
+	M< TEXT >
+>{};
+
+struct BIG : med::ascii_string<med::octets_var_intern<256>> { static constexpr char const* name() { return "big"; } };
+
+//large alternative stored out of line
+struct COMPACT : med::choice<
+	M< U8 >,
+	med::out_of_line< M< BIG > >
+>{};
+
+} //end: namespace js
+
+TEST(json, value)
+{
+	EXPECT_EQ("0", encoded<med::value<uint8_t>>(0));
+	EXPECT_EQ("-2147483648", encoded<med::value<int32_t>>(std::numeric_limits<int32_t>::min()));
+	EXPECT_EQ("18446744073709551615", encoded<med::value<uint64_t>>(std::numeric_limits<uint64_t>::max()));
+	EXPECT_EQ("true", encoded<med::value<bool>>(true));
+	EXPECT_EQ("false", encoded<med::value<bool>>(false));
+	EXPECT_EQ("1.5", encoded<med::value<double>>(1.5));
+	EXPECT_EQ("-0.1", encoded<med::value<float>>(-0.1f));
+
+	med::value<double> nan;
+	nan.set(std::numeric_limits<double>::quiet_NaN());
+	uint8_t buf[16];
+	med::encoder_context<> ectx{ buf };
+	EXPECT_THROW(encode(med::json::encoder{ectx}, nan), med::invalid_value);
+	//no room
+	uint8_t small[2];
+	ectx.reset(small, sizeof(small));
+	med::value<uint16_t> u16;
+	u16.set(100);
+	EXPECT_THROW(encode(med::json::encoder{ectx}, u16), med::overflow);
+
+	med::value<uint8_t> u8;
+	EXPECT_THROW(decoded(u8, "256"), med::invalid_value);
+	EXPECT_THROW(decoded(u8, "-1"), med::invalid_value);
+	EXPECT_THROW(decoded(u8, "x"), med::invalid_value);
+	decoded(u8, " \t\n7");
+	EXPECT_EQ(7, u8.get());
+}
+
+TEST(json, string)
+{
+	EXPECT_EQ(R"("text")", encoded<js::TEXT>("text"));
+	EXPECT_EQ(R"("a\"b\\c\nd\u0001")", encoded<js::TEXT>("a\"b\\c\nd\x01"));
+	uint8_t const data[] = {0x01, 0xAB, 0xFF};
+	EXPECT_EQ(R"("01abff")", encoded<js::BLOB>(sizeof(data), data));
+
+	//zero-copy decode of strings w/o escapes
+	constexpr std::string_view plain = R"("plain")";
+	js::TEXT text;
+	decoded(text, plain);
+	EXPECT_EQ((uint8_t const*)plain.data() + 1, text.data());
+	EXPECT_EQ("plain", text.get());
+
+	decoded(text, R"("\/\t\u00e9\ud83d\ude00")");
+	EXPECT_EQ("/\t\xC3\xA9\xF0\x9F\x98\x80", text.get());
+
+	js::BLOB blob;
+	decoded(blob, R"("0A0b")");
+	EXPECT_EQ(2, blob.size());
+	EXPECT_EQ(0x0A, blob.data()[0]);
+	EXPECT_EQ(0x0B, blob.data()[1]);
+
+	EXPECT_THROW(decoded(text, R"("open)"), med::overflow);
+	EXPECT_THROW(decoded(text, R"("\x")"), med::invalid_value);
+	EXPECT_THROW(decoded(blob, R"("abc")"), med::invalid_value);
+	EXPECT_THROW(decoded(blob, R"("zz")"), med::invalid_value);
+	//too long
+	EXPECT_THROW(decoded(blob, R"("000000000000000000")"), med::invalid_value);
+}
+
+TEST(json, sequence)
+{
+	js::MSG msg;
+	EXPECT_THROW(encoded(msg), med::missing_ie);
+
+	msg.ref<js::I32>().set(-2);
+	EXPECT_EQ(R"({"i32":-2})", encoded(msg));
+
+	uint8_t const data[] = {0xBE, 0xEF};
+	msg.ref<js::FLAG>().set(true);
+	msg.ref<js::REAL>().set(0.25);
+	msg.ref<js::BLOB>().set(sizeof(data), data);
+	auto* inner = msg.ref<js::INNER>().push_back();
+	inner->ref<js::U8>().set(7);
+	inner = msg.ref<js::INNER>().push_back();
+	inner->ref<js::U8>().set(8);
+	inner->ref<js::TEXT>().set("x");
+	EXPECT_EQ(R"({"i32":-2,"flag":true,"real":0.25,"blob":"beef","inner":[{"u8":7},{"u8":8,"text":"x"}]})", encoded(msg));
+
+	//any order and whitespaces, unknown members are skipped, null for absent
+	js::MSG dmsg;
+	decoded(dmsg, R"( {
+		"flag" : false,
+		"unknown": {"x": [1, -2.5e3, "}", null, true, {}], "y": []},
+		"real": null,
+		"i32" : 42
+	})");
+	EXPECT_EQ(42, dmsg.get<js::I32>().get());
+	ASSERT_NE(nullptr, dmsg.get<js::FLAG>());
+	EXPECT_FALSE(dmsg.get<js::FLAG>()->get());
+	EXPECT_EQ(nullptr, dmsg.get<js::REAL>());
+	EXPECT_TRUE(dmsg.get<js::INNER>().empty());
+
+	//mandatory is missing
+	dmsg.clear();
+	EXPECT_THROW(decoded(dmsg, R"({"flag":true})"), med::missing_ie);
+	//too many in array
+	dmsg.clear();
+	EXPECT_THROW(decoded(dmsg, R"({"i32":1,"inner":[{"u8":1},{"u8":2},{"u8":3}]})"), med::extra_ie);
+	//malformed
+	dmsg.clear();
+	EXPECT_THROW(decoded(dmsg, R"({"i32":1,})"), med::invalid_value);
+	dmsg.clear();
+	EXPECT_THROW(decoded(dmsg, R"({"i32" 1})"), med::invalid_value);
+	dmsg.clear();
+	EXPECT_THROW(decoded(dmsg, R"({"i32":1)"), med::overflow);
+	dmsg.clear();
+	EXPECT_THROW(decoded(dmsg, R"([])"), med::invalid_value);
+}
+
+TEST(json, set)
+{
+	js::SET msg;
+	msg.ref<js::U8>().set(1);
+	msg.ref<js::TEXT>().set("one");
+	EXPECT_EQ(R"({"u8":1,"text":"one"})", encoded(msg));
+
+	js::SET dmsg;
+	decoded(dmsg, R"({"text":"two","u8":2})");
+	EXPECT_EQ(2, dmsg.get<js::U8>().get());
+	ASSERT_NE(nullptr, dmsg.get<js::TEXT>());
+	EXPECT_EQ("two", dmsg.get<js::TEXT>()->get());
+}
+
+TEST(json, choice)
+{
+	js::CHOICE msg;
+	msg.ref<js::U8>().set(5);
+	EXPECT_EQ(R"({"u8":5})", encoded(msg));
+	msg.ref<js::TEXT>().set("five");
+	EXPECT_EQ(R"({"text":"five"})", encoded(msg));
+
+	EXPECT_THROW(decoded(msg, R"({"u16":5})"), med::unknown_tag);
+	EXPECT_THROW(decoded(msg, R"({"u8":5,"text":"five"})"), med::invalid_value);
+}
+
+TEST(json, choice_out_of_line)
+{
+	constexpr std::string_view json = R"({"big":"large one"})";
+	js::COMPACT msg;
+	//no allocator to place it
+	med::decoder_context<> ctx{json.data(), json.size()};
+	EXPECT_THROW(decode(med::json::decoder{ctx}, msg), med::out_of_memory);
+
+	msg.clear();
+	decoded(msg, json);
+	auto const* big = msg.get<js::BIG>();
+	ASSERT_NE(nullptr, big);
+	EXPECT_EQ("large one", big->get());
+}
+
+TEST(json, text_sbo)
+{
+	using sbo_text = med::ascii_string<med::octets_var_sbo<4>>;
+	char encoded[] = R"("long text")";
+	uint8_t mem[64];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> ctx{encoded, sizeof(encoded) - 1, &alloc};
+	sbo_text s;
+	decode(med::json::decoder{ctx}, s);
+	//long value is copied thus survives reuse of the input buffer
+	std::memset(encoded, 0, sizeof(encoded));
+	EXPECT_EQ("long text", s.get());
+}
@@ -1,4 +1,5 @@
 #include "ut.hpp"
+#include "indexed.hpp"
 
 namespace multi {
 
@@ -19,6 +20,43 @@ struct M1 : med::sequence<
 	O< T<2>, U16, med::inf>
 >{};
 
+struct COUNTED : med::sequence<
+	M< med::counter_t<U8>, U16, med::pmax<16>>
+>{};
+struct REST : med::sequence<
+	M< U8 >,
+	M< U32, med::pmax<16>>
+>{};
+
+struct PAIR : med::sequence<
+	M< U8 >,
+	M< U16 >
+>{};
+struct by_id
+{
+	uint8_t operator()(PAIR const& p) const { return p.get<U8>().get(); }
+};
+template <std::size_t CAPACITY>
+struct INDEXED : med::sequence<
+	med::indexed< M< med::counter_t<U8>, PAIR, med::pmax<8>>, by_id, CAPACITY >
+>{};
+
+//relocatable nodes of multi-field and out of line alternative
+struct TEXT : med::octet_string<med::octets_var_reloc, med::max<32>> {};
+struct WORD : med::value<uint16_t>
+{
+	using links = med::relocatable;
+};
+struct ALT : med::choice<
+	M< T<1>, U8 >,
+	med::out_of_line< M< T<2>, L, TEXT >, med::relocatable >
+>{};
+struct RELOC : med::sequence<
+	O< T<1>, L, TEXT >,
+	O< T<2>, WORD, med::inf>,
+	O< T<3>, L, ALT >
+>{};
+
 } //end: namespace multi
 
 TEST(multi, pop_back)
@@ -141,3 +179,201 @@ TEST(multi, erase)
 	EXPECT_EQ(sizeof(encoded), ctx.buffer().get_offset());
 	EXPECT_TRUE(Matches(encoded, buffer));
 }
+
+TEST(multi, relocate)
+{
+	using namespace multi;
+	uint8_t const encoded[] = {
+		1, 5, 'h','e','l','l','o',
+		2, 0x12, 0x34,
+		2, 0x56, 0x78,
+		2, 0x9A, 0xBC,
+		3, 7, 2, 5, 'w','o','r','l','d',
+	};
+
+	//message and its allocator space in one memory block
+	struct blob
+	{
+		RELOC   msg;
+		uint8_t mem[128];
+	};
+	auto src = std::make_unique<blob>();
+	{
+		med::allocator alloc{src->mem};
+		med::decoder_context<med::allocator> ctx{encoded, &alloc};
+		decode(med::octet_decoder{ctx}, src->msg);
+	}
+
+	//hand off as a blob to other address and drop the source
+	alignas(blob) uint8_t dst[sizeof(blob)];
+	std::memcpy(dst, src.get(), sizeof(blob));
+	std::memset(static_cast<void*>(src.get()), 0xFF, sizeof(blob));
+	src.reset();
+
+	auto const& msg = reinterpret_cast<blob const*>(dst)->msg;
+	auto const* text = msg.get<TEXT>();
+	ASSERT_NE(nullptr, text);
+	EXPECT_EQ(5, text->size());
+	EXPECT_TRUE(Matches(encoded + 2, text->data(), 5));
+
+	auto const& words = msg.get<WORD>();
+	ASSERT_EQ(3, words.count());
+	uint16_t const expected[] = {0x1234, 0x5678, 0x9ABC};
+	std::size_t i = 0;
+	for (auto& w : words) { EXPECT_EQ(expected[i++], w.get()); }
+	EXPECT_EQ(3, i);
+
+	auto const* alt = msg.get<ALT>();
+	ASSERT_NE(nullptr, alt);
+	auto const* alt_text = alt->get<TEXT>();
+	ASSERT_NE(nullptr, alt_text);
+	EXPECT_TRUE(Matches(encoded + sizeof(encoded) - 5, alt_text->data(), 5));
+}
+
+TEST(multi, reserve)
+{
+	using namespace multi;
+	uint8_t mem[256];
+	med::allocator alloc{mem};
+	counting_allocator calls{alloc};
+
+	//counted: all nodes but inplace one reserved at once
+	{
+		uint8_t const encoded[] = { 5, 0,1, 0,2, 0,3, 0,4, 0,5 };
+		med::decoder_context<counting_allocator> ctx{encoded, &calls};
+		COUNTED msg;
+		decode(med::octet_decoder{ctx}, msg);
+		EXPECT_EQ(1, calls.calls);
+		ASSERT_EQ(5, msg.count<U16>());
+		uint16_t v = 0;
+		for (auto& f : msg.get<U16>()) { EXPECT_EQ(++v, f.get()); }
+	}
+
+	//uncounted till the end of buffer: count is known for fixed-size ones
+	calls.calls = 0;
+	{
+		uint8_t const encoded[] = { 7, 0,0,0,1, 0,0,0,2, 0,0,0,3, 0,0,0,4 };
+		med::decoder_context<counting_allocator> ctx{encoded, &calls};
+		REST msg;
+		decode(med::octet_decoder{ctx}, msg);
+		EXPECT_EQ(1, calls.calls);
+		ASSERT_EQ(4, msg.count<U32>());
+		uint32_t v = 0;
+		for (auto& f : msg.get<U32>()) { EXPECT_EQ(++v, f.get()); }
+	}
+
+	//reserve is just a hint
+	alloc.reset(mem, 16);
+	calls.calls = 0;
+	{
+		M1 msg;
+		msg.ref<U16>().reserve(100, calls);
+		EXPECT_EQ(1, calls.calls);
+		ASSERT_NE(nullptr, msg.ref<U16>().push_back(calls));
+		ASSERT_NE(nullptr, msg.ref<U16>().push_back(calls));
+		EXPECT_EQ(2, msg.count<U16>());
+	}
+
+	//even if allocator throws
+	alloc.reset(mem, 16);
+	{
+		struct throwing_allocator
+		{
+			void* allocate(std::size_t bytes, std::size_t alignment)
+			{
+				if (void* p = alloc.allocate(bytes, alignment)) { return p; }
+				throw med::out_of_memory{"throwing_allocator", bytes};
+			}
+			med::allocator& alloc;
+		} thrower{alloc};
+		M1 msg;
+		msg.ref<U16>().reserve(100, thrower);
+		ASSERT_NE(nullptr, msg.ref<U16>().push_back(thrower));
+		ASSERT_NE(nullptr, msg.ref<U16>().push_back(thrower));
+		EXPECT_EQ(2, msg.count<U16>());
+	}
+}
+
+TEST(multi, bulk)
+{
+	using namespace multi;
+	uint8_t const encoded[] = { 3, 0x12,0x34, 0x56,0x78, 0x9A,0xBC };
+
+	uint8_t mem[128];
+	med::allocator alloc{mem};
+	COUNTED msg;
+	{
+		med::decoder_context<med::allocator> ctx{encoded, &alloc};
+		decode(med::octet_decoder{ctx}, msg);
+		uint16_t const expected[] = {0x1234, 0x5678, 0x9ABC};
+		ASSERT_EQ(3, msg.count<U16>());
+		std::size_t i = 0;
+		for (auto& f : msg.get<U16>()) { EXPECT_EQ(expected[i++], f.get()); }
+	}
+	{
+		uint8_t buffer[16];
+		med::encoder_context<> ctx{buffer};
+		encode(med::octet_encoder{ctx}, msg);
+		EXPECT_EQ(sizeof(encoded), ctx.buffer().get_offset());
+		EXPECT_TRUE(Matches(encoded, buffer));
+
+		//not enough space for all
+		med::encoder_context<> small{buffer, 4};
+		EXPECT_THROW(encode(med::octet_encoder{small}, msg), med::overflow);
+	}
+	{
+		med::decoder_context<med::allocator> ctx{encoded, &alloc};
+		COUNTED le;
+		decode(med::octet_decoder{ctx, med::endian<med::byte_order::little>{}}, le);
+		ASSERT_EQ(3, le.count<U16>());
+		EXPECT_EQ(0x3412, le.get<U16>().first()->get());
+	}
+	{
+		//count exceeds the data
+		med::decoder_context<med::allocator> ctx{encoded, sizeof(encoded) - 1, &alloc};
+		COUNTED bad;
+		EXPECT_THROW(decode(med::octet_decoder{ctx}, bad), med::overflow);
+	}
+}
+
+TEST(multi, indexed)
+{
+	using namespace multi;
+	uint8_t const encoded[] = { 5, 7,0,70, 3,0,30, 9,0,90, 3,0,31, 1,0,10 };
+
+	auto check = [&](auto& msg)
+	{
+		uint8_t mem[128];
+		med::allocator alloc{mem};
+		med::decoder_context<med::allocator> ctx{encoded, &alloc};
+		decode(med::octet_decoder{ctx}, msg);
+
+		auto& pairs = msg.template ref<PAIR>();
+		ASSERT_EQ(5, pairs.count());
+		auto const* p = pairs.find(3);
+		ASSERT_NE(nullptr, p);
+		EXPECT_EQ(30, p->template get<U16>().get()); //1st one of duplicates
+		ASSERT_NE(nullptr, pairs.find(9));
+		EXPECT_EQ(90, pairs.find(9)->template get<U16>().get());
+		EXPECT_EQ(nullptr, pairs.find(4));
+
+		//index follows modifications
+		pairs.erase(std::next(pairs.begin()));
+		ASSERT_NE(nullptr, pairs.find(3));
+		EXPECT_EQ(31, pairs.find(3)->template get<U16>().get());
+		auto* added = pairs.push_back(alloc);
+		added->template ref<U8>().set(4);
+		added->template ref<U16>().set(40);
+		pairs.reindex(); //key is set after push_back
+		ASSERT_NE(nullptr, pairs.find(4));
+		EXPECT_EQ(40, pairs.find(4)->template get<U16>().get());
+		msg.clear();
+		EXPECT_EQ(nullptr, pairs.find(9));
+	};
+
+	INDEXED<8> indexed;
+	check(indexed);
+	//linear search beyond capacity
+	INDEXED<2> linear;
+	check(linear);
+}
@@ -0,0 +1,165 @@
+#include "ut.hpp"
+
+#include "native/encoder.hpp"
+#include "native/view.hpp"
+
+namespace nt {
+
+struct U8 : med::value<uint8_t> {};
+struct U16 : med::value<uint16_t> {};
+struct I32 : med::value<int32_t> {};
+struct U64 : med::value<uint64_t> {};
+struct DBL : med::value<double> {};
+struct FLAG : med::empty<> {};
+struct STR : med::octet_string<med::octets_var_extern, med::max<16>> {};
+struct TXT : med::octet_string<med::octets_var_extern, med::max<16>> {};
+
+struct INNER : med::sequence<
+	M< U8 >,
+	O< STR >
+>{};
+
+struct CHOICE : med::choice<
+	M< U16 >,
+	M< STR >,
+	M< INNER >
+>{};
+
+struct MSG : med::sequence<
+	M< I32 >,
+	O< U64 >,
+	O< DBL >,
+	O< FLAG >,
+	M< STR >,
+	O< INNER >,
+	O< CHOICE >,
+	O< U16, med::max<4> >,
+	O< TXT, med::max<2> >
+>{};
+
+struct SET : med::set<
+	M< med::value<med::fixed<1, uint8_t>>, U8 >,
+	O< med::value<med::fixed<2, uint8_t>>, U16 >
+>{};
+
+} //end: namespace nt
+
+TEST(native, layout)
+{
+	using layout = med::native::detail::layout<nt::MSG>;
+	//9 IEs: 2 octets of bitmap then slots
+	static_assert(2 == layout::bitmap_size);
+	static_assert(2 == layout::slots[0]);
+	static_assert(6 == layout::slots[1]);   //after I32
+	static_assert(14 == layout::slots[2]);  //after U64
+	static_assert(22 == layout::slots[3]);  //after DBL
+	static_assert(22 == layout::slots[4]);  //FLAG takes nothing
+	static_assert(30 == layout::slots[5]);  //after STR
+	static_assert(34 == layout::slots[6]);  //after INNER
+	static_assert(38 == layout::slots[7]);  //after CHOICE
+	static_assert(46 == layout::slots[8]);  //after U16 array
+	static_assert(54 == layout::size);
+	//index and the largest alternative (offset and length of STR)
+	static_assert(12 == med::native::detail::layout<nt::CHOICE>::size);
+}
+
+TEST(native, sequence)
+{
+	uint8_t const data[] = {1, 2, 3};
+	nt::MSG msg;
+	msg.ref<nt::I32>().set(-5);
+	msg.ref<nt::STR>().set(sizeof(data), data);
+
+	uint8_t buffer[256];
+	med::encoder_context<> ctx{ buffer };
+	encode(med::native::encoder{ctx}, msg);
+
+	{
+		med::native::view<nt::MSG> v{buffer, ctx.buffer().get_offset()};
+		EXPECT_EQ(-5, v.get<nt::I32>());
+		EXPECT_TRUE(v.has<nt::I32>());
+		EXPECT_FALSE(v.has<nt::U64>());
+		EXPECT_FALSE(v.get<nt::U64>().has_value());
+		//empty IE is always set
+		EXPECT_TRUE(v.get<nt::FLAG>());
+		EXPECT_FALSE(v.get<nt::INNER>());
+		EXPECT_FALSE(v.get<nt::CHOICE>());
+		EXPECT_TRUE(v.get<nt::U16>().empty());
+		auto const str = v.get<nt::STR>();
+		ASSERT_EQ(sizeof(data), str.size());
+		EXPECT_TRUE(Matches(data, str.data()));
+	}
+
+	msg.ref<nt::U64>().set(0x123456789ABCDEF0);
+	msg.ref<nt::DBL>().set(2.5);
+	msg.ref<nt::INNER>().ref<nt::U8>().set(7);
+	msg.ref<nt::INNER>().ref<nt::STR>().set(2, data);
+	msg.ref<nt::CHOICE>().ref<nt::U16>().set(0x1234);
+	for (uint16_t i = 0; i < 3; ++i) { msg.ref<nt::U16>().push_back()->set(i + 10); }
+	msg.ref<nt::TXT>().push_back()->set(1, data);
+	msg.ref<nt::TXT>().push_back()->set(3, data);
+
+	ctx.reset();
+	encode(med::native::encoder{ctx}, msg);
+	auto const len = ctx.buffer().get_offset();
+
+	med::native::view<nt::MSG> v{buffer, len};
+	EXPECT_EQ(-5, v.get<nt::I32>());
+	ASSERT_TRUE(v.get<nt::U64>().has_value());
+	EXPECT_EQ(0x123456789ABCDEF0, *v.get<nt::U64>());
+	EXPECT_EQ(2.5, *v.get<nt::DBL>());
+	EXPECT_TRUE(v.get<nt::FLAG>());
+
+	auto const inner = v.get<nt::INNER>();
+	ASSERT_TRUE(inner);
+	EXPECT_EQ(7, inner.get<nt::U8>());
+	EXPECT_EQ(2, inner.get<nt::STR>().size());
+
+	auto const choice = v.get<nt::CHOICE>();
+	ASSERT_TRUE(choice);
+	EXPECT_EQ(0, choice.index());
+	EXPECT_TRUE(choice.has<nt::U16>());
+	EXPECT_EQ(0x1234, *choice.get<nt::U16>());
+	EXPECT_FALSE(choice.get<nt::STR>().data());
+	EXPECT_FALSE(choice.get<nt::INNER>());
+
+	auto const u16s = v.get<nt::U16>();
+	ASSERT_EQ(3, u16s.size());
+	EXPECT_EQ(10, u16s[0]);
+	EXPECT_EQ(12, u16s[2]);
+	EXPECT_THROW(u16s[3], med::invalid_value);
+	auto const strs = v.get<nt::TXT>();
+	ASSERT_EQ(2, strs.size());
+	EXPECT_EQ(1, strs[0].size());
+	EXPECT_EQ(3, strs[1].size());
+
+	//truncated
+	EXPECT_THROW((med::native::view<nt::MSG>{buffer, 10}), med::overflow);
+	med::native::view<nt::MSG> cut{buffer, len - 1};
+	EXPECT_EQ(-5, cut.get<nt::I32>());
+	EXPECT_EQ(1, cut.get<nt::TXT>()[0].size());
+	EXPECT_THROW(cut.get<nt::TXT>()[1], med::overflow);
+}
+
+TEST(native, errors)
+{
+	uint8_t buffer[64];
+	med::encoder_context<> ctx{ buffer };
+	nt::MSG msg;
+	EXPECT_THROW(encode(med::native::encoder{ctx}, msg), med::missing_ie);
+
+	nt::SET set;
+	set.ref<nt::U8>().set(1);
+	ctx.reset();
+	encode(med::native::encoder{ctx}, set);
+	med::native::view<nt::SET> v{buffer, ctx.buffer().get_offset()};
+	EXPECT_EQ(1, v.get<nt::U8>());
+	EXPECT_FALSE(v.get<nt::U16>());
+
+	uint8_t small[8];
+	ctx.reset(small, sizeof(small));
+	uint8_t const data[] = {1, 2, 3};
+	msg.ref<nt::I32>().set(1);
+	msg.ref<nt::STR>().set(sizeof(data), data);
+	EXPECT_THROW(encode(med::native::encoder{ctx}, msg), med::overflow);
+}
@@ -314,3 +314,64 @@ TEST(octets, ascii_string)
 	s.set(arr);
 	EXPECT_EQ(s.get().size(), std::strlen(arr));
 }
+
+TEST(octets, var_sbo)
+{
+	using sbo = med::octet_string<med::octets_var_sbo<8>, med::min<0>, med::max<32>>;
+	using sbo_view = med::octet_string<med::octets_var_sbo<8, true>, med::min<0>, med::max<32>>;
+	static_assert(sizeof(sbo) < sizeof(med::octet_string<med::octets_var_intern<32>>));
+
+	uint8_t encoded[] = {1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16};
+	uint8_t const in[] = {1,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16};
+
+	//short one is kept inline regardless of source
+	{
+		med::decoder_context<> ctx{encoded, 5};
+		sbo s;
+		decode(med::octet_decoder{ctx}, s);
+		ASSERT_TRUE(s.is_set());
+		ASSERT_EQ(5, s.size());
+		EXPECT_NE(encoded, s.data());
+		encoded[0] = 0xFF;
+		EXPECT_TRUE(Matches(in, s.data(), 5));
+		encoded[0] = 1;
+	}
+
+	//long one refers to the source w/o allocator
+	{
+		med::decoder_context<> ctx{encoded, sizeof(encoded)};
+		sbo s;
+		decode(med::octet_decoder{ctx}, s);
+		ASSERT_EQ(sizeof(in), s.size());
+		EXPECT_EQ(encoded, s.data());
+	}
+
+	uint8_t mem[64];
+	med::allocator alloc{mem};
+	{
+		med::decoder_context<med::allocator> ctx{encoded, sizeof(encoded), &alloc};
+		sbo s;
+		decode(med::octet_decoder{ctx}, s);
+		ASSERT_EQ(sizeof(in), s.size());
+		EXPECT_EQ(mem, s.data());
+		//survives reuse of the input buffer
+		encoded[0] = 0xFF;
+		EXPECT_TRUE(Matches(in, s.data()));
+		encoded[0] = 1;
+	}
+	{
+		med::decoder_context<> ctx{encoded, sizeof(encoded)};
+		sbo_view s;
+		decode(med::octet_decoder{ctx}, s);
+		ASSERT_EQ(sizeof(in), s.size());
+		EXPECT_EQ(encoded, s.data());
+	}
+
+	//plain set refers to the source
+	sbo s;
+	ASSERT_TRUE(s.set(sizeof(in), in));
+	EXPECT_EQ(in, s.data());
+	s.clear();
+	EXPECT_FALSE(s.is_set());
+	EXPECT_EQ(nullptr, s.data());
+}
@@ -0,0 +1,132 @@
+#include "ut.hpp"
+#include "packed.hpp"
+
+namespace pk {
+
+struct byte : med::value<uint8_t> {};
+struct word : med::value<uint16_t> {};
+struct dword : med::value<uint32_t> {};
+struct item : med::value<uint16_t> {};
+
+struct pbyte : med::packed_value<uint8_t> {};
+struct pword : med::packed_value<uint16_t> {};
+struct pdword : med::packed_value<uint32_t> {};
+
+struct seq : med::sequence<
+	M< T<1>, byte >,
+	M< T<2>, word >,
+	O< T<3>, dword >,
+	O< T<4>, item, med::max<2> >
+>{};
+
+struct packed_seq : med::packed_sequence<
+	M< T<1>, pbyte >,
+	M< T<2>, pword >,
+	O< T<3>, pdword >,
+	O< T<4>, item, med::max<2> >
+>{};
+
+struct set : med::set<
+	M< T<1>, byte >,
+	O< T<2>, word >,
+	M< T<3>, dword >
+>{};
+
+struct packed_set : med::packed_set<
+	M< T<1>, pbyte >,
+	O< T<2>, pword >,
+	M< T<3>, pdword >
+>{};
+
+} //end: namespace pk
+
+TEST(packed, size)
+{
+	//footprint saving is reported in test output
+	RecordProperty("sizeof_seq", int(sizeof(pk::seq)));
+	RecordProperty("sizeof_packed_seq", int(sizeof(pk::packed_seq)));
+	RecordProperty("sizeof_set", int(sizeof(pk::set)));
+	RecordProperty("sizeof_packed_set", int(sizeof(pk::packed_set)));
+
+	EXPECT_LE(sizeof(pk::packed_seq), sizeof(pk::seq));
+	EXPECT_EQ(4 * sizeof(uint32_t), sizeof(pk::set));
+	//bitmap and values only
+	EXPECT_EQ(3 * sizeof(uint32_t), sizeof(pk::packed_set));
+}
+
+TEST(packed, presence)
+{
+	pk::packed_seq msg;
+	EXPECT_FALSE(msg.is_set());
+	EXPECT_FALSE(msg.get<pk::pbyte>().is_set());
+	EXPECT_EQ(nullptr, msg.get<pk::pdword>());
+
+	msg.ref<pk::pdword>().set(3);
+	EXPECT_TRUE(msg.is_set());
+	ASSERT_NE(nullptr, msg.get<pk::pdword>());
+	EXPECT_EQ(3, msg.get<pk::pdword>()->get());
+	EXPECT_FALSE(msg.get<pk::pword>().is_set());
+
+	msg.ref<pk::pbyte>().set(1);
+	EXPECT_TRUE(msg.get<pk::pbyte>().is_set());
+	msg.clear<pk::pdword>();
+	EXPECT_EQ(nullptr, msg.get<pk::pdword>());
+	EXPECT_TRUE(msg.is_set());
+
+	msg.clear();
+	EXPECT_FALSE(msg.is_set());
+	//non-packed IEs are accounted as well
+	msg.ref<pk::item>().push_back()->set(4);
+	EXPECT_TRUE(msg.is_set());
+}
+
+TEST(packed, sequence)
+{
+	uint8_t const encoded[] = {1, 0x11, 2, 0x22, 0x22, 4, 0, 1, 4, 0, 2};
+
+	pk::packed_seq msg;
+	med::decoder_context<> ctx{ encoded };
+	decode(med::octet_decoder{ctx}, msg);
+	EXPECT_EQ(0x11, msg.get<pk::pbyte>().get());
+	EXPECT_EQ(0x2222, msg.get<pk::pword>().get());
+	EXPECT_EQ(nullptr, msg.get<pk::pdword>());
+	check_seqof<pk::item>(msg, {1, 2});
+
+	uint8_t buffer[32];
+	med::encoder_context<> ectx{ buffer };
+	encode(med::octet_encoder{ectx}, msg);
+	EXPECT_EQ(sizeof(encoded), ectx.buffer().get_offset());
+	EXPECT_TRUE(Matches(encoded, buffer));
+
+	pk::packed_seq copy;
+	copy.copy(msg);
+	EXPECT_TRUE(copy == msg);
+
+	msg.clear<pk::pword>();
+	ectx.reset();
+	EXPECT_THROW(encode(med::octet_encoder{ectx}, msg), med::missing_ie);
+}
+
+TEST(packed, set)
+{
+	uint8_t const encoded[] = {3, 0, 0, 0, 3, 1, 0x11};
+
+	pk::packed_set msg;
+	med::decoder_context<> ctx{ encoded };
+	decode(med::octet_decoder{ctx}, msg);
+	EXPECT_EQ(0x11, msg.get<pk::pbyte>().get());
+	EXPECT_EQ(3, msg.get<pk::pdword>().get());
+	EXPECT_EQ(nullptr, msg.get<pk::pword>());
+
+	//duplicate
+	uint8_t const extra[] = {1, 0x11, 1, 0x22};
+	msg.clear();
+	ctx.reset(extra, sizeof(extra));
+	EXPECT_THROW(decode(med::octet_decoder{ctx}, msg), med::extra_ie);
+
+	//missing mandatory
+	uint8_t const missing[] = {1, 0x11, 2, 0, 2};
+	msg.clear();
+	ctx.reset(missing, sizeof(missing));
+	EXPECT_THROW(decode(med::octet_decoder{ctx}, msg), med::missing_ie);
+}
@@ -0,0 +1,72 @@
+#include <vector>
+
+#include "ut.hpp"
+#include "pmr.hpp"
+
+namespace pm {
+
+struct byte : med::value<uint8_t> {};
+struct word : med::value<uint16_t> {};
+
+struct msg : med::sequence<
+	M< T<0xF1>, byte, med::inf >, //<TV>*[1,*)
+	O< T<0xF2>, word, med::inf >  //[TV]*
+>{};
+
+} //end: namespace pm
+
+TEST(pmr, pool_decode)
+{
+	uint8_t const encoded[] = {
+		0xF1, 0x01,
+		0xF1, 0x02,
+		0xF1, 0x03,
+		0xF2, 0x12, 0x34,
+		0xF2, 0x56, 0x78,
+	};
+
+	std::pmr::unsynchronized_pool_resource pool;
+	med::pmr_allocator alloc{&pool};
+	for (int i = 0; i < 2; ++i)
+	{
+		med::decoder_context<med::pmr_allocator> ctx{ encoded, &alloc };
+		pm::msg msg;
+		decode(med::octet_decoder{ctx}, msg);
+		ASSERT_EQ(3, msg.count<pm::byte>());
+		ASSERT_EQ(2, msg.count<pm::word>());
+		auto it = msg.get<pm::byte>().begin();
+		EXPECT_EQ(1, it->get());
+		EXPECT_EQ(3, (++(++it))->get());
+
+		uint8_t buffer[32];
+		med::encoder_context<> ectx{ buffer };
+		encode(med::octet_encoder{ectx}, msg);
+		EXPECT_EQ(sizeof(encoded), ectx.buffer().get_offset());
+		EXPECT_TRUE(Matches(encoded, buffer));
+	}
+	pool.release();
+
+	//exhausted resource
+	uint8_t mem[8];
+	std::pmr::monotonic_buffer_resource mono{mem, sizeof(mem), std::pmr::null_memory_resource()};
+	med::pmr_allocator mono_alloc{&mono};
+	med::decoder_context<med::pmr_allocator> ctx{ encoded, &mono_alloc };
+	pm::msg msg;
+	EXPECT_THROW(decode(med::octet_decoder{ctx}, msg), med::out_of_memory);
+}
+
+TEST(pmr, allocator_resource)
+{
+	uint8_t mem[64];
+	med::allocator alloc{mem};
+	med::allocator_resource res{alloc};
+
+	std::pmr::vector<uint32_t> v{&res};
+	v.reserve(4);
+	v.push_back(1);
+	EXPECT_EQ(static_cast<void*>(mem), static_cast<void*>(v.data()));
+	EXPECT_THROW(v.reserve(100), std::bad_alloc);
+
+	alloc.release();
+	EXPECT_EQ(static_cast<void*>(mem), res.allocate(8, 1));
+}
@@ -0,0 +1,167 @@
+#include <thread>
+#include <vector>
+
+#include "ut.hpp"
+#include "message_pool.hpp"
+
+namespace pl {
+
+struct byte : med::value<uint8_t> {};
+struct word : med::value<uint16_t> {};
+struct data : med::octet_string<med::octets_var_intern<64>> {};
+
+struct msg : med::sequence<
+	M< T<1>, byte >,
+	O< T<2>, word >,
+	O< T<3>, L, data >
+>{};
+
+} //end: namespace pl
+
+TEST(pool, acquire_release)
+{
+	med::message_pool<pl::msg> pool{2};
+	EXPECT_EQ(2, pool.capacity());
+
+	auto m1 = pool.acquire();
+	auto m2 = pool.acquire();
+	ASSERT_TRUE(m1);
+	ASSERT_TRUE(m2);
+	EXPECT_NE(m1.get(), m2.get());
+	//exhausted
+	EXPECT_FALSE(pool.acquire());
+
+	m1->ref<pl::byte>().set(1);
+	m1->ref<pl::word>().set(2);
+	auto* const p1 = m1.get();
+	m1.reset();
+	//returned cleared
+	auto m3 = pool.acquire();
+	EXPECT_EQ(p1, m3.get());
+	EXPECT_FALSE(m3->is_set());
+	EXPECT_EQ(nullptr, m3->get<pl::word>());
+}
+
+TEST(pool, cache)
+{
+	med::message_pool<pl::msg> pool{4};
+	{
+		med::message_pool<pl::msg>::cache<2> cache{pool};
+		auto m1 = cache.acquire();
+		auto m2 = cache.acquire();
+		auto m3 = cache.acquire();
+		auto* const p1 = m1.get();
+		cache.release(std::move(m1));
+		cache.release(std::move(m2));
+		//cache is full
+		cache.release(std::move(m3));
+		EXPECT_EQ(2, cache.size());
+		//the last cached first
+		EXPECT_NE(p1, cache.acquire().get());
+		//released to the pool
+		EXPECT_EQ(1, cache.size());
+	}
+	//all returned to the pool by cache
+	std::vector<med::message_pool<pl::msg>::pointer> all;
+	for (int i = 0; i < 4; ++i) { all.push_back(pool.acquire()); ASSERT_TRUE(all.back()); }
+	EXPECT_FALSE(pool.acquire());
+}
+
+TEST(pool, cache_batch)
+{
+	med::message_pool<pl::msg> pool{8};
+	med::message_pool<pl::msg>::cache<4> cache{pool};
+	//empty cache takes half of its size
+	std::vector<med::message_pool<pl::msg>::pointer> msgs;
+	msgs.push_back(cache.acquire());
+	EXPECT_EQ(1, cache.size());
+	msgs.push_back(cache.acquire());
+	EXPECT_EQ(0, cache.size());
+	for (int i = 0; i < 6; ++i) { msgs.push_back(pool.acquire()); ASSERT_TRUE(msgs.back()); }
+	EXPECT_FALSE(pool.acquire());
+	EXPECT_FALSE(cache.acquire());
+
+	//full cache returns half of its size
+	for (auto& m : msgs) { cache.release(std::move(m)); }
+	EXPECT_EQ(4, cache.size());
+	msgs.clear();
+	for (int i = 0; i < 4; ++i) { msgs.push_back(pool.acquire()); EXPECT_TRUE(msgs.back()); }
+	EXPECT_FALSE(pool.acquire());
+}
+
+TEST(pool, capacity)
+{
+	EXPECT_THROW(med::message_pool<pl::msg>{std::size_t(~uint32_t(0))}, med::invalid_value);
+}
+
+//concurrent acquire/release incl. handing over between threads
+TEST(pool, threads)
+{
+	constexpr std::size_t NUM = 8;
+	constexpr int LOOPS = 20000;
+	using pool_t = med::message_pool<pl::msg>;
+	pool_t pool{NUM};
+
+	pl::msg* msgs[NUM];
+	{
+		pool_t::pointer all[NUM];
+		for (std::size_t i = 0; i < NUM; ++i) { all[i] = pool.acquire(); msgs[i] = all[i].get(); }
+	}
+	std::atomic<int> in_use[NUM] = {};
+	std::atomic<bool> failed{false};
+	auto index = [&](pl::msg* m) { return std::size_t(std::find(msgs, msgs + NUM, m) - msgs); };
+
+	//messages passed to the other thread
+	std::atomic<pl::msg*> handover{nullptr};
+
+	auto worker = [&](bool consumer)
+	{
+		pool_t::cache<2> cache{pool};
+		for (int i = 0; i < LOOPS; ++i)
+		{
+			pool_t::pointer m;
+			if (consumer)
+			{
+				m = pool_t::pointer{handover.exchange(nullptr), pool_t::deleter{&pool}};
+			}
+			bool const handed = bool(m);
+			if (!m) { m = (i & 1) ? cache.acquire() : pool.acquire(); }
+			if (!m) { continue; }
+
+			auto const idx = index(m.get());
+			//no message is given twice
+			if (idx == NUM || in_use[idx]++ != 0) { failed = true; }
+			//acquired are cleared
+			if (!handed && m->get<pl::word>()) { failed = true; }
+			m->ref<pl::byte>().set(uint8_t(i));
+			m->ref<pl::word>().set(uint16_t(i));
+			in_use[idx]--;
+
+			if (!consumer && (i & 2))
+			{
+				auto* const prev = handover.exchange(m.release());
+				//clear since set above
+				if (prev) { pool.release(prev); }
+			}
+			else if (i & 4)
+			{
+				cache.release(std::move(m));
+			}
+		}
+	};
+
+	std::thread threads[] = {
+		std::thread{worker, false},
+		std::thread{worker, true},
+		std::thread{worker, false},
+		std::thread{worker, true},
+	};
+	for (auto& t : threads) { t.join(); }
+	if (auto* last = handover.exchange(nullptr)) { pool.release(last); }
+
+	EXPECT_FALSE(failed);
+	//all are back
+	pool_t::pointer all[NUM];
+	for (auto& m : all) { m = pool.acquire(); EXPECT_TRUE(m); }
+	EXPECT_FALSE(pool.acquire());
+}
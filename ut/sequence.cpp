@@ -872,3 +872,110 @@ TEST(seq, dec_alloc_fail)
 
 	ASSERT_THROW(decode(med::octet_decoder{ctx}, msg), med::out_of_memory);
 }
+
+namespace peek {
+
+struct A : med::value<uint8_t> {};
+struct B : med::value<uint16_t> {};
+struct C : med::value<uint8_t> {};
+struct D : med::value<uint8_t> {};
+struct E : med::value<uint16_t> {};
+
+struct SEQ : med::sequence<
+	O< T<1>, A >,
+	O< T<2>, B >,
+	O< T<3>, C >,
+	M< T<4>, D >,
+	O< T<5>, E, med::max<4> >
+>{};
+
+//same with tagged optionals decoded via table of tags
+struct SPARSE : med::sparse_sequence<
+	O< T<1>, A >,
+	O< T<2>, B >,
+	O< T<3>, C >,
+	M< T<4>, D >,
+	O< T<5>, E, med::max<4> >
+>{};
+
+//counts state saves to check the tags are peeked instead
+template <class CTX>
+struct decoder : med::octet_decoder<CTX>
+{
+	using base_t = med::octet_decoder<CTX>;
+	using base_t::base_t;
+	using base_t::operator();
+
+	template <class IE>
+	bool operator() (med::PUSH_STATE, IE const& ie)
+	{
+		++pushes;
+		return base_t::operator()(med::PUSH_STATE{}, ie);
+	}
+
+	std::size_t pushes {0};
+};
+
+} //end: namespace peek
+
+TEST(seq, peek_tag)
+{
+	uint8_t const encoded[] = {
+		3, 0x33,
+		4, 0x44,
+		5, 0x12, 0x34,
+		5, 0x56, 0x78,
+	};
+
+	med::decoder_context<> ctx{ encoded };
+	peek::decoder<decltype(ctx)> dec{ctx};
+	peek::SEQ msg;
+	decode(dec, msg);
+
+	EXPECT_EQ(0, dec.pushes);
+	EXPECT_EQ(sizeof(encoded), ctx.buffer().get_offset());
+	EXPECT_EQ(nullptr, msg.get<peek::A>());
+	EXPECT_EQ(nullptr, msg.get<peek::B>());
+	ASSERT_NE(nullptr, msg.get<peek::C>());
+	EXPECT_EQ(0x33, msg.get<peek::C>()->get());
+	EXPECT_EQ(0x44, msg.get<peek::D>().get());
+	ASSERT_EQ(2, msg.count<peek::E>());
+	EXPECT_EQ(0x5678, msg.get<peek::E>().last()->get());
+}
+
+TEST(seq, tag_run)
+{
+	using decoder_t = med::octet_decoder<med::decoder_context<>>;
+	//3 tagged optionals are grouped into one run
+	using fields = med::sl::tag_runs_t<decoder_t, peek::SPARSE::ies_types>;
+	static_assert(3 == med::meta::list_size_v<fields>);
+	using run = med::meta::list_first_t<fields>;
+	static_assert(med::sl::is_tag_run<run>::value);
+	static_assert(1 == run::slot(2));
+	static_assert(run::NONE == run::slot(4));
+
+	uint8_t const encoded[] = {
+		1, 0x11,
+		3, 0x33,
+		4, 0x44,
+	};
+	med::decoder_context<> ctx{ encoded };
+	peek::SPARSE msg;
+	decode(med::octet_decoder{ctx}, msg);
+	ASSERT_NE(nullptr, msg.get<peek::A>());
+	EXPECT_EQ(0x11, msg.get<peek::A>()->get());
+	EXPECT_EQ(nullptr, msg.get<peek::B>());
+	ASSERT_NE(nullptr, msg.get<peek::C>());
+	EXPECT_EQ(0x33, msg.get<peek::C>()->get());
+	EXPECT_EQ(0x44, msg.get<peek::D>().get());
+
+	//out of order tag is left for the mandatory field
+	uint8_t const unordered[] = {
+		3, 0x33,
+		1, 0x11,
+		4, 0x44,
+	};
+	ctx.reset(unordered, sizeof(unordered));
+	msg.clear();
+	EXPECT_THROW(decode(med::octet_decoder{ctx}, msg), med::unknown_tag);
+}
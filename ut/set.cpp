@@ -1,7 +1,33 @@
 #include "ut.hpp"
 #include "ut_proto.hpp"
 
-#if 0 //TODO! FIXME
+namespace cmp {
+
+struct length : med::value<uint16_t>{};
+struct tag : med::value<uint16_t>{};
+struct string : med::ascii_string<med::min<1>, med::max<16>>{};
+struct number : med::value<uint32_t>{};
+
+//length of IE incl. this header
+struct hdr : med::sequence<
+	M<length>,
+	M<tag>
+>
+{
+	auto get_tag() const                { return get<tag>().get(); }
+	void set_tag(uint16_t v)            { return ref<tag>().set(v); }
+	std::size_t get_length() const      { return get<length>().get() - 4; }
+	void set_length(std::size_t v)      { return ref<length>().set(uint16_t(v + 4)); }
+};
+
+//plain IEs follow the header of set
+struct SET : med::set< hdr
+	, M< T16<1>, string >
+	, O< T16<2>, number >
+>{};
+
+} //end: namespace cmp
+
 TEST(set, compound)
 {
 	using namespace std::string_view_literals;
@@ -30,7 +56,145 @@ TEST(set, compound)
 	ASSERT_NE(nullptr, dmsg.get<cmp::number>());
 	EXPECT_EQ(msg.get<cmp::number>()->get(), dmsg.get<cmp::number>()->get());
 }
-#endif
+
+namespace lead {
+
+struct code : med::value<uint8_t>{};
+struct flags : med::value<uint8_t>{};
+struct number : med::value<uint32_t>{};
+struct string : med::ascii_string<med::min<1>, med::max<16>>{};
+
+struct hdr : med::sequence<
+	M<code>,
+	M<flags>
+>
+{
+	auto get_tag() const    { return get<code>().get(); }
+	void set_tag(uint8_t v) { return ref<code>().set(v); }
+};
+
+//IEs leading with the header continue after it
+struct str_ie : med::sequence<
+	M<hdr>,
+	M<L, string>
+>{};
+struct num_ie : med::sequence<
+	M<hdr>,
+	M<number>
+>{};
+//IE decoding the header parts itself
+struct raw_ie : med::sequence<
+	M<code>,
+	M<flags>,
+	M<number>
+>{};
+
+struct SET : med::set< hdr
+	, M< T<1>, str_ie >
+	, O< T<2>, num_ie, med::max<2> >
+	, O< T<3>, raw_ie >
+>{};
+
+//plain tag set with IEs leading with a field having tag
+struct PLAIN : med::set<
+	  M< T<1>, str_ie >
+	, O< T<2>, num_ie >
+>{};
+
+} //end: namespace lead
+
+//IEs leading with the compound header of set
+TEST(set, compound_header_in_ie)
+{
+	uint8_t buffer[128];
+	med::encoder_context<> ctx{ buffer };
+
+	lead::SET msg;
+	auto& str = msg.ref<lead::str_ie>();
+	str.ref<lead::hdr>().set_tag(1);
+	str.ref<lead::hdr>().ref<lead::flags>().set(0x80);
+	str.ref<lead::string>().set("12345678"sv);
+	for (uint8_t i = 0; i < 2; ++i)
+	{
+		auto* num = msg.ref<lead::num_ie>().push_back();
+		num->ref<lead::hdr>().set_tag(2);
+		num->ref<lead::hdr>().ref<lead::flags>().set(i);
+		num->ref<lead::number>().set(0x12345678 + i);
+	}
+
+	encode(med::octet_encoder{ctx}, msg);
+
+	EXPECT_STRCASEEQ(
+		"01 80 08 31 32 33 34 35 36 37 38 "
+		"02 00 12 34 56 78 "
+		"02 01 12 34 56 79 ",
+		as_string(ctx.buffer())
+	);
+
+	uint8_t const encoded[] = {
+		2, 1, 0x12, 0x34, 0x56, 0x79,
+		3, 7, 0xA5, 0x5A, 0xBC, 0xCB,
+		1, 0x80, 8, '1', '2', '3', '4', '5', '6', '7', '8',
+		2, 0, 0x12, 0x34, 0x56, 0x78,
+	};
+	lead::SET dmsg;
+	med::decoder_context<> dctx{encoded};
+	decode(med::octet_decoder{dctx}, dmsg);
+
+	auto const& dstr = dmsg.get<lead::str_ie>();
+	EXPECT_EQ(1, dstr.get<lead::hdr>().get_tag());
+	EXPECT_EQ(0x80, dstr.get<lead::hdr>().get<lead::flags>().get());
+	EXPECT_EQ("12345678"sv, dstr.get<lead::string>().get());
+
+	ASSERT_EQ(2, dmsg.count<lead::num_ie>());
+	uint8_t fl = 1;
+	for (auto& num : dmsg.get<lead::num_ie>())
+	{
+		EXPECT_EQ(2, num.get<lead::hdr>().get_tag());
+		EXPECT_EQ(fl, num.get<lead::hdr>().get<lead::flags>().get());
+		EXPECT_EQ(0x12345678u + fl, num.get<lead::number>().get());
+		--fl;
+	}
+
+	auto const* raw = dmsg.get<lead::raw_ie>();
+	ASSERT_NE(nullptr, raw);
+	EXPECT_EQ(3, raw->get<lead::code>().get());
+	EXPECT_EQ(7, raw->get<lead::flags>().get());
+	EXPECT_EQ(0xA55ABCCB, raw->get<lead::number>().get());
+}
+
+//tag of the set is encoded since the header of IE is not the set's one
+TEST(set, plain_tag_header_in_ie)
+{
+	uint8_t buffer[64];
+	med::encoder_context<> ctx{ buffer };
+
+	lead::PLAIN msg;
+	auto& str = msg.ref<lead::str_ie>();
+	str.ref<lead::hdr>().set_tag(5);
+	str.ref<lead::hdr>().ref<lead::flags>().set(0x80);
+	str.ref<lead::string>().set("1234"sv);
+	auto& num = msg.ref<lead::num_ie>();
+	num.ref<lead::hdr>().set_tag(6);
+	num.ref<lead::hdr>().ref<lead::flags>().set(0);
+	num.ref<lead::number>().set(0x12345678);
+
+	encode(med::octet_encoder{ctx}, msg);
+	EXPECT_STRCASEEQ(
+		"01 05 80 04 31 32 33 34 "
+		"02 06 00 12 34 56 78 ",
+		as_string(ctx.buffer())
+	);
+
+	lead::PLAIN dmsg;
+	med::decoder_context<> dctx{ctx.buffer().get_start(), ctx.buffer().get_offset()};
+	decode(med::octet_decoder{dctx}, dmsg);
+	EXPECT_EQ(5, dmsg.get<lead::str_ie>().get<lead::hdr>().get_tag());
+	EXPECT_EQ("1234"sv, dmsg.get<lead::str_ie>().get<lead::string>().get());
+	ASSERT_NE(nullptr, dmsg.get<lead::num_ie>());
+	EXPECT_EQ(6, dmsg.get<lead::num_ie>()->get<lead::hdr>().get_tag());
+	EXPECT_EQ(0x12345678, dmsg.get<lead::num_ie>()->get<lead::number>().get());
+}
 
 TEST(encode, set_ok)
 {
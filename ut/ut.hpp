@@ -171,6 +171,19 @@ constexpr std::string_view as_sv(T const& val)
 	return std::string_view{(char*)val.body().data(), val.body().size()};
 }
 
+//allocator counting its allocations
+struct counting_allocator
+{
+	med::allocator& alloc;
+	std::size_t     calls {0};
+
+	void* allocate(std::size_t bytes, std::size_t alignment)
+	{
+		++calls;
+		return alloc.allocate(bytes, alignment);
+	}
+};
+
 
 #define EQ_STRING_O(fld_type, expected) \
 {                                                             \
@@ -130,6 +130,48 @@ TEST(value, bytes)
 	check_octet_decode(v, {0,0,3});
 }
 
+TEST(value, byte_order)
+{
+	//per IE
+	med::value<uint32_t, med::little_endian> le;
+	le.set(0x01020304);
+	check_octet_encode(le, {4,3,2,1});
+	check_octet_decode(le, {4,3,2,1});
+
+	med::value<med::bytes<3>, med::little_endian> le3;
+	le3.set(0x010203);
+	check_octet_encode(le3, {3,2,1});
+	check_octet_decode(le3, {3,2,1});
+
+	//per codec while IE can override it
+	struct U16 : med::value<uint16_t> {};
+	struct BE24 : med::value<med::bytes<3>, med::big_endian> {};
+	struct HI : med::value<med::bits<4>> {};
+	struct LO : med::value<med::bits<4, 4>> {};
+	struct LE_SEQ : med::sequence<
+		M< U16 >,
+		M< BE24 >,
+		M< HI >,
+		M< LO >
+	>{};
+
+	LE_SEQ msg;
+	msg.ref<U16>().set(0x0102);
+	msg.ref<BE24>().set(0x030405);
+	msg.ref<HI>().set(6);
+	msg.ref<LO>().set(7);
+
+	uint8_t buffer[8] = {};
+	med::encoder_context ctx{ buffer };
+	encode(med::octet_encoder{ctx, med::little_endian{}}, msg);
+	EXPECT_STREQ("02 01 03 04 05 67 ", as_string(ctx.buffer()));
+
+	LE_SEQ dmsg;
+	med::decoder_context dctx{ ctx.buffer().get_start(), ctx.buffer().get_offset() };
+	decode(med::octet_decoder{dctx, med::little_endian{}}, dmsg);
+	EXPECT_TRUE(msg == dmsg);
+}
+
 TEST(value, one_byte)
 {
 	{